@@ -0,0 +1,17 @@
+#!/bin/sh
+# Runs the JACK client diagnostics against a dummy JACK server, no audio hardware needed.
+# Needs jackd (and jack_bufsize, to also check following buffer size changes).
+#
+# usage: Scripts/jack-dummy-check.sh [path to the Placross executable]
+
+placross=${1:-Builds/LinuxMakefile/build/Placross}
+
+# a server of its own, so a JACK server already running is left alone
+export JACK_DEFAULT_SERVER=placross-diagnostics
+
+jackd --no-realtime -d dummy -r 48000 -p 256 &
+jackd_pid=$!
+trap 'kill $jackd_pid 2>/dev/null; wait $jackd_pid 2>/dev/null' EXIT
+
+sleep 2
+"$placross" --diagnostics jack
@@ -12,11 +12,14 @@
 
 #include <Image_utils.h>
 
+static constexpr int DRAIN_INTERVAL_MS = 40;
+static constexpr int IDLE_TIMEOUT_MS = 200;
+
 AnalyserComponent::AnalyserComponent() :
     m_fwdFFT(fftOrder),
     m_windowF(fftSize, dsp::WindowingFunction<float>::hann)
 {
-    startTimer(m_holdTimeMs);
+    startTimer(DRAIN_INTERVAL_MS);
 }
 
 AnalyserComponent::~AnalyserComponent()
@@ -28,6 +31,24 @@ void AnalyserComponent::setChannelColours(const std::vector<Colour>& colours)
     m_channelColours = colours;
 }
 
+void AnalyserComponent::setSettings(const Settings& settings)
+{
+    m_holdTimeMs = jmax(0, settings.holdTimeMs);
+    m_minDB = jmin(settings.minDB, settings.maxDB - 1.0f);
+    m_maxDB = settings.maxDB;
+
+    repaint();
+}
+
+AnalyserComponent::Settings AnalyserComponent::getSettings() const
+{
+    Settings settings;
+    settings.holdTimeMs = m_holdTimeMs;
+    settings.minDB = m_minDB;
+    settings.maxDB = m_maxDB;
+    return settings;
+}
+
 void AnalyserComponent::paint(Graphics& g)
 {
     OverlayToggleComponentBase::paint(g);
@@ -49,25 +70,26 @@ void AnalyserComponent::paint(Graphics& g)
     for (int ch = 0; ch < m_plotChannels; ++ch)
     {
         // draw rta curve
-        if (m_plotPointsPeak.count(ch) && !m_plotPointsPeak.at(ch).empty() && m_plotPointsHold.at(ch).size() == m_plotPointsPeak.at(ch).size())
+        if (m_freqBands > 0 && m_channelColours.size() > ch)
         {
-            auto minPlotIdx = jlimit(0, static_cast<int>(m_plotPointsPeak.at(ch).size() - 1), (minPlotFreq - static_cast<int>(m_minFreq)) / static_cast<int>(m_freqRes));
-            auto maxPlotIdx = jlimit(0, static_cast<int>(m_plotPointsPeak.at(ch).size() - 1), (maxPlotFreq - static_cast<int>(m_minFreq)) / static_cast<int>(m_freqRes));
+            auto plotPointsPeak = m_plotPointsPeak.data() + ch * m_freqBands;
+            auto plotPointsHold = m_plotPointsHold.data() + ch * m_freqBands;
+            auto minPlotIdx = jlimit(0, m_freqBands - 1, (minPlotFreq - static_cast<int>(m_minFreq)) / static_cast<int>(m_freqRes));
+            auto maxPlotIdx = jlimit(0, m_freqBands - 1, (maxPlotFreq - static_cast<int>(m_minFreq)) / static_cast<int>(m_freqRes));
 
-            jassert(m_channelColours.size() >= ch);
             g.setColour(m_channelColours.at(ch));
             
             // hold curve
             auto path = Path{};
             auto skewedProportionX = 1.0f / (log10(maxPlotFreq) - 1.0f) * (log10((minPlotIdx + 1) * m_freqRes) - 1.0f);
             auto newPointX = visuAreaOrigX + (static_cast<float>(visuAreaWidth) * skewedProportionX);
-            auto newPointY = visuAreaOrigY - m_plotPointsHold.at(ch).at(minPlotIdx) * visuAreaHeight;
+            auto newPointY = visuAreaOrigY - plotPointsHold[minPlotIdx] * visuAreaHeight;
             path.startNewSubPath(juce::Point<float>(newPointX, newPointY));
             for (int i = minPlotIdx + 1; i <= maxPlotIdx; ++i)
             {
                 skewedProportionX = 1.0f / (log10(maxPlotFreq) - 1.0f) * (log10((i + 1) * m_freqRes) - 1.0f);
                 newPointX = visuAreaOrigX + (static_cast<float>(visuAreaWidth) * skewedProportionX);
-                newPointY = visuAreaOrigY - m_plotPointsHold.at(ch).at(i) * visuAreaHeight;
+                newPointY = visuAreaOrigY - plotPointsHold[i] * visuAreaHeight;
 
                 path.lineTo(juce::Point<float>(newPointX, newPointY));
             }
@@ -77,13 +99,13 @@ void AnalyserComponent::paint(Graphics& g)
             path = Path{};
             skewedProportionX = 1.0f / (log10(maxPlotFreq) - 1.0f) * (log10((minPlotIdx + 1) * m_freqRes) - 1.0f);
             newPointX = visuAreaOrigX + (static_cast<float>(visuAreaWidth) * skewedProportionX);
-            newPointY = visuAreaOrigY - m_plotPointsPeak.at(ch).at(minPlotIdx) * visuAreaHeight;
+            newPointY = visuAreaOrigY - plotPointsPeak[minPlotIdx] * visuAreaHeight;
             path.startNewSubPath(juce::Point<float>(newPointX, newPointY));
             for (int i = minPlotIdx + 1; i <= maxPlotIdx; ++i)
             {
                 skewedProportionX = 1.0f / (log10(maxPlotFreq) - 1.0f) * (log10((i + 1) * m_freqRes) - 1.0f);
                 newPointX = visuAreaOrigX + (static_cast<float>(visuAreaWidth) * skewedProportionX);
-                newPointY = visuAreaOrigY - m_plotPointsPeak.at(ch).at(i) * visuAreaHeight;
+                newPointY = visuAreaOrigY - plotPointsPeak[i] * visuAreaHeight;
 
                 path.lineTo(juce::Point<float>(newPointX, newPointY));
             }
@@ -125,17 +147,20 @@ void AnalyserComponent::audioDeviceIOCallback(const float** inputChannelData, in
     ignoreUnused(outputChannelData);
     ignoreUnused(numOutputChannels);
 
-    const ScopedLock sl(m_audioDataLock);
+    auto numChannels = jmin(numInputChannels, m_fifoBuffer.getNumChannels());
+    m_fifoChannels = numChannels;
 
-    AudioBuffer<float> buffer;
-    buffer.setSize(numInputChannels, numSamples, false, true, true);
-    
-    for (int in = 0; in < numInputChannels; ++in)
+    // if the message thread falls behind, what does not fit anymore is dropped
+    int start1, size1, start2, size2;
+    m_fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+    for (int in = 0; in < numChannels; ++in)
     {
-        buffer.copyFrom(in, 0, inputChannelData[in], numSamples);
+        if (size1 > 0)
+            m_fifoBuffer.copyFrom(in, start1, inputChannelData[in], size1);
+        if (size2 > 0)
+            m_fifoBuffer.copyFrom(in, start2, inputChannelData[in] + size1, size2);
     }
-
-    postMessage(new AudioBufferMessage(buffer));
+    m_fifo.finishedWrite(size1 + size2);
 }
 
 void AnalyserComponent::audioDeviceAboutToStart(AudioIODevice* device)
@@ -146,13 +171,16 @@ void AnalyserComponent::audioDeviceAboutToStart(AudioIODevice* device)
     m_bufferSize = device->getCurrentBufferSizeSamples();
     m_missingSamplesForCentiSecond = static_cast<int>(m_samplesPerCentiSecond + 0.5f);
     m_centiSecondBuffer.setSize(2, m_missingSamplesForCentiSecond, false, true, false);
+
+    // room for a few blocks worth of data, but at least for what arrives in between two drain timer callbacks
+    auto fifoChannels = device->getActiveOutputChannels().getHighestBit() + 1;
+    auto fifoSize = jmax(8 * m_bufferSize, static_cast<int>(m_sampleRate * 4 * DRAIN_INTERVAL_MS / 1000));
+    m_fifoBuffer.setSize(fifoChannels, fifoSize, false, true, false);
+    m_buffer.setSize(fifoChannels, fifoSize, false, true, false);
+    m_fifo.setTotalSize(fifoSize + 1);
+    m_fifo.reset();
     
-    m_plotChannels = device->getActiveInputChannels().toInteger();
-    for (int ch = 0; ch < m_plotChannels; ++ch)
-    {
-        m_plotPointsHold.at(ch).resize(m_freqBands);
-        m_plotPointsPeak.at(ch).resize(m_freqBands);
-    }
+    resizePlotPoints(fifoChannels);
 }
 
 void AnalyserComponent::audioDeviceStopped()
@@ -163,9 +191,14 @@ void AnalyserComponent::audioDeviceStopped()
     m_centiSecondBuffer.clear();
     m_missingSamplesForCentiSecond = 0;
 
-    m_plotChannels = 0;
-    m_plotPointsHold.clear();
-    m_plotPointsPeak.clear();
+    resizePlotPoints(0);
+}
+
+void AnalyserComponent::resizePlotPoints(int numChannels)
+{
+    m_plotChannels = jmax(0, numChannels);
+    m_plotPointsPeak.assign(static_cast<size_t>(m_plotChannels * m_freqBands), 0.0f);
+    m_plotPointsHold.assign(static_cast<size_t>(m_plotChannels * m_freqBands), 0.0f);
 }
 
 void AnalyserComponent::audioDeviceError(const juce::String &errorMessage)
@@ -173,24 +206,39 @@ void AnalyserComponent::audioDeviceError(const juce::String &errorMessage)
     ignoreUnused(errorMessage);
 }
 
-void AnalyserComponent::handleMessage(const Message& message)
+bool AnalyserComponent::drainAudioData()
 {
-    if (auto m = dynamic_cast<const AudioBufferMessage*> (&message))
+    auto numSamples = jmin(m_fifo.getNumReady(), m_buffer.getNumSamples());
+    auto numChannels = jmin(m_fifoChannels.load(), m_buffer.getNumChannels());
+    if (numSamples <= 0 || numChannels <= 0)
+        return false;
+
+    int start1, size1, start2, size2;
+    m_fifo.prepareToRead(numSamples, start1, size1, start2, size2);
+    for (int ch = 0; ch < numChannels; ++ch)
     {
-        auto buffer = m->getAudioBuffer();
+        if (size1 > 0)
+            m_buffer.copyFrom(ch, 0, m_fifoBuffer, ch, start1, size1);
+        if (size2 > 0)
+            m_buffer.copyFrom(ch, size1, m_fifoBuffer, ch, start2, size2);
+    }
+    m_fifo.finishedRead(size1 + size2);
+
+    // processing works on a view of the drained part only, no data is copied for that
+    AudioBuffer<float> drainedData(m_buffer.getArrayOfWritePointers(), numChannels, size1 + size2);
+    processAudioData(drainedData);
 
+    return true;
+}
+
+void AnalyserComponent::processAudioData(const AudioBuffer<float>& buffer)
+{
+    {
         int numChannels = buffer.getNumChannels();
         
-        // adjust member vectormaps if data requires it
+        // adjust plot data if the data requires it
         if (m_plotChannels < numChannels)
-        {
-            m_plotChannels = numChannels;
-            for (int ch = 0; ch < m_plotChannels; ++ch)
-            {
-                m_plotPointsHold.insert(std::make_pair(ch, std::vector<float>(m_freqBands)));
-                m_plotPointsPeak.insert(std::make_pair(ch, std::vector<float>(m_freqBands)));
-            }
-        }
+            resizePlotPoints(numChannels);
 
         if (numChannels != m_centiSecondBuffer.getNumChannels())
             m_centiSecondBuffer.setSize(numChannels, static_cast<int>(m_samplesPerCentiSecond), false, true, true);
@@ -247,11 +295,9 @@ void AnalyserComponent::handleMessage(const Message& message)
                             auto leveldB = jlimit(m_minDB, m_maxDB, Decibels::gainToDecibels(spectrumVal));
                             auto level = jmap(leveldB, m_minDB, m_maxDB, 0.0f, 1.0f);
 
-                            if (m_plotPointsPeak.count(ch) > 0 && m_plotPointsPeak.at(ch).size() > freq)
-                            {
-                                m_plotPointsPeak.at(ch).at(freq) = level;
-                                m_plotPointsHold.at(ch).at(freq) = std::max(level, m_plotPointsHold.at(ch).at(freq));
-                            }
+                            auto plotIdx = ch * m_freqBands + freq;
+                            m_plotPointsPeak[plotIdx] = level;
+                            m_plotPointsHold[plotIdx] = std::max(level, m_plotPointsHold[plotIdx]);
                         }
 
                         zeromem(m_FFTdata, sizeof(m_FFTdata));
@@ -305,15 +351,32 @@ void AnalyserComponent::toggleMinimizedMaximizedElementVisibility(bool maximized
 
 void AnalyserComponent::timerCallback()
 {
-    flushHold();
+    // without any audio data arriving for a while, the engine went idle. The plot is cleared once and not updated anymore until data arrives again.
+    if (!drainAudioData())
+    {
+        m_msWithoutData += DRAIN_INTERVAL_MS;
+        if (!m_idle && m_msWithoutData >= IDLE_TIMEOUT_MS)
+        {
+            m_idle = true;
+            std::fill(m_plotPointsPeak.begin(), m_plotPointsPeak.end(), 0.0f);
+            flushHold();
+            repaint();
+        }
+        return;
+    }
+    m_msWithoutData = 0;
+    m_idle = false;
+
+    m_msSinceHoldFlush += DRAIN_INTERVAL_MS;
+    if (m_msSinceHoldFlush >= m_holdTimeMs)
+    {
+        flushHold();
+        m_msSinceHoldFlush = 0;
+    }
 }
 
 void AnalyserComponent::flushHold()
 {
     // clear spectrum hold values
-    for (int ch = 0; ch < m_plotChannels; ++ch)
-    {
-        for (int freq = 0; freq < m_plotPointsHold.at(ch).size(); ++freq)
-            m_plotPointsHold.at(ch).at(freq) = 0.0f;
-    }
+    std::fill(m_plotPointsHold.begin(), m_plotPointsHold.end(), 0.0f);
 }
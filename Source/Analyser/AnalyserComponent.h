@@ -14,25 +14,9 @@
 
 #include "../submodules/JUCE-AppBasics/Source/OverlayToggleComponentBase.h"
 
-//==============================================================================
-/*
-*/
-class AudioBufferMessage : public Message
-{
-public:
-    AudioBufferMessage(AudioBuffer<float>& buffer) { m_buffer = buffer; };
-    ~AudioBufferMessage() {};
-
-    const AudioBuffer<float>& getAudioBuffer() const { return m_buffer; };
-
-private:
-    AudioBuffer<float> m_buffer;
-};
-
 //==============================================================================
 class AnalyserComponent :   public JUCEAppBasics::OverlayToggleComponentBase,
                             public AudioIODeviceCallback,
-                            public MessageListener,
                             public Timer
 {
 public:
@@ -42,6 +26,16 @@ public:
 
     void setChannelColours(const std::vector<Colour>& colours);
 
+    /** What the user can change of the display, part of a rig's state. */
+    struct Settings
+    {
+        int     holdTimeMs{ 500 };
+        float   minDB{ -90.0f };
+        float   maxDB{ 0.0f };
+    };
+    void setSettings(const Settings& settings);
+    Settings getSettings() const;
+
     //==============================================================================
     void paint(Graphics& g) override;
     void resized() override;
@@ -69,20 +63,26 @@ private:
     void toggleMinimizedMaximizedElementVisibility(bool maximized);
 
     //==============================================================================
-    void handleMessage(const Message& message) override;
+    bool drainAudioData();
+    void processAudioData(const AudioBuffer<float>& buffer);
+    void resizePlotPoints(int numChannels);
 
     //==============================================================================
-    CriticalSection     m_audioDataLock{};
     double              m_sampleRate = 0;
     double              m_samplesPerCentiSecond = 0;
     int                 m_bufferSize = 0;
 
-    float               *m_processorChannels[128];
     AudioBuffer<float>  m_buffer;
     int                 m_missingSamplesForCentiSecond;
     AudioBuffer<float>  m_centiSecondBuffer;
 
-    const float* inputChans[128]; // this is only a member to enshure it is not recreated on every function call
+    // the audio thread hands its data over through a fifo sized in audioDeviceAboutToStart, drained on the message thread
+    AbstractFifo        m_fifo{ 1 };
+    AudioBuffer<float>  m_fifoBuffer;
+    std::atomic<int>    m_fifoChannels{ 0 };
+    int                 m_msSinceHoldFlush{ 0 };
+    int                 m_msWithoutData{ 0 };
+    bool                m_idle{ false };
 
     //==============================================================================
     enum
@@ -104,9 +104,10 @@ private:
     int m_freqBands{ 1024 };
     int m_freqRes{ 20 };
 
-    int                                 m_plotChannels;
-    std::map<int, std::vector<float>>   m_plotPointsPeak;
-    std::map<int, std::vector<float>>   m_plotPointsHold;
+    // m_freqBands values per channel, channel after channel
+    int                 m_plotChannels{ 0 };
+    std::vector<float>  m_plotPointsPeak;
+    std::vector<float>  m_plotPointsHold;
 
     std::vector<Colour> m_channelColours;
 
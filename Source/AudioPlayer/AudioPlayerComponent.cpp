@@ -124,6 +124,7 @@ void AudioPlayerComponent::getNextAudioBlock (const AudioSourceChannelInfo& buff
         return;
     }
 
+    m_transportSource.setGain (m_gain.load());
     m_transportSource.getNextAudioBlock (bufferToFill);
 }
     
@@ -281,6 +282,31 @@ void AudioPlayerComponent::updateLoopState (bool shouldLoop)
         m_readerSource->setLooping (shouldLoop);
 }
 
+void AudioPlayerComponent::play()
+{
+    playButtonClicked();
+}
+
+void AudioPlayerComponent::stop()
+{
+    stopButtonClicked();
+}
+
+void AudioPlayerComponent::playNext()
+{
+    playNextAudioFile();
+}
+
+void AudioPlayerComponent::playPrevious()
+{
+    playPrevAudioFile();
+}
+
+void AudioPlayerComponent::setGain(float gain) noexcept
+{
+    m_gain = gain;
+}
+
 void AudioPlayerComponent::loadAudioFile(const File& file)
 {
     auto* reader = m_formatManager.createReaderFor (file);
@@ -326,6 +352,7 @@ void AudioPlayerComponent::changeTransportState(TransportState newState)
     if (m_transportState != newState)
     {
         m_transportState = newState;
+        m_transportStopped = (newState == TS_Stopped);
 
         switch (m_transportState)
         {
@@ -39,6 +39,7 @@ public:
     virtual ~AudioPlayerComponent();
 
     int getCurrentChannelCount();
+    bool isTransportStopped() const noexcept { return m_transportStopped.load(); };
     void onAudioTitleSelected(String titleName);
 
     //==========================================================================
@@ -59,6 +60,15 @@ public:
     void addListener(Listener* l);
     void updateLoopState (bool shouldLoop);
 
+    //==========================================================================
+    /** Transport control as with the buttons, for remote control. */
+    void play();
+    void stop();
+    void playNext();
+    void playPrevious();
+    /** Any thread, picked up with the next block. */
+    void setGain(float gain) noexcept;
+
 protected:
     void changeOverlayState() override;
 
@@ -113,6 +123,8 @@ private:
     std::unique_ptr<AudioFormatReaderSource>    m_readerSource;
     AudioTransportSource                        m_transportSource;
     TransportState                              m_transportState;
+    std::atomic<bool>                           m_transportStopped{ true };  // for the audio thread
+    std::atomic<float>                          m_gain{ 1.0f };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioPlayerComponent)
 };
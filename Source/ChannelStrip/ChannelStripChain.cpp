@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    ChannelStripChain.cpp
+    Created: 17 Oct 2026 9:26:51pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "ChannelStripChain.h"
+
+// the common topologies are instantiated once here
+template class CompiledChannelStripChain<ParallelFiltersGainChain>;
+template class CompiledChannelStripChain<SerialFiltersGainChain>;
+template class CompiledChannelStripChain<GainOnlyChain>;
+
+std::unique_ptr<ChannelStripChainProcessor> ChannelStripChainProcessor::create(const ChannelStripTopology& topology, const ProcessorArray& processors)
+{
+    using Stage = ChannelStripTopology::Stage;
+    auto filters = Stage{ ChannelStripProcessorBase::CSPT_HighPass, ChannelStripProcessorBase::CSPT_LowPass };
+    auto gain = Stage{ ChannelStripProcessorBase::CSPT_Gain };
+
+    if (topology.stages.size() == 2 && topology.stages.back() == gain
+        && std::is_permutation(topology.stages.front().begin(), topology.stages.front().end(), filters.begin(), filters.end()))
+        return std::make_unique<CompiledChannelStripChain<ParallelFiltersGainChain>>(processors);
+    if (topology.stages == std::vector<Stage>{ { ChannelStripProcessorBase::CSPT_HighPass }, { ChannelStripProcessorBase::CSPT_LowPass }, gain })
+        return std::make_unique<CompiledChannelStripChain<SerialFiltersGainChain>>(processors);
+    if (topology.stages == std::vector<Stage>{ gain })
+        return std::make_unique<CompiledChannelStripChain<GainOnlyChain>>(processors);
+
+    return std::make_unique<FlatChannelStripChain>(topology, processors);
+}
+
+//==============================================================================
+FlatChannelStripChain::FlatChannelStripChain(const ChannelStripTopology& topology, const ProcessorArray& processors)
+    : m_processors(processors)
+{
+    m_numScratchBuffers = jmax(0, topology.getMaxStageWidth() - 1);
+
+    for (auto const& stage : topology.stages)
+    {
+        // the first processor of a stage runs in place on the output, the others on copies of the stage input
+        for (auto i = 1; i < static_cast<int>(stage.size()); ++i)
+            m_operations.push_back({ OC_Copy, 0, i, stage[static_cast<size_t>(i)] });
+
+        for (auto i = 0; i < static_cast<int>(stage.size()); ++i)
+        {
+            m_operations.push_back({ OC_Process, i, i, stage[static_cast<size_t>(i)] });
+            m_contained[static_cast<size_t>(stage[static_cast<size_t>(i)])] = true;
+        }
+
+        for (auto i = 1; i < static_cast<int>(stage.size()); ++i)
+            m_operations.push_back({ OC_Accumulate, i, 0, stage[static_cast<size_t>(i)] });
+    }
+}
+
+void FlatChannelStripChain::prepare(double sampleRate, int maxBlockSize)
+{
+    m_maxBlockSize = jmax(1, maxBlockSize);
+    m_scratch.allocate(static_cast<size_t>(m_numScratchBuffers * m_maxBlockSize), true);
+
+    m_highPass.prepare(sampleRate);
+    m_lowPass.prepare(sampleRate);
+    m_gain.prepare(sampleRate);
+}
+
+void FlatChannelStripChain::reset()
+{
+    m_highPass.reset();
+    m_lowPass.reset();
+    m_gain.reset();
+}
+
+float* FlatChannelStripChain::getBuffer(int index, float* output) noexcept
+{
+    return index == 0 ? output : m_scratch.get() + static_cast<size_t>((index - 1) * m_maxBlockSize);
+}
+
+void FlatChannelStripChain::process(const float* input, float* output, int numSamples) noexcept
+{
+    jassert(numSamples <= m_maxBlockSize);
+
+    auto lookup = [this](ChannelStripProcessorBase::ChannelStripProcessorType type) { return m_processors[static_cast<size_t>(type)]; };
+    if (m_contained[ChannelStripProcessorBase::CSPT_HighPass])
+        m_highPass.updateParameters(lookup);
+    if (m_contained[ChannelStripProcessorBase::CSPT_LowPass])
+        m_lowPass.updateParameters(lookup);
+    if (m_contained[ChannelStripProcessorBase::CSPT_Gain])
+        m_gain.updateParameters(lookup);
+
+    if (output != input)
+        FloatVectorOperations::copy(output, input, numSamples);
+
+    for (auto const& operation : m_operations)
+    {
+        auto destination = getBuffer(operation.destination, output);
+        switch (operation.code)
+        {
+        case OC_Copy:
+            FloatVectorOperations::copy(destination, getBuffer(operation.source, output), numSamples);
+            break;
+        case OC_Accumulate:
+            FloatVectorOperations::add(destination, getBuffer(operation.source, output), numSamples);
+            break;
+        case OC_Process:
+            switch (operation.type)
+            {
+            case ChannelStripProcessorBase::CSPT_HighPass:
+                for (int i = 0; i < numSamples; ++i)
+                    destination[i] = m_highPass.processSample(destination[i]);
+                break;
+            case ChannelStripProcessorBase::CSPT_LowPass:
+                for (int i = 0; i < numSamples; ++i)
+                    destination[i] = m_lowPass.processSample(destination[i]);
+                break;
+            case ChannelStripProcessorBase::CSPT_Gain:
+                for (int i = 0; i < numSamples; ++i)
+                    destination[i] = m_gain.processSample(destination[i]);
+                break;
+            case ChannelStripProcessorBase::CSPT_Invalid:
+            default:
+                break;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
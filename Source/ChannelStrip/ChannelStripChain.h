@@ -0,0 +1,340 @@
+/*
+  ==============================================================================
+
+    ChannelStripChain.h
+    Created: 17 Oct 2026 9:26:51pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "ChannelStripEngine.h"
+#include "ChannelStripProcessor.h"
+#include "ChannelStripTopology.h"
+
+//==============================================================================
+/*
+    Compile-time composed alternative to the per strip AudioProcessorGraph.
+    A topology is spelled out as a type, e.g. Serial<Parallel<HighPassStage, LowPassStage>, GainStage>
+    for the HP || LP -> Gain strip the graph is connected to, and the whole per sample
+    path of it is inlined.
+
+    The stages do not own any parameters, they pick up the current values from the
+    ChannelStripProcessorBase instance of their type once per block, so the editors
+    stay bound to the same parameters (hpff, hpfg, lpff, lpfg, gain) as with the graph.
+    Changes are smoothed per sample from there on.
+*/
+
+//==============================================================================
+template <ChannelStripProcessorBase::ChannelStripProcessorType FilterType>
+class StateVariableFilterStage
+{
+public:
+    static_assert(FilterType == ChannelStripProcessorBase::CSPT_HighPass || FilterType == ChannelStripProcessorBase::CSPT_LowPass, "Only highpass and lowpass filter stages are supported");
+
+    void prepare(double sampleRate) noexcept
+    {
+        m_sampleRate = sampleRate;
+        m_cutoff = 0.0f;
+        m_smoothedG.reset(sampleRate, ChannelStripProcessorBase::getSmoothingSeconds());
+        m_smoothedGain.reset(sampleRate, ChannelStripProcessorBase::getSmoothingSeconds());
+        m_snapToParameters = true;
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        m_s1 = m_s2 = 0.0f;
+    }
+
+    template <typename ProcessorLookup>
+    void updateParameters(ProcessorLookup&& lookup) noexcept
+    {
+        auto processor = lookup(FilterType);
+        if (processor == nullptr)
+        {
+            m_smoothedGain.setCurrentAndTargetValue(0.0f);
+            return;
+        }
+
+        // same coefficients as dsp::StateVariableTPTFilter with its default resonance of 1/sqrt(2).
+        // The coefficient is smoothed instead of the cutoff, which saves the tan() per sample and is just as even on a log scale.
+        auto cutoff = processor->getFilterFequency();
+        if (cutoff != m_cutoff)
+        {
+            m_cutoff = cutoff;
+            auto g = ChannelStripEngine::calculateCoefficientG(cutoff, m_sampleRate);
+            if (m_snapToParameters)
+            {
+                m_smoothedG.setCurrentAndTargetValue(g);
+                updateCoefficients(g);
+            }
+            else
+            {
+                m_smoothedG.setTargetValue(g);
+            }
+        }
+
+        if (m_snapToParameters)
+            m_smoothedGain.setCurrentAndTargetValue(processor->getFilterGain());
+        else
+            m_smoothedGain.setTargetValue(processor->getFilterGain());
+
+        m_snapToParameters = false;
+    }
+
+    forcedinline float processSample(float x) noexcept
+    {
+        if (m_smoothedG.isSmoothing())
+            updateCoefficients(m_smoothedG.getNextValue());
+
+        auto yHP = m_h * (x - m_s1 * (m_g + MathConstants<float>::sqrt2) - m_s2);
+        auto yBP = yHP * m_g + m_s1;
+        m_s1 = yHP * m_g + yBP;
+        auto yLP = yBP * m_g + m_s2;
+        m_s2 = yBP * m_g + yLP;
+
+        return m_smoothedGain.getNextValue() * (FilterType == ChannelStripProcessorBase::CSPT_HighPass ? yHP : yLP);
+    }
+
+private:
+    forcedinline void updateCoefficients(float g) noexcept
+    {
+        m_g = g;
+        m_h = 1.0f / (1.0f + MathConstants<float>::sqrt2 * m_g + m_g * m_g);
+    }
+
+    double  m_sampleRate{ 48000.0 };
+    float   m_cutoff{ 0.0f };
+    float   m_g{ 0.0f };
+    float   m_h{ 0.0f };
+    float   m_s1{ 0.0f };
+    float   m_s2{ 0.0f };
+    bool    m_snapToParameters{ true };
+
+    SmoothedValue<float, ValueSmoothingTypes::Multiplicative>   m_smoothedG{ 1.0f };
+    SmoothedValue<float>                                        m_smoothedGain{ 0.0f };
+};
+
+using HighPassStage = StateVariableFilterStage<ChannelStripProcessorBase::CSPT_HighPass>;
+using LowPassStage = StateVariableFilterStage<ChannelStripProcessorBase::CSPT_LowPass>;
+
+//==============================================================================
+class GainStage
+{
+public:
+    void prepare(double sampleRate) noexcept
+    {
+        m_smoothedGain.reset(sampleRate, ChannelStripProcessorBase::getSmoothingSeconds());
+        m_snapToParameters = true;
+    }
+
+    void reset() noexcept {}
+
+    template <typename ProcessorLookup>
+    void updateParameters(ProcessorLookup&& lookup) noexcept
+    {
+        auto processor = lookup(ChannelStripProcessorBase::CSPT_Gain);
+        auto gain = processor ? processor->getFilterGain() : 1.0f;
+
+        if (m_snapToParameters)
+            m_smoothedGain.setCurrentAndTargetValue(gain);
+        else
+            m_smoothedGain.setTargetValue(gain);
+
+        m_snapToParameters = false;
+    }
+
+    forcedinline float processSample(float x) noexcept
+    {
+        return m_smoothedGain.getNextValue() * x;
+    }
+
+private:
+    SmoothedValue<float>    m_smoothedGain{ 1.0f };
+    bool                    m_snapToParameters{ true };
+};
+
+//==============================================================================
+/** Feeds the output of each stage into the next one. */
+template <typename... Stages>
+class Serial;
+
+template <typename Stage>
+class Serial<Stage>
+{
+public:
+    void prepare(double sampleRate) noexcept { m_stage.prepare(sampleRate); }
+    void reset() noexcept { m_stage.reset(); }
+
+    template <typename ProcessorLookup>
+    void updateParameters(ProcessorLookup&& lookup) noexcept { m_stage.updateParameters(lookup); }
+
+    forcedinline float processSample(float x) noexcept { return m_stage.processSample(x); }
+
+private:
+    Stage   m_stage;
+};
+
+template <typename Stage, typename... OtherStages>
+class Serial<Stage, OtherStages...>
+{
+public:
+    void prepare(double sampleRate) noexcept { m_stage.prepare(sampleRate); m_otherStages.prepare(sampleRate); }
+    void reset() noexcept { m_stage.reset(); m_otherStages.reset(); }
+
+    template <typename ProcessorLookup>
+    void updateParameters(ProcessorLookup&& lookup) noexcept { m_stage.updateParameters(lookup); m_otherStages.updateParameters(lookup); }
+
+    forcedinline float processSample(float x) noexcept { return m_otherStages.processSample(m_stage.processSample(x)); }
+
+private:
+    Stage                   m_stage;
+    Serial<OtherStages...>  m_otherStages;
+};
+
+//==============================================================================
+/** Feeds the same input to all stages and sums up their outputs, as the graph does for connections to the same input. */
+template <typename... Stages>
+class Parallel;
+
+template <typename Stage>
+class Parallel<Stage>
+{
+public:
+    void prepare(double sampleRate) noexcept { m_stage.prepare(sampleRate); }
+    void reset() noexcept { m_stage.reset(); }
+
+    template <typename ProcessorLookup>
+    void updateParameters(ProcessorLookup&& lookup) noexcept { m_stage.updateParameters(lookup); }
+
+    forcedinline float processSample(float x) noexcept { return m_stage.processSample(x); }
+
+private:
+    Stage   m_stage;
+};
+
+template <typename Stage, typename... OtherStages>
+class Parallel<Stage, OtherStages...>
+{
+public:
+    void prepare(double sampleRate) noexcept { m_stage.prepare(sampleRate); m_otherStages.prepare(sampleRate); }
+    void reset() noexcept { m_stage.reset(); m_otherStages.reset(); }
+
+    template <typename ProcessorLookup>
+    void updateParameters(ProcessorLookup&& lookup) noexcept { m_stage.updateParameters(lookup); m_otherStages.updateParameters(lookup); }
+
+    forcedinline float processSample(float x) noexcept { return m_stage.processSample(x) + m_otherStages.processSample(x); }
+
+private:
+    Stage                       m_stage;
+    Parallel<OtherStages...>    m_otherStages;
+};
+
+//==============================================================================
+/*
+    Runtime interface of a strip chain, one virtual call per block only.
+    Parameter events are applied by the caller, which splits the block at them.
+*/
+class ChannelStripChainProcessor
+{
+public:
+    using ProcessorArray = std::array<ChannelStripProcessorBase*, ChannelStripProcessorBase::CSPT_Invalid>;
+
+    virtual ~ChannelStripChainProcessor() = default;
+
+    virtual void prepare(double sampleRate, int maxBlockSize) = 0;
+    virtual void reset() = 0;
+    virtual void process(const float* input, float* output, int numSamples) noexcept = 0;
+
+    /** Returns one of the inlined chains below for the common topologies, a flat plan for any other one. Not realtime safe. */
+    static std::unique_ptr<ChannelStripChainProcessor> create(const ChannelStripTopology& topology, const ProcessorArray& processors);
+};
+
+//==============================================================================
+template <typename Chain>
+class CompiledChannelStripChain : public ChannelStripChainProcessor
+{
+public:
+    explicit CompiledChannelStripChain(const ProcessorArray& processors)
+        : m_processors(processors)
+    {
+    }
+
+    void prepare(double sampleRate, int /*maxBlockSize*/) override
+    {
+        m_chain.prepare(sampleRate);
+    }
+
+    void reset() override
+    {
+        m_chain.reset();
+    }
+
+    void process(const float* input, float* output, int numSamples) noexcept override
+    {
+        m_chain.updateParameters([this](ChannelStripProcessorBase::ChannelStripProcessorType type) { return m_processors[static_cast<size_t>(type)]; });
+
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = m_chain.processSample(input[i]);
+    }
+
+private:
+    const ProcessorArray    m_processors;
+    Chain                   m_chain;
+};
+
+using ParallelFiltersGainChain = Serial<Parallel<HighPassStage, LowPassStage>, GainStage>;
+using SerialFiltersGainChain = Serial<HighPassStage, LowPassStage, GainStage>;
+using GainOnlyChain = Serial<GainStage>;
+
+//==============================================================================
+/*
+    Any topology the user edited a strip to, flattened into a list of operations on
+    the output buffer and a few scratch buffers. Each stage's processors run one after
+    the other over the whole segment, the parallel ones on copies of the stage input
+    that are summed up afterwards. Not inlined as the chains above, but without any
+    graph, locks or allocations on the audio thread.
+*/
+class FlatChannelStripChain : public ChannelStripChainProcessor
+{
+public:
+    FlatChannelStripChain(const ChannelStripTopology& topology, const ProcessorArray& processors);
+
+    void prepare(double sampleRate, int maxBlockSize) override;
+    void reset() override;
+    void process(const float* input, float* output, int numSamples) noexcept override;
+
+private:
+    enum OperationCode
+    {
+        OC_Copy,        // source -> destination
+        OC_Accumulate,  // destination += source
+        OC_Process,     // processor of the type, in place on destination
+    };
+
+    struct Operation
+    {
+        OperationCode                                   code;
+        int                                             source;         // buffer index, 0 being the output
+        int                                             destination;
+        ChannelStripProcessorBase::ChannelStripProcessorType type;
+    };
+
+    float* getBuffer(int index, float* output) noexcept;
+
+    const ProcessorArray    m_processors;
+    std::vector<Operation>  m_operations;
+    int                     m_numScratchBuffers{ 0 };
+    int                     m_maxBlockSize{ 0 };
+    HeapBlock<float>        m_scratch;
+
+    std::array<bool, ChannelStripProcessorBase::CSPT_Invalid>   m_contained{};
+    HighPassStage   m_highPass;
+    LowPassStage    m_lowPass;
+    GainStage       m_gain;
+};
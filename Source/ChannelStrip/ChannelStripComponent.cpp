@@ -11,12 +11,64 @@
 #include "ChannelStripComponent.h"
 #include "ChannelStripProcessor.h"
 #include "ChannelStripProcessorEditor.h"
+#include "ChannelStripChain.h"
 
+//==============================================================================
+/* One worker for the chain compilation of all strips, edits are rare and compiling is cheap. */
+struct ChannelStripComponent::ChainCompilePool
+{
+	ThreadPool	pool{ 1 };
+};
+
+//==============================================================================
+class ChannelStripComponent::ChainCompileJob : public ThreadPoolJob
+{
+public:
+	ChainCompileJob(ChannelStripComponent& owner, const ChannelStripTopology& topology, uint32 topologySerial, double sampleRate, int maxBlockSize)
+		: ThreadPoolJob("ChannelStripChainCompile"),
+		m_owner(owner),
+		m_topology(topology),
+		m_topologySerial(topologySerial),
+		m_sampleRate(sampleRate),
+		m_maxBlockSize(maxBlockSize)
+	{
+	}
+
+	bool isFor(const ChannelStripComponent* owner) const
+	{
+		return &m_owner == owner;
+	}
+
+	JobStatus runJob() override
+	{
+		auto chain = ChannelStripChainProcessor::create(m_topology, m_owner.m_processors);
+		chain->prepare(m_sampleRate, m_maxBlockSize);
+		m_owner.setPendingChain(std::move(chain), m_topologySerial);
+
+		return jobHasFinished;
+	}
+
+private:
+	ChannelStripComponent&		m_owner;
+	const ChannelStripTopology	m_topology;
+	const uint32				m_topologySerial;
+	const double				m_sampleRate;
+	const int					m_maxBlockSize;
+};
+
+//==============================================================================
 ChannelStripComponent::ChannelStripComponent()
-	: m_mainProcessor(new AudioProcessorGraph())
+	: m_mainProcessor(new AudioProcessorGraph()),
+	m_topology(ChannelStripTopology::getDefault())
 {
 	initialiseGraph();
 
+	for (int i = 0; i < ChannelStripProcessorBase::CSPT_Invalid; ++i)
+		m_processors[static_cast<size_t>(i)] = getProcessor(static_cast<ChannelStripProcessorBase::ChannelStripProcessorType>(i));
+	m_compiledChain = ChannelStripChainProcessor::create(m_topology, m_processors);
+
+	addMouseListener(&m_topologyMenuListener, true);
+
 	setSize(600, 460);
 }
 
@@ -24,6 +76,14 @@ ChannelStripComponent::~ChannelStripComponent()
 {
 	auto device = MidiInput::getDefaultDevice();
 
+	stopTimer();
+	removeMouseListener(&m_topologyMenuListener);
+
+	// a job still compiling for this strip would hand its chain over to it
+	cancelCompileJobs(5000);
+	delete m_pendingChain.exchange(nullptr);
+	delete m_retiredChain.exchange(nullptr);
+
 	destroyAudioNodes();
 }
 
@@ -50,6 +110,315 @@ void ChannelStripComponent::setChannelColour(const Colour& colour)
 	}
 }
 
+ChannelStripProcessorBase* ChannelStripComponent::getProcessor(ChannelStripProcessorBase::ChannelStripProcessorType type)
+{
+	if (m_mainProcessor)
+	{
+		for (auto const& node : m_mainProcessor->getNodes())
+		{
+			auto processor = node ? dynamic_cast<ChannelStripProcessorBase*>(node->getProcessor()) : nullptr;
+			if (processor && processor->getType() == type)
+				return processor;
+		}
+	}
+
+	return nullptr;
+}
+
+void ChannelStripComponent::setCompiledChainEnabled(bool enabled)
+{
+	// the graph only follows topology edits while it is the one processing, it catches up before it takes over
+	if (!enabled && m_graphConnectionsOutdated)
+		reconnectAudioNodes();
+
+	m_compiledChainEnabled = enabled;
+
+	// a chain compiled while another path was processing is taken with the next block now
+	if (enabled && (m_pendingChain.load() != nullptr || m_retiredChain.load() != nullptr))
+		startTimer(100);
+}
+
+bool ChannelStripComponent::isCompiledChainEnabled() const
+{
+	return m_compiledChainEnabled.load();
+}
+
+void ChannelStripComponent::setMaximumBlockSize(int maxBlockSize)
+{
+	m_maximumBlockSize = maxBlockSize;
+}
+
+void ChannelStripComponent::resetProcessingState()
+{
+	if (m_compiledChain)
+		m_compiledChain->reset();
+	if (m_fadingChain)
+		m_fadingChain->reset();
+
+	m_mainProcessor->reset();
+
+	// whoever processed the strip in the meantime, the chain takes over with the current topology
+	m_compiledChainActive = false;
+}
+
+bool ChannelStripComponent::isReadyForTopology() const
+{
+	return !m_compiledChainEnabled.load() || m_compiledTopologySerial.load() == m_topologySerial.load();
+}
+
+void ChannelStripComponent::setTopology(const ChannelStripTopology& topology)
+{
+	if (topology == m_topology)
+		return;
+
+	m_topology = topology;
+
+	// rewiring the graph has it rebuild its render sequence and swap it in under the callback lock,
+	// which is only worth it while the graph is the one processing
+	if (m_compiledChainEnabled.load())
+		m_graphConnectionsOutdated = true;
+	else
+		reconnectAudioNodes();
+
+	compileTopology();
+	resized();
+
+	if (onTopologyChanged)
+		onTopologyChanged();
+}
+
+const ChannelStripTopology& ChannelStripComponent::getTopology() const
+{
+	return m_topology;
+}
+
+void ChannelStripComponent::compileTopology()
+{
+	auto topologySerial = ++m_topologySerial;
+
+	// without a device the chain can be replaced right here, audioDeviceAboutToStart prepares it
+	if (m_preparedBlockSize <= 0)
+	{
+		m_compiledChain = ChannelStripChainProcessor::create(m_topology, m_processors);
+		m_compiledTopologySerial = topologySerial;
+		return;
+	}
+
+	// jobs not started yet are outdated, one already running hands over its chain before the new one does
+	cancelCompileJobs(0);
+	delete m_retiredChain.exchange(nullptr);
+
+	m_compilePool->pool.addJob(new ChainCompileJob(*this, m_topology, topologySerial, m_preparedSampleRate, m_preparedBlockSize), true);
+	startTimer(100);
+}
+
+void ChannelStripComponent::cancelCompileJobs(int timeOutMs)
+{
+	struct OwnJobSelector : public ThreadPool::JobSelector
+	{
+		explicit OwnJobSelector(ChannelStripComponent* owner) : m_owner(owner) {}
+		bool isJobSuitable(ThreadPoolJob* job) override
+		{
+			auto compileJob = dynamic_cast<ChainCompileJob*>(job);
+			return compileJob != nullptr && compileJob->isFor(m_owner);
+		}
+
+		ChannelStripComponent* m_owner;
+	};
+
+	OwnJobSelector selector(this);
+	m_compilePool->pool.removeAllJobs(false, timeOutMs, &selector);
+}
+
+void ChannelStripComponent::setPendingChain(std::unique_ptr<ChannelStripChainProcessor> chain, uint32 topologySerial)
+{
+	// a chain the audio thread did not take yet was outdated by this one
+	delete m_pendingChain.exchange(chain.release());
+	m_compiledTopologySerial = topologySerial;
+}
+
+void ChannelStripComponent::timerCallback()
+{
+	// the order of the checks matters, the audio thread flags a crossfade before it takes the pending chain
+	// and retires the old chain before it clears the flag
+	auto isPending = m_pendingChain.load() != nullptr;
+	auto isFading = m_crossfadeRunning.load();
+	auto isChainProcessing = m_compiledChainProcessed.exchange(false);
+
+	delete m_retiredChain.exchange(nullptr);
+
+	// with the graph or the strip engine processing, a pending chain waits for the compiled path to be used again.
+	// Switching back restarts the timer from setCompiledChainEnabled, a chain retired without it is collected with the next compile.
+	if (!isFading && (!isPending || !isChainProcessing))
+		stopTimer();
+}
+
+void ChannelStripComponent::installPendingChain() noexcept
+{
+	// one crossfade at a time, and the chain faded out last has to be collected before the next one can be retired
+	if (m_fadingChain || m_retiredChain.load() != nullptr || m_pendingChain.load() == nullptr)
+		return;
+
+	m_crossfadeRunning = true;
+	auto pendingChain = m_pendingChain.exchange(nullptr);
+	jassert(pendingChain != nullptr);
+
+	m_fadingChain = std::move(m_compiledChain);
+	m_compiledChain.reset(pendingChain);
+	m_crossfadeSamplesRemaining = m_crossfadeSamples;
+}
+
+void ChannelStripComponent::takePendingChain() noexcept
+{
+	if (m_fadingChain || m_retiredChain.load() != nullptr || m_pendingChain.load() == nullptr)
+		return;
+
+	m_retiredChain = m_compiledChain.release();
+	m_compiledChain.reset(m_pendingChain.exchange(nullptr));
+}
+
+void ChannelStripComponent::processCompiledChain(const float* input, float* output, int numSamples) noexcept
+{
+	// split at the parameter events of all processors, the chains pick up the parameters again at each one
+	for (int offset = 0; offset < numSamples;)
+	{
+		auto numSegmentSamples = numSamples - offset;
+		for (auto processor : m_processors)
+			if (processor != nullptr)
+				numSegmentSamples = processor->applyDueParameterEvents(numSegmentSamples);
+
+		if (m_fadingChain)
+		{
+			// the outgoing chain first, the output may be the input buffer itself
+			auto fadingOutput = m_crossfadeBuffer.get();
+			m_fadingChain->process(input + offset, fadingOutput, numSegmentSamples);
+			m_compiledChain->process(input + offset, output + offset, numSegmentSamples);
+
+			for (int i = 0; i < numSegmentSamples; ++i)
+			{
+				auto newChainGain = 1.0f - static_cast<float>(m_crossfadeSamplesRemaining) / static_cast<float>(m_crossfadeSamples);
+				output[offset + i] = fadingOutput[i] + newChainGain * (output[offset + i] - fadingOutput[i]);
+				if (m_crossfadeSamplesRemaining > 0)
+					--m_crossfadeSamplesRemaining;
+			}
+
+			if (m_crossfadeSamplesRemaining == 0)
+			{
+				m_retiredChain = m_fadingChain.release();
+				m_crossfadeRunning = false;
+			}
+		}
+		else
+		{
+			m_compiledChain->process(input + offset, output + offset, numSegmentSamples);
+		}
+
+		for (auto processor : m_processors)
+			if (processor != nullptr)
+				processor->advanceSamplePosition(numSegmentSamples);
+
+		offset += numSegmentSamples;
+	}
+}
+
+void ChannelStripComponent::showTopologyMenu(AudioProcessorEditor* clickedEditor)
+{
+	enum MenuItem
+	{
+		MI_Remove = 1,
+		MI_MoveEarlier,
+		MI_MoveLater,
+		MI_Reset,
+		MI_LearnFrequency,
+		MI_LearnGain,
+		MI_ForgetMidi,
+		MI_InsertFirst = 100,
+		MI_InsertLast = 200,
+	};
+
+	auto clickedProcessor = clickedEditor ? dynamic_cast<ChannelStripProcessorBase*>(clickedEditor->getAudioProcessor()) : nullptr;
+	auto clickedType = clickedProcessor ? clickedProcessor->getType() : ChannelStripProcessorBase::CSPT_Invalid;
+
+	PopupMenu menu;
+	auto stageIndex = m_topology.getStageIndex(clickedType);
+	if (stageIndex >= 0)
+	{
+		auto isShared = m_topology.stages[static_cast<size_t>(stageIndex)].size() > 1;
+		menu.addSectionHeader(clickedProcessor->getName());
+		menu.addItem(MI_Remove, "Remove");
+		menu.addItem(MI_MoveEarlier, "Move earlier", isShared || stageIndex > 0);
+		menu.addItem(MI_MoveLater, "Move later", isShared || stageIndex < static_cast<int>(m_topology.stages.size()) - 1);
+		if (onMidiLearn)
+		{
+			if (auto parameter = clickedProcessor->getTargetParameter(ParameterEvent::PET_Frequency))
+				menu.addItem(MI_LearnFrequency, "MIDI learn " + parameter->name);
+			if (auto parameter = clickedProcessor->getTargetParameter(ParameterEvent::PET_Gain))
+				menu.addItem(MI_LearnGain, "MIDI learn " + parameter->name);
+			menu.addItem(MI_ForgetMidi, "Forget MIDI controllers", onMidiForget != nullptr);
+		}
+		menu.addSeparator();
+	}
+
+	PopupMenu insertFirstMenu, insertLastMenu;
+	for (int i = 0; i < ChannelStripProcessorBase::CSPT_Invalid; ++i)
+	{
+		auto processor = m_processors[static_cast<size_t>(i)];
+		if (processor != nullptr && !m_topology.contains(processor->getType()))
+		{
+			insertFirstMenu.addItem(MI_InsertFirst + i, processor->getName());
+			insertLastMenu.addItem(MI_InsertLast + i, processor->getName());
+		}
+	}
+	menu.addSubMenu("Insert first", insertFirstMenu, insertFirstMenu.getNumItems() > 0);
+	menu.addSubMenu("Insert last", insertLastMenu, insertLastMenu.getNumItems() > 0);
+	menu.addItem(MI_Reset, "Reset to default", m_topology != ChannelStripTopology::getDefault());
+
+	SafePointer<ChannelStripComponent> safeThis(this);
+	menu.showMenuAsync(PopupMenu::Options(), [safeThis, clickedType](int result) {
+		if (!safeThis || result == 0)
+			return;
+
+		if (result == MI_LearnFrequency || result == MI_LearnGain)
+		{
+			safeThis->onMidiLearn(clickedType, result == MI_LearnFrequency ? ParameterEvent::PET_Frequency : ParameterEvent::PET_Gain);
+			return;
+		}
+		else if (result == MI_ForgetMidi)
+		{
+			safeThis->onMidiForget(clickedType);
+			return;
+		}
+
+		auto topology = safeThis->getTopology();
+		if (result >= MI_InsertLast)
+			topology.insertProcessor(static_cast<ChannelStripProcessorBase::ChannelStripProcessorType>(result - MI_InsertLast), static_cast<int>(topology.stages.size()), false);
+		else if (result >= MI_InsertFirst)
+			topology.insertProcessor(static_cast<ChannelStripProcessorBase::ChannelStripProcessorType>(result - MI_InsertFirst), 0, false);
+		else if (result == MI_Remove)
+			topology.removeProcessor(clickedType);
+		else if (result == MI_MoveEarlier)
+			topology.moveProcessor(clickedType, false);
+		else if (result == MI_MoveLater)
+			topology.moveProcessor(clickedType, true);
+		else if (result == MI_Reset)
+			topology = ChannelStripTopology::getDefault();
+
+		safeThis->setTopology(topology);
+	});
+}
+
+void ChannelStripComponent::TopologyMenuListener::mouseDown(const MouseEvent& e)
+{
+	if (!e.mods.isPopupMenu() || e.eventComponent == nullptr)
+		return;
+
+	auto editor = dynamic_cast<AudioProcessorEditor*>(e.eventComponent);
+	if (editor == nullptr)
+		editor = e.eventComponent->findParentComponentOfClass<AudioProcessorEditor>();
+
+	m_owner.showTopologyMenu(editor);
+}
+
 void ChannelStripComponent::resized()
 {
 	OverlayToggleComponentBase::resized();
@@ -60,15 +429,27 @@ void ChannelStripComponent::resized()
 	fb.flexDirection = isPortrait ? FlexBox::Direction::column : FlexBox::Direction::row;
 	fb.justifyContent = FlexBox::JustifyContent::center;
 
-	for (auto& node : m_mainProcessor->getNodes())
+	// editors in processing order, the ones of processors not in the topology are hidden
+	for (auto const& stage : m_topology.stages)
 	{
-		AudioProcessorEditor* editor = node->getProcessor()->getActiveEditor();
-		if (editor)
+		for (auto type : stage)
 		{
-			fb.items.add(FlexItem(*editor).withFlex(1));
+			auto processor = m_processors[static_cast<size_t>(type)];
+			AudioProcessorEditor* editor = processor ? processor->getActiveEditor() : nullptr;
+			if (editor)
+			{
+				fb.items.add(FlexItem(*editor).withFlex(1));
+			}
 		}
 	}
 
+	for (auto processor : m_processors)
+	{
+		AudioProcessorEditor* editor = processor ? processor->getActiveEditor() : nullptr;
+		if (editor)
+			editor->setVisible(m_topology.contains(processor->getType()));
+	}
+
 	fb.performLayout(getOverlayBounds().reduced(10).toFloat());
 }
 
@@ -126,50 +507,60 @@ void ChannelStripComponent::createAudioNodes()
 	m_audioOutputNode = m_mainProcessor->addNode(std::make_unique<AudioGraphIOProcessor>(AudioGraphIOProcessor::audioOutputNode));
 }
 
+ChannelStripComponent::Node::Ptr ChannelStripComponent::getNode(ChannelStripProcessorBase::ChannelStripProcessorType type)
+{
+	for (auto const& node : m_mainProcessor->getNodes())
+	{
+		auto processor = node ? dynamic_cast<ChannelStripProcessorBase*>(node->getProcessor()) : nullptr;
+		if (processor && processor->getType() == type)
+			return node;
+	}
+
+	return nullptr;
+}
+
 void ChannelStripComponent::connectAudioNodes()
 {
-	ReferenceCountedArray<Node> activeNodes = m_mainProcessor->getNodes();
+	jassert(m_audioInputNode != nullptr);	// We require an input
+	jassert(m_audioOutputNode != nullptr);	// as well as an output
 
-	jassert(activeNodes.getFirst() == m_audioInputNode);	// We require an input
-	jassert(activeNodes.getLast() == m_audioOutputNode);	// as well as an output
-	jassert(activeNodes.size() == 5);						// and rely on having three nodes inbetween (HP, LP, Gain)
-	if (activeNodes.size() == 5)
-	{
-		auto Inputnode = activeNodes.getUnchecked(0);
-		auto HPFnode = activeNodes.getUnchecked(1);
-		auto LPFnode = activeNodes.getUnchecked(2);
-		auto Gainnode = activeNodes.getUnchecked(3);
-		auto Outputnode = activeNodes.getUnchecked(4);
+	// each stage is fed by all nodes of the one before (the graph sums them up), the first one by the input
+	std::vector<Node::Ptr> previousNodes{ m_audioInputNode };
+	auto connectTo = [this, &previousNodes](const Node::Ptr& node) {
+		for (auto const& previousNode : previousNodes)
+			for (int channel = 0; channel < m_mainProcessor->getMainBusNumInputChannels(); ++channel)
+				m_mainProcessor->addConnection({	{ previousNode->nodeID,	channel },
+													{ node->nodeID,			channel } });
+	};
 
-		for (int channel = 0; channel < m_mainProcessor->getMainBusNumInputChannels(); ++channel)
-		{
-			// feed the input to both hp and lp
-			m_mainProcessor->addConnection({	{ Inputnode->nodeID,    channel },
-												{ HPFnode->nodeID,		channel } });
-			m_mainProcessor->addConnection({	{ Inputnode->nodeID,    channel },
-												{ LPFnode->nodeID,		channel } });
-
-			// feed both hp and lp to gain (sum up)
-			m_mainProcessor->addConnection({	{ HPFnode->nodeID,		channel },
-												{ Gainnode->nodeID,		channel } });
-			m_mainProcessor->addConnection({	{ LPFnode->nodeID,		channel },
-												{ Gainnode->nodeID,		channel } });
-
-			// feed gain to output
-			m_mainProcessor->addConnection({	{ Gainnode->nodeID,		channel },
-												{ Outputnode->nodeID,	channel } });
-		}
-	}
-	else
+	for (auto const& stage : m_topology.stages)
 	{
-		// if we do not have the expected 5 nodes, setup a dummy chain of nodes to at least have something
-		for (int i = 0; i < activeNodes.size() - 1; ++i)
+		std::vector<Node::Ptr> stageNodes;
+		for (auto type : stage)
 		{
-			for (int channel = 0; channel < m_mainProcessor->getMainBusNumInputChannels(); ++channel)
-				m_mainProcessor->addConnection({ { activeNodes.getUnchecked(i)->nodeID,      channel },
-												{ activeNodes.getUnchecked(i + 1)->nodeID,  channel } });
+			auto node = getNode(type);
+			if (node != nullptr)
+			{
+				connectTo(node);
+				stageNodes.push_back(node);
+			}
 		}
+
+		if (!stageNodes.empty())
+			previousNodes = stageNodes;
 	}
+
+	// feed the last stage to output
+	connectTo(m_audioOutputNode);
+}
+
+void ChannelStripComponent::reconnectAudioNodes()
+{
+	for (auto connection : m_mainProcessor->getConnections())
+		m_mainProcessor->removeConnection(connection);
+	connectAudioNodes();
+
+	m_graphConnectionsOutdated = false;
 }
 
 void ChannelStripComponent::destroyAudioNodes()
@@ -192,12 +583,67 @@ void ChannelStripComponent::audioDeviceIOCallback(const float** inputChannelData
 	int numOutputChannels,
 	int numSamples)
 {
+	if (m_compiledChainEnabled.load() && m_compiledChain)
+	{
+		// taking over from the graph or the strip engine, the chain for the current topology starts right away
+		// from clean filter state, fading it in is up to whoever processed the strip before
+		if (!m_compiledChainActive)
+		{
+			takePendingChain();
+			m_compiledChain->reset();
+		}
+		m_compiledChainActive = true;
+		m_compiledChainProcessed = true;
+
+		// a recompiled topology is only ever swapped in between two blocks
+		installPendingChain();
+
+		for (int channel = 0; channel < numOutputChannels; ++channel)
+		{
+			if (outputChannelData[channel] == nullptr)
+				continue;
+
+			if (channel == 0 && numInputChannels > 0 && inputChannelData[0] != nullptr)
+				processCompiledChain(inputChannelData[0], outputChannelData[0], numSamples);
+			else
+				FloatVectorOperations::clear(outputChannelData[channel], numSamples);
+		}
+
+		return;
+	}
+
+	m_compiledChainActive = false;
 	m_player.audioDeviceIOCallback(inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples);
 }
 
 void ChannelStripComponent::audioDeviceAboutToStart(AudioIODevice* device)
 {
+	if (device)
+	{
+		m_preparedSampleRate = device->getCurrentSampleRate();
+		m_preparedBlockSize = jmax(m_maximumBlockSize, device->getCurrentBufferSizeSamples());
+
+		// nothing is processed right now, so the chain for the current topology is swapped in directly
+		cancelCompileJobs(5000);
+		delete m_pendingChain.exchange(nullptr);
+		delete m_retiredChain.exchange(nullptr);
+		m_fadingChain.reset();
+		m_crossfadeRunning = false;
+		m_crossfadeSamplesRemaining = 0;
+
+		m_compiledChain = ChannelStripChainProcessor::create(m_topology, m_processors);
+		m_compiledChain->prepare(m_preparedSampleRate, m_preparedBlockSize);
+		m_compiledTopologySerial = m_topologySerial.load();
+
+		m_crossfadeBuffer.allocate(static_cast<size_t>(m_preparedBlockSize), true);
+		m_crossfadeSamples = jmax(1, roundToInt(m_preparedSampleRate * getCrossfadeSeconds()));
+	}
+
 	m_player.audioDeviceAboutToStart(device);
+
+	// the processors take their ProcessSpec from here, so it has to cover the largest block they are called with
+	if (device && m_maximumBlockSize > device->getCurrentBufferSizeSamples())
+		m_mainProcessor->prepareToPlay(device->getCurrentSampleRate(), m_maximumBlockSize);
 }
 
 void ChannelStripComponent::audioDeviceStopped()
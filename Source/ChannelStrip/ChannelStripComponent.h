@@ -14,12 +14,16 @@
 
 #include "ChannelStripProcessorPlayer.h"
 #include "ChannelStripProcessor.h"
+#include "ChannelStripTopology.h"
+
+class ChannelStripChainProcessor;
 
 #include "../submodules/JUCE-AppBasics/Source/OverlayToggleComponentBase.h"
 
 //==============================================================================
 class ChannelStripComponent  :  public JUCEAppBasics::OverlayToggleComponentBase,
-                                public AudioIODeviceCallback
+                                public AudioIODeviceCallback,
+                                private Timer
 {
 public:
     //==============================================================================
@@ -32,6 +36,35 @@ public:
 
     void setChannelColour(const Colour& colour);
 
+    ChannelStripProcessorBase* getProcessor(ChannelStripProcessorBase::ChannelStripProcessorType type);
+
+    /** Switches between the compile-time specialised chain and the processor graph, both bound to the same parameters. */
+    void setCompiledChainEnabled(bool enabled);
+    bool isCompiledChainEnabled() const;
+
+    /** Blocks larger than the device buffer size the graph gets prepared for with audioDeviceAboutToStart. */
+    void setMaximumBlockSize(int maxBlockSize);
+
+    /** Clears the filter state of the chain and the graph, from the thread processing the strip. */
+    void resetProcessingState();
+
+    /** Whether what processes the strip is ready for the current topology, false while its chain is still being compiled. */
+    bool isReadyForTopology() const;
+
+    /** Length of the crossfades between two chains, and between the chain and the strip engine. */
+    static double getCrossfadeSeconds() { return 0.01; }
+
+    /** Changes the order the processors run in. The chain for it is compiled on a background thread
+        and crossfaded to at a block boundary, the graph gets reconnected right away. */
+    void setTopology(const ChannelStripTopology& topology);
+    const ChannelStripTopology& getTopology() const;
+
+    /** Called on the message thread after the topology was changed, by the user or setTopology. */
+    std::function<void()>   onTopologyChanged;
+    /** Called from the strip's menu to map the next MIDI controller moved to a parameter, or to remove all mappings of a processor. */
+    std::function<void(ChannelStripProcessorBase::ChannelStripProcessorType, ParameterEvent::Target)>   onMidiLearn;
+    std::function<void(ChannelStripProcessorBase::ChannelStripProcessorType)>                           onMidiForget;
+
     //==============================================================================
     void resized() override;
 
@@ -46,11 +79,37 @@ public:
     void audioDeviceError(const juce::String &errorMessage) override;
 
 private:
+    class ChainCompileJob;
+    struct ChainCompilePool;
+
+    /* Opens the topology menu on right clicks anywhere on the strip, including the editors. */
+    struct TopologyMenuListener : public MouseListener
+    {
+        explicit TopologyMenuListener(ChannelStripComponent& owner) : m_owner(owner) {};
+        void mouseDown(const MouseEvent& e) override;
+
+        ChannelStripComponent& m_owner;
+    };
+
+    //==============================================================================
+    void timerCallback() override;
+
+    void showTopologyMenu(AudioProcessorEditor* clickedEditor);
+    void compileTopology();
+    void cancelCompileJobs(int timeOutMs);
+    void setPendingChain(std::unique_ptr<ChannelStripChainProcessor> chain, uint32 topologySerial);
+    void installPendingChain() noexcept;
+    void takePendingChain() noexcept;
+    void processCompiledChain(const float* input, float* output, int numSamples) noexcept;
+
+    Node::Ptr getNode(ChannelStripProcessorBase::ChannelStripProcessorType type);
+
     //==============================================================================
     void initialiseGraph();
 
     void createAudioNodes();
     void connectAudioNodes();
+    void reconnectAudioNodes();
     void destroyAudioNodes();
 
     //==============================================================================
@@ -63,6 +122,32 @@ private:
 
     ChannelStripProcessorPlayer                         m_player;
 
+    std::unique_ptr<ChannelStripChainProcessor>         m_compiledChain;
+    std::atomic<bool>                                   m_compiledChainEnabled{ true };
+    bool                                                m_compiledChainActive{ false };
+    std::atomic<bool>                                   m_compiledChainProcessed{ false };  // set by the audio thread, cleared by the timer
+    bool                                                m_graphConnectionsOutdated{ false };
+
+    std::array<ChannelStripProcessorBase*, ChannelStripProcessorBase::CSPT_Invalid> m_processors{};
+    ChannelStripTopology                                m_topology;
+    TopologyMenuListener                                m_topologyMenuListener{ *this };
+    SharedResourcePointer<ChainCompilePool>             m_compilePool;
+
+    // chains handed over between the compile job, the audio thread and the message thread, each slot owns its chain
+    std::atomic<ChannelStripChainProcessor*>            m_pendingChain{ nullptr };  // compiled, not yet taken by the audio thread
+    std::atomic<ChannelStripChainProcessor*>            m_retiredChain{ nullptr };  // faded out, to be deleted by the message thread
+    std::unique_ptr<ChannelStripChainProcessor>         m_fadingChain;              // audio thread only
+    HeapBlock<float>                                    m_crossfadeBuffer;
+    int                                                 m_crossfadeSamples{ 0 };
+    int                                                 m_crossfadeSamplesRemaining{ 0 };
+    std::atomic<bool>                                   m_crossfadeRunning{ false };
+    std::atomic<uint32>                                 m_topologySerial{ 0 };          // counted up with each topology change
+    std::atomic<uint32>                                 m_compiledTopologySerial{ 0 };  // the one of the latest compiled chain
+
+    double                                              m_preparedSampleRate{ 0.0 };
+    int                                                 m_preparedBlockSize{ 0 };
+    int                                                 m_maximumBlockSize{ 0 };
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChannelStripComponent)
 };
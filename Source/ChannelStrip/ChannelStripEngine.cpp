@@ -0,0 +1,390 @@
+/*
+  ==============================================================================
+
+    ChannelStripEngine.cpp
+    Created: 17 Oct 2026 2:47:55pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "ChannelStripEngine.h"
+
+// damping of the state variable filters, equals the default resonance of 1/sqrt(2) dsp::StateVariableTPTFilter uses
+static constexpr float SVF_R2 = MathConstants<float>::sqrt2;
+
+ChannelStripEngine::ChannelStripEngine()
+{
+}
+
+ChannelStripEngine::~ChannelStripEngine()
+{
+}
+
+size_t ChannelStripEngine::getScratchSize(int maxBlockSize) noexcept
+{
+    return 2 * ScratchArena::getFloatsSize(getNumLanes() * maxBlockSize) + 2 * ScratchArena::getFloatsSize(maxBlockSize);
+}
+
+void ChannelStripEngine::prepare(double sampleRate, int maxChannels, int maxBlockSize)
+{
+    m_sampleRate = sampleRate;
+    m_maxChannels = jmax(0, maxChannels);
+    m_maxBlockSize = jmax(1, maxBlockSize);
+
+    auto numLanes = getNumLanes();
+    m_paddedChannels = jmax(1, (m_maxChannels + numLanes - 1) / numLanes) * numLanes;
+
+    m_processors.assign(static_cast<size_t>(m_maxChannels), ChannelProcessors());
+    m_parameters.assign(static_cast<size_t>(m_maxChannels), ChannelParameters());
+    m_parametersByValue.calloc(static_cast<size_t>(jmax(1, m_maxChannels)));
+
+    // one extra register worth of floats to be able to align the start of the pools
+    std::vector<float**> stateArrays{ &m_hpS1, &m_hpS2, &m_hpG, &m_hpH, &m_hpCutoff, &m_hpTargetG, &m_lpS1, &m_lpS2, &m_lpG, &m_lpH, &m_lpCutoff, &m_lpTargetG,
+                                      &m_hpAmount, &m_hpAmountStep, &m_lpAmount, &m_lpAmountStep };
+    m_statePool.calloc(static_cast<size_t>(static_cast<int>(stateArrays.size()) * m_paddedChannels + numLanes));
+    auto statePtr = FloatVector::getNextSIMDAlignedPtr(m_statePool.get());
+    for (auto stateArray : stateArrays)
+    {
+        *stateArray = statePtr;
+        statePtr += m_paddedChannels;
+    }
+
+    m_groupInputs.calloc(static_cast<size_t>(numLanes));
+    m_groupOutputs.calloc(static_cast<size_t>(numLanes));
+
+    reset();
+}
+
+void ChannelStripEngine::reset()
+{
+    // with the coefficients cleared, the next block starts right at the parameter values instead of smoothing towards them
+    for (auto stateArray : { m_hpS1, m_hpS2, m_lpS1, m_lpS2, m_hpG, m_lpG, m_hpCutoff, m_lpCutoff, m_hpAmount, m_lpAmount, m_hpAmountStep, m_lpAmountStep })
+        FloatVectorOperations::clear(stateArray, m_paddedChannels);
+}
+
+void ChannelStripEngine::resetChannel(int channel) noexcept
+{
+    if (!isPositiveAndBelow(channel, m_maxChannels))
+        return;
+
+    m_hpS1[channel] = m_hpS2[channel] = m_lpS1[channel] = m_lpS2[channel] = 0.0f;
+    m_hpCutoff[channel] = m_lpCutoff[channel] = 0.0f;
+    m_hpG[channel] = m_lpG[channel] = 0.0f;
+
+    // what was left of the amounts is from before the channel was handed over, they are not ramped from there
+    auto parameters = m_parametersByValue[channel] ? m_parameters[static_cast<size_t>(channel)] : getChannelParameters(m_processors[static_cast<size_t>(channel)]);
+    m_hpAmount[channel] = parameters.highPassGain * parameters.gain;
+    m_lpAmount[channel] = parameters.lowPassGain * parameters.gain;
+    m_hpAmountStep[channel] = m_lpAmountStep[channel] = 0.0f;
+}
+
+void ChannelStripEngine::setChannelProcessors(int channel, const ChannelProcessors& processors)
+{
+    if (!isPositiveAndBelow(channel, m_maxChannels))
+    {
+        jassertfalse;
+        return;
+    }
+
+    auto& current = m_processors[static_cast<size_t>(channel)];
+    if (current.highPass != processors.highPass || current.lowPass != processors.lowPass || current.gain != processors.gain)
+    {
+        // a channel rebound to another strip starts from silence and picks up the new coefficients
+        current = processors;
+        m_hpS1[channel] = m_hpS2[channel] = m_lpS1[channel] = m_lpS2[channel] = 0.0f;
+        m_hpCutoff[channel] = m_lpCutoff[channel] = 0.0f;
+        m_hpG[channel] = m_lpG[channel] = 0.0f;
+    }
+}
+
+float ChannelStripEngine::calculateCoefficientG(float cutoff, double sampleRate) noexcept
+{
+    // tan() turns negative at and above Nyquist, the filter would blow up. Kept just below it, as 20 kHz is with 44.1 kHz.
+    auto normalisedCutoff = jlimit(1.0 / sampleRate, 0.49, static_cast<double>(cutoff) / sampleRate);
+    if (!std::isfinite(normalisedCutoff))
+        normalisedCutoff = 0.49;
+
+    return static_cast<float>(std::tan(MathConstants<double>::pi * normalisedCutoff));
+}
+
+void ChannelStripEngine::setChannelParameters(int channel, const ChannelParameters& parameters) noexcept
+{
+    if (!isPositiveAndBelow(channel, m_maxChannels))
+    {
+        jassertfalse;
+        return;
+    }
+
+    m_parameters[static_cast<size_t>(channel)] = parameters;
+    m_parametersByValue[channel] = true;
+}
+
+ChannelStripEngine::ChannelParameters ChannelStripEngine::getChannelParameters(const ChannelProcessors& processors) noexcept
+{
+    ChannelParameters parameters;
+
+    if (processors.highPass)
+    {
+        parameters.highPassCutoff = processors.highPass->getFilterFequency();
+        parameters.highPassGain = processors.highPass->getFilterGain();
+    }
+
+    if (processors.lowPass)
+    {
+        parameters.lowPassCutoff = processors.lowPass->getFilterFequency();
+        parameters.lowPassGain = processors.lowPass->getFilterGain();
+    }
+
+    if (processors.gain)
+        parameters.gain = processors.gain->getFilterGain();
+
+    return parameters;
+}
+
+void ChannelStripEngine::setChannelTargets(const ChannelProcessors& processors, const ChannelParameters& parameters) noexcept
+{
+    if (processors.highPass)
+    {
+        processors.highPass->setParameterTarget(ParameterEvent::PET_Frequency, parameters.highPassCutoff);
+        processors.highPass->setParameterTarget(ParameterEvent::PET_Gain, parameters.highPassGain);
+    }
+
+    if (processors.lowPass)
+    {
+        processors.lowPass->setParameterTarget(ParameterEvent::PET_Frequency, parameters.lowPassCutoff);
+        processors.lowPass->setParameterTarget(ParameterEvent::PET_Gain, parameters.lowPassGain);
+    }
+
+    if (processors.gain)
+        processors.gain->setParameterTarget(ParameterEvent::PET_Gain, parameters.gain);
+}
+
+void ChannelStripEngine::applyParameterEvents(const ChannelProcessors& processors, int numSamples) noexcept
+{
+    for (auto processor : { processors.highPass, processors.lowPass, processors.gain })
+        if (processor != nullptr)
+            processor->applyParameterEventsOfBlock(numSamples);
+}
+
+void ChannelStripEngine::updateCoefficientH(float* g, float* h, int channel, float targetG, float smoothing) noexcept
+{
+    // the cutoff moves towards its target on a log scale, so sweeps sound even across the whole range
+    if (g[channel] <= 0.0f || std::abs(targetG - g[channel]) < 1.0e-4f * targetG)
+        g[channel] = targetG;
+    else if (g[channel] != targetG)
+        g[channel] *= std::pow(targetG / g[channel], smoothing);
+    else
+        return;
+
+    h[channel] = 1.0f / (1.0f + SVF_R2 * g[channel] + g[channel] * g[channel]);
+}
+
+void ChannelStripEngine::updateParameters(int channel, float smoothing, int numSamples) noexcept
+{
+    if (!m_parametersByValue[channel])
+        applyParameterEvents(m_processors[static_cast<size_t>(channel)], numSamples);
+
+    auto parameters = m_parametersByValue[channel] ? m_parameters[static_cast<size_t>(channel)] : getChannelParameters(m_processors[static_cast<size_t>(channel)]);
+
+    if (parameters.highPassCutoff != m_hpCutoff[channel])
+    {
+        m_hpCutoff[channel] = parameters.highPassCutoff;
+        m_hpTargetG[channel] = calculateCoefficientG(parameters.highPassCutoff, m_sampleRate);
+    }
+    updateCoefficientH(m_hpG, m_hpH, channel, m_hpTargetG[channel], smoothing);
+
+    if (parameters.lowPassCutoff != m_lpCutoff[channel])
+    {
+        m_lpCutoff[channel] = parameters.lowPassCutoff;
+        m_lpTargetG[channel] = calculateCoefficientG(parameters.lowPassCutoff, m_sampleRate);
+    }
+    updateCoefficientH(m_lpG, m_lpH, channel, m_lpTargetG[channel], smoothing);
+
+    // the amounts are ramped linearly over the block to where the smoothing gets them by its end
+    auto hpTarget = parameters.highPassGain * parameters.gain;
+    auto lpTarget = parameters.lowPassGain * parameters.gain;
+    auto hpBlockTarget = std::abs(hpTarget - m_hpAmount[channel]) < 1.0e-5f ? hpTarget : m_hpAmount[channel] + smoothing * (hpTarget - m_hpAmount[channel]);
+    auto lpBlockTarget = std::abs(lpTarget - m_lpAmount[channel]) < 1.0e-5f ? lpTarget : m_lpAmount[channel] + smoothing * (lpTarget - m_lpAmount[channel]);
+    m_hpAmountStep[channel] = (hpBlockTarget - m_hpAmount[channel]) / static_cast<float>(numSamples);
+    m_lpAmountStep[channel] = (lpBlockTarget - m_lpAmount[channel]) / static_cast<float>(numSamples);
+}
+
+void ChannelStripEngine::process(const float* const* inputs, float* const* outputs, int numChannels, int numSamples, ScratchArena& scratch, const bool* activeChannels) noexcept
+{
+    beginBlock(numChannels, numSamples);
+    processRange(inputs, outputs, numChannels, numSamples, scratch, activeChannels);
+}
+
+void ChannelStripEngine::beginBlock(int numChannels, int numSamples) noexcept
+{
+    numChannels = jmin(numChannels, m_maxChannels);
+    numSamples = jmax(1, numSamples);
+
+    // how far the parameters move towards their targets within this block
+    auto smoothingSamples = static_cast<float>(ChannelStripProcessorBase::getSmoothingSeconds() * m_sampleRate);
+    auto smoothing = jmin(1.0f, static_cast<float>(numSamples) / jmax(1.0f, smoothingSamples));
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        updateParameters(ch, smoothing, numSamples);
+}
+
+void ChannelStripEngine::processRange(const float* const* inputs, float* const* outputs, int numChannels, int numSamples, ScratchArena& scratch, const bool* activeChannels) noexcept
+{
+    // the interleaved scratch is sized for this, callers have to split larger blocks
+    jassert(numSamples <= m_maxBlockSize);
+    numSamples = jmin(numSamples, m_maxBlockSize);
+    numChannels = jmin(numChannels, m_maxChannels);
+
+    // the arena's cache line alignment satisfies the SIMD alignment as well
+    ScratchArena::ScopedCheckout scratchCheckout(scratch);
+    m_interleavedInput = scratch.allocateFloats(getNumLanes() * numSamples);
+    m_interleavedOutput = scratch.allocateFloats(getNumLanes() * numSamples);
+    m_silentChannel = scratch.allocateFloats(numSamples);
+    m_discardChannel = scratch.allocateFloats(numSamples);
+
+    if (m_vectorisationEnabled.load() && m_discardChannel != nullptr)
+    {
+        if (numChannels % getNumLanes() != 0)
+            FloatVectorOperations::clear(m_silentChannel, numSamples);
+
+        for (int ch = 0; ch < numChannels; ch += getNumLanes())
+        {
+            // groups are only skipped as a whole, inactive lanes of a processed group are cleared afterwards
+            auto lastChannel = jmin(ch + getNumLanes(), numChannels);
+            auto anyActive = activeChannels == nullptr;
+            for (int lane = ch; lane < lastChannel && !anyActive; ++lane)
+                anyActive = activeChannels[lane];
+
+            if (anyActive)
+                processVectorised(ch, inputs, outputs, numChannels, numSamples);
+
+            if (activeChannels != nullptr)
+            {
+                for (int lane = ch; lane < lastChannel; ++lane)
+                    if (!activeChannels[lane])
+                        skipChannel(lane, outputs[lane], numSamples);
+            }
+        }
+    }
+    else
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            if (activeChannels == nullptr || activeChannels[ch])
+                processScalar(ch, inputs[ch], outputs[ch], numSamples);
+            else
+                skipChannel(ch, outputs[ch], numSamples);
+        }
+    }
+
+    // channels without a strip are passed through unprocessed
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto& processors = m_processors[static_cast<size_t>(ch)];
+        if (!m_parametersByValue[ch] && !processors.highPass && !processors.lowPass && !processors.gain && (activeChannels == nullptr || activeChannels[ch]))
+            FloatVectorOperations::copy(outputs[ch], inputs[ch], numSamples);
+    }
+}
+
+void ChannelStripEngine::skipChannel(int channel, float* output, int numSamples) noexcept
+{
+    m_hpS1[channel] = m_hpS2[channel] = m_lpS1[channel] = m_lpS2[channel] = 0.0f;
+    FloatVectorOperations::clear(output, numSamples);
+}
+
+void ChannelStripEngine::processScalar(int channel, const float* input, float* output, int numSamples) noexcept
+{
+    // the state lives in registers for the whole block and is written back once
+    auto hpS1 = m_hpS1[channel], hpS2 = m_hpS2[channel], hpG = m_hpG[channel], hpH = m_hpH[channel];
+    auto lpS1 = m_lpS1[channel], lpS2 = m_lpS2[channel], lpG = m_lpG[channel], lpH = m_lpH[channel];
+    auto hpAmount = m_hpAmount[channel], hpAmountStep = m_hpAmountStep[channel];
+    auto lpAmount = m_lpAmount[channel], lpAmountStep = m_lpAmountStep[channel];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto x = input[i];
+
+        auto hpYHP = hpH * (x - hpS1 * (hpG + SVF_R2) - hpS2);
+        auto hpYBP = hpYHP * hpG + hpS1;
+        hpS1 = hpYHP * hpG + hpYBP;
+        auto hpYLP = hpYBP * hpG + hpS2;
+        hpS2 = hpYBP * hpG + hpYLP;
+
+        auto lpYHP = lpH * (x - lpS1 * (lpG + SVF_R2) - lpS2);
+        auto lpYBP = lpYHP * lpG + lpS1;
+        lpS1 = lpYHP * lpG + lpYBP;
+        auto lpYLP = lpYBP * lpG + lpS2;
+        lpS2 = lpYBP * lpG + lpYLP;
+
+        // both filters are summed at the gain stage, as the graph connections do
+        output[i] = hpAmount * hpYHP + lpAmount * lpYLP;
+        hpAmount += hpAmountStep;
+        lpAmount += lpAmountStep;
+    }
+
+    m_hpAmount[channel] = hpAmount;
+    m_lpAmount[channel] = lpAmount;
+    m_hpS1[channel] = hpS1;
+    m_hpS2[channel] = hpS2;
+    m_lpS1[channel] = lpS1;
+    m_lpS2[channel] = lpS2;
+}
+
+void ChannelStripEngine::processVectorised(int firstChannel, const float* const* inputs, float* const* outputs, int numChannels, int numSamples) noexcept
+{
+    auto numLanes = getNumLanes();
+
+    // lanes beyond the last channel run on silence and their output is dropped
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        auto ch = firstChannel + lane;
+        m_groupInputs[lane] = ch < numChannels ? inputs[ch] : m_silentChannel;
+        m_groupOutputs[lane] = ch < numChannels ? outputs[ch] : m_discardChannel;
+    }
+
+    AudioDataConverters::interleaveSamples(m_groupInputs.get(), m_interleavedInput, numSamples, numLanes);
+
+    // same recursion as processScalar, each lane being one channel
+    auto hpS1 = FloatVector::fromRawArray(m_hpS1 + firstChannel), hpS2 = FloatVector::fromRawArray(m_hpS2 + firstChannel);
+    auto hpG = FloatVector::fromRawArray(m_hpG + firstChannel), hpH = FloatVector::fromRawArray(m_hpH + firstChannel);
+    auto lpS1 = FloatVector::fromRawArray(m_lpS1 + firstChannel), lpS2 = FloatVector::fromRawArray(m_lpS2 + firstChannel);
+    auto lpG = FloatVector::fromRawArray(m_lpG + firstChannel), lpH = FloatVector::fromRawArray(m_lpH + firstChannel);
+    auto hpAmount = FloatVector::fromRawArray(m_hpAmount + firstChannel), hpAmountStep = FloatVector::fromRawArray(m_hpAmountStep + firstChannel);
+    auto lpAmount = FloatVector::fromRawArray(m_lpAmount + firstChannel), lpAmountStep = FloatVector::fromRawArray(m_lpAmountStep + firstChannel);
+    auto hpGR2 = hpG + FloatVector::expand(SVF_R2);
+    auto lpGR2 = lpG + FloatVector::expand(SVF_R2);
+
+    auto input = m_interleavedInput;
+    auto output = m_interleavedOutput;
+    for (int i = 0; i < numSamples; ++i, input += numLanes, output += numLanes)
+    {
+        auto x = FloatVector::fromRawArray(input);
+
+        auto hpYHP = hpH * (x - hpS1 * hpGR2 - hpS2);
+        auto hpYBP = hpYHP * hpG + hpS1;
+        hpS1 = hpYHP * hpG + hpYBP;
+        auto hpYLP = hpYBP * hpG + hpS2;
+        hpS2 = hpYBP * hpG + hpYLP;
+
+        auto lpYHP = lpH * (x - lpS1 * lpGR2 - lpS2);
+        auto lpYBP = lpYHP * lpG + lpS1;
+        lpS1 = lpYHP * lpG + lpYBP;
+        auto lpYLP = lpYBP * lpG + lpS2;
+        lpS2 = lpYBP * lpG + lpYLP;
+
+        (hpAmount * hpYHP + lpAmount * lpYLP).copyToRawArray(output);
+        hpAmount += hpAmountStep;
+        lpAmount += lpAmountStep;
+    }
+
+    hpAmount.copyToRawArray(m_hpAmount + firstChannel);
+    lpAmount.copyToRawArray(m_lpAmount + firstChannel);
+
+    hpS1.copyToRawArray(m_hpS1 + firstChannel);
+    hpS2.copyToRawArray(m_hpS2 + firstChannel);
+    lpS1.copyToRawArray(m_lpS1 + firstChannel);
+    lpS2.copyToRawArray(m_lpS2 + firstChannel);
+
+    AudioDataConverters::deinterleaveSamples(m_interleavedOutput, m_groupOutputs.get(), numSamples, numLanes);
+}
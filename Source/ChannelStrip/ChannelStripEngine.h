@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    ChannelStripEngine.h
+    Created: 17 Oct 2026 2:47:55pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "ChannelStripProcessor.h"
+
+#include "../Engine/ScratchArena.h"
+
+//==============================================================================
+/*
+    Flat alternative to running one AudioProcessorGraph per channel strip.
+    The engine owns the highpass / lowpass / gain state of all channels in
+    contiguous structure-of-arrays storage and processes every channel in one
+    call with the same topology the graphs use (HP || LP -> Gain).
+
+    Parameters are still owned by the ChannelStripProcessorBase instances of
+    each strip (that the editors are bound to), the engine only reads their
+    current values once per block (parameter events due within a block are
+    applied at its start). Cutoffs follow them smoothed from block to
+    block, gains are additionally ramped per sample within the block.
+
+    Channels are processed in groups of one SIMD register width (4 floats for
+    SSE/NEON, 8 for AVX), each lane running the filter recursion of one channel.
+    The scalar kernel is kept as reference and can be selected instead.
+*/
+class ChannelStripEngine
+{
+public:
+    using FloatVector = dsp::SIMDRegister<float>;
+
+    struct ChannelProcessors
+    {
+        ChannelStripProcessorBase* highPass{ nullptr };
+        ChannelStripProcessorBase* lowPass{ nullptr };
+        ChannelStripProcessorBase* gain{ nullptr };
+    };
+
+    /** Plain parameter values of one strip, for channels whose processors live in another process. */
+    struct ChannelParameters
+    {
+        float highPassCutoff{ 0.0f };
+        float highPassGain{ 0.0f };
+        float lowPassCutoff{ 0.0f };
+        float lowPassGain{ 0.0f };
+        float gain{ 1.0f };
+    };
+
+    //==============================================================================
+    ChannelStripEngine();
+    ~ChannelStripEngine();
+
+    static size_t getScratchSize(int maxBlockSize) noexcept;
+    void prepare(double sampleRate, int maxChannels, int maxBlockSize);
+    void reset();
+    /** Audio thread only, before beginBlock. Clears the state of a channel taking over from another path,
+        which starts right at its current parameter values, gains included. */
+    void resetChannel(int channel) noexcept;
+
+    void setChannelProcessors(int channel, const ChannelProcessors& processors);
+    /** Drives the channel by the given values instead of processors, picked up with the next block. */
+    void setChannelParameters(int channel, const ChannelParameters& parameters) noexcept;
+    static ChannelParameters getChannelParameters(const ChannelProcessors& processors) noexcept;
+    /** Audio thread only. Sets the values as the processors' targets, as changing their parameters would. */
+    static void setChannelTargets(const ChannelProcessors& processors, const ChannelParameters& parameters) noexcept;
+    /** Applies the parameter events of the processors due within the block, all at its start, as the engine picks up parameters once per block. */
+    static void applyParameterEvents(const ChannelProcessors& processors, int numSamples) noexcept;
+    int getMaxChannels() const noexcept { return m_maxChannels; };
+
+    void setVectorisationEnabled(bool enabled) noexcept { m_vectorisationEnabled = enabled; };
+    bool isVectorisationEnabled() const noexcept { return m_vectorisationEnabled.load(); };
+    static constexpr int getNumLanes() noexcept { return static_cast<int>(FloatVector::SIMDNumElements); };
+
+    //==============================================================================
+    void process(const float* const* inputs, float* const* outputs, int numChannels, int numSamples, ScratchArena& scratch, const bool* activeChannels = nullptr) noexcept;
+
+    /** Same as process(), split up to be able to process a block in several consecutive ranges.
+        Parameters are only picked up in beginBlock, so the result does not depend on how the block is split.
+        Channels flagged inactive are not processed, they output zeros and have their state cleared. */
+    void beginBlock(int numChannels, int numSamples) noexcept;
+    void processRange(const float* const* inputs, float* const* outputs, int numChannels, int numSamples, ScratchArena& scratch, const bool* activeChannels = nullptr) noexcept;
+
+    /** The TPT filter coefficient tan(pi * cutoff / sampleRate), with the cutoff kept in the range the filter is stable for. */
+    static float calculateCoefficientG(float cutoff, double sampleRate) noexcept;
+
+private:
+    void updateParameters(int channel, float smoothing, int numSamples) noexcept;
+    static void updateCoefficientH(float* g, float* h, int channel, float targetG, float smoothing) noexcept;
+
+    void skipChannel(int channel, float* output, int numSamples) noexcept;
+    void processScalar(int channel, const float* input, float* output, int numSamples) noexcept;
+    void processVectorised(int firstChannel, const float* const* inputs, float* const* outputs, int numChannels, int numSamples) noexcept;
+
+    //==============================================================================
+    double  m_sampleRate{ 48000.0 };
+    int     m_maxChannels{ 0 };
+    int     m_paddedChannels{ 0 };
+    int     m_maxBlockSize{ 0 };
+
+    std::atomic<bool>   m_vectorisationEnabled{ true };
+
+    std::vector<ChannelProcessors>  m_processors;
+    std::vector<ChannelParameters>  m_parameters;
+    HeapBlock<bool>                 m_parametersByValue;
+
+    // state variable filter (TPT) state and coefficients, one entry per channel (padded to full registers).
+    // All arrays point into one SIMD aligned pool, so both kernels work on the same state.
+    // The amounts are the filter gains times the strip gain, ramped by their step per sample.
+    HeapBlock<float>    m_statePool;
+    float*  m_hpS1{ nullptr }, * m_hpS2{ nullptr }, * m_hpG{ nullptr }, * m_hpH{ nullptr }, * m_hpCutoff{ nullptr }, * m_hpTargetG{ nullptr };
+    float*  m_lpS1{ nullptr }, * m_lpS2{ nullptr }, * m_lpG{ nullptr }, * m_lpH{ nullptr }, * m_lpCutoff{ nullptr }, * m_lpTargetG{ nullptr };
+    float*  m_hpAmount{ nullptr }, * m_hpAmountStep{ nullptr }, * m_lpAmount{ nullptr }, * m_lpAmountStep{ nullptr };
+
+    // interleaved scratch for one group of channels, plus dummy channels for the lanes of an incomplete group.
+    // Only valid during process(), they are checked out of the caller's scratch arena.
+    float*                  m_interleavedInput{ nullptr };
+    float*                  m_interleavedOutput{ nullptr };
+    float*                  m_silentChannel{ nullptr };
+    float*                  m_discardChannel{ nullptr };
+    HeapBlock<const float*> m_groupInputs;
+    HeapBlock<float*>       m_groupOutputs;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChannelStripEngine)
+};
@@ -27,6 +27,10 @@ void ChannelStripProcessorBase::prepareToPlay(double sampleRate, int samplesPerB
 	m_sampleRate = sampleRate;
 	m_samplesPerBlock = samplesPerBlock;
 
+	// the timeline starts over, events scheduled on the old one would be meaningless
+	m_parameterEvents.clear();
+	m_samplePosition = 0;
+
 	updateParameterValues();
 }
 
@@ -81,12 +85,46 @@ void ChannelStripProcessorBase::changeProgramName(int, const String&)
 {
 }
 
-void ChannelStripProcessorBase::getStateInformation(MemoryBlock&) 
+void ChannelStripProcessorBase::getStateInformation(MemoryBlock& destData)
 {
+	// magic, type, parameter count and the ranged value of each parameter, nothing else
+	MemoryOutputStream stream(destData, false);
+	stream.writeInt(static_cast<int>(stateMagic));
+	stream.writeByte(static_cast<char>(getType()));
+	stream.writeByte(static_cast<char>(getParameters().size()));
+	for (auto param : getParameters())
+	{
+		auto fParam = dynamic_cast<AudioParameterFloat*>(param);
+		stream.writeFloat(fParam ? fParam->get() : 0.0f);
+	}
 }
 
-void ChannelStripProcessorBase::setStateInformation(const void*, int)
+void ChannelStripProcessorBase::setStateInformation(const void* data, int sizeInBytes)
 {
+	MemoryInputStream stream(data, static_cast<size_t>(jmax(0, sizeInBytes)), false);
+	if (stream.getTotalLength() < 6 || static_cast<uint32>(stream.readInt()) != stateMagic)
+		return;
+
+	auto type = static_cast<int>(stream.readByte());
+	auto numParameters = static_cast<int>(static_cast<uint8>(stream.readByte()));
+	if (type != getType() || numParameters != getParameters().size() || stream.getNumBytesRemaining() < numParameters * static_cast<int64>(sizeof(float)))
+		return;
+
+	// a value that is not finite rejects the whole state, before any parameter was touched
+	std::vector<float> values(static_cast<size_t>(numParameters));
+	for (auto& value : values)
+	{
+		value = stream.readFloat();
+		if (!std::isfinite(value))
+			return;
+	}
+
+	for (int i = 0; i < numParameters; ++i)
+	{
+		auto fParam = dynamic_cast<AudioParameterFloat*>(getParameters()[i]);
+		if (fParam)
+			fParam->setValueNotifyingHost(fParam->convertTo0to1(fParam->getNormalisableRange().getRange().clipValue(values[static_cast<size_t>(i)])));
+	}
 }
 
 void ChannelStripProcessorBase::initParameters()
@@ -124,6 +162,78 @@ bool ChannelStripProcessorBase::hasEditor() const
 	return true;
 }
 
+void ChannelStripProcessorBase::processFilterSmoothed(dsp::StateVariableTPTFilter<float>& filter, SmoothedFrequency& frequency, dsp::AudioBlock<float>& block)
+{
+	// while the cutoff is moving, the coefficients follow it in short steps instead of once per block
+	static constexpr int smoothingStepSamples = 16;
+
+	auto numSamples = static_cast<int>(block.getNumSamples());
+	if (!frequency.isSmoothing())
+	{
+		if (filter.getCutoffFrequency() != frequency.getTargetValue())
+			filter.setCutoffFrequency(frequency.getTargetValue());
+
+		dsp::ProcessContextReplacing<float> context(block);
+		filter.process(context);
+		return;
+	}
+
+	for (int start = 0; start < numSamples; start += smoothingStepSamples)
+	{
+		auto stepSamples = jmin(smoothingStepSamples, numSamples - start);
+		filter.setCutoffFrequency(frequency.skip(stepSamples));
+
+		auto stepBlock = block.getSubBlock(static_cast<size_t>(start), static_cast<size_t>(stepSamples));
+		dsp::ProcessContextReplacing<float> context(stepBlock);
+		filter.process(context);
+	}
+}
+
+bool ChannelStripProcessorBase::postParameterEvent(const ParameterEvent& event) noexcept
+{
+	return m_parameterEvents.post(event);
+}
+
+bool ChannelStripProcessorBase::postParameterEventFromAudioThread(const ParameterEvent& event) noexcept
+{
+	return m_parameterEvents.postFromAudioThread(event);
+}
+
+AudioParameterFloat* ChannelStripProcessorBase::getTargetParameter(ParameterEvent::Target target) const noexcept
+{
+	// the filters have cutoff and gain, in that order, the gain processor only gain
+	auto const& parameters = getParameters();
+	if (parameters.isEmpty() || (target == ParameterEvent::PET_Frequency && parameters.size() < 2))
+		return nullptr;
+
+	auto parameterIndex = target == ParameterEvent::PET_Frequency ? 0 : parameters.size() - 1;
+	return dynamic_cast<AudioParameterFloat*>(parameters.getUnchecked(parameterIndex));
+}
+
+int ChannelStripProcessorBase::applyDueParameterEvents(int maxSamples) noexcept
+{
+	auto samplePosition = m_samplePosition.load();
+	while (auto event = m_parameterEvents.popDueEvent(samplePosition))
+		setParameterTarget(event->target, event->value);
+
+	return m_parameterEvents.getSamplesToNextEvent(samplePosition, maxSamples);
+}
+
+void ChannelStripProcessorBase::advanceSamplePosition(int numSamples) noexcept
+{
+	m_samplePosition += numSamples;
+}
+
+void ChannelStripProcessorBase::applyParameterEventsOfBlock(int numSamples) noexcept
+{
+	for (auto offset = 0; offset < numSamples;)
+	{
+		auto numSegmentSamples = applyDueParameterEvents(numSamples - offset);
+		advanceSamplePosition(numSegmentSamples);
+		offset += numSegmentSamples;
+	}
+}
+
 float ChannelStripProcessorBase::getMappedValue(AudioProcessorParameter* param)
 {
 	auto floatParam = dynamic_cast<AudioParameterFloat*>(param);
@@ -182,7 +292,7 @@ float GainProcessor::getFilterFequency()
 
 float GainProcessor::getFilterGain()
 {
-	return 1.0f;
+	return m_targetGain.load();
 }
 
 std::vector<ChannelStripProcessorBase::ProcessorParam> GainProcessor::getProcessorParams()
@@ -190,11 +300,37 @@ std::vector<ChannelStripProcessorBase::ProcessorParam> GainProcessor::getProcess
 	return std::vector<ChannelStripProcessorBase::ProcessorParam>{ { "gain", "Gain", 0.0f, 1.0f, 0.01f, 1.0f, 1.0f } };
 }
 
+void GainProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+	ChannelStripProcessorBase::prepareToPlay(sampleRate, samplesPerBlock);
+
+	// the only place the DSP objects are prepared, starting right at the current value
+	dsp::ProcessSpec spec{ m_sampleRate, static_cast<uint32> (m_samplesPerBlock), 1 };
+	m_gain.setGainLinear(m_targetGain.load());
+	m_gain.setRampDurationSeconds(getSmoothingSeconds());
+	m_gain.prepare(spec);
+}
+
 void GainProcessor::processBlock(AudioSampleBuffer& buffer, MidiBuffer&)
 {
 	dsp::AudioBlock<float> block(buffer);
-	dsp::ProcessContextReplacing<float> context(block);
-	m_gain.process(context);
+
+	// the block is split at the parameter events, so each one starts its ramp at the exact sample it is due
+	auto numSamples = buffer.getNumSamples();
+	for (auto offset = 0; offset < numSamples;)
+	{
+		auto numSegmentSamples = applyDueParameterEvents(numSamples - offset);
+
+		// parameter changes reach the DSP objects only here, ramped from where they are
+		m_gain.setGainLinear(m_targetGain.load());
+
+		auto segment = block.getSubBlock(static_cast<size_t>(offset), static_cast<size_t>(numSegmentSamples));
+		dsp::ProcessContextReplacing<float> context(segment);
+		m_gain.process(context);
+
+		advanceSamplePosition(numSegmentSamples);
+		offset += numSegmentSamples;
+	}
 }
 
 void GainProcessor::reset()
@@ -204,14 +340,12 @@ void GainProcessor::reset()
 
 void GainProcessor::parameterValueChanged(int parameterIndex, float newValue)
 {
+	// only the target is set here, on whichever thread changed the parameter
 	if (parameterIndex == m_IdToIdxMap.at("gain"))
 	{
-		m_gain.setGainLinear(newValue);
+		m_targetGain = newValue;
 
 		DBG_IF_DEBUG("GP new gain value:" + String(newValue));
-
-		dsp::ProcessSpec spec{ m_sampleRate, static_cast<uint32> (m_samplesPerBlock), 1 };
-		m_gain.prepare(spec);
 	}
 }
 
@@ -221,6 +355,12 @@ void GainProcessor::updateParameterValues()
 	parameterValueChanged(idx, getNormalizedValue(getParameters().getUnchecked(idx)));
 }
 
+void GainProcessor::setParameterTarget(ParameterEvent::Target target, float value) noexcept
+{
+	if (target == ParameterEvent::PET_Gain)
+		m_targetGain = value;
+}
+
 const String GainProcessor::getName() const 
 { 
 	return "Gain"; 
@@ -245,7 +385,7 @@ float HPFilterProcessor::getMagnitudeResponse(float freq)
 	float magnitude = 0.0;
 	float T = 1 / m_sampleRate;
 	
-	float wdCutoff = 2 * MathConstants<float>::pi * m_filter.getCutoffFrequency();
+	float wdCutoff = 2 * MathConstants<float>::pi * m_targetFrequency.load();
 
 	//Calculating pre-warped/analogue cutoff frequency to use in virtual analogue frequeny response calculations
 	float cutOff = (2 / T) * tan(wdCutoff * T / 2);
@@ -259,7 +399,7 @@ float HPFilterProcessor::getMagnitudeResponse(float freq)
 	 See Art Of VA Filter Design 3.8 Bilinear Transform Section */
 	magnitude = sValue / (sValue + cutOff);
 
-	magnitude = magnitude * m_gain.getGainLinear();
+	magnitude = magnitude * m_targetGain.load();
 
 	//Convert to db for log db response display
 	magnitude = Decibels::gainToDecibels(magnitude, getMinDecibels());
@@ -268,12 +408,12 @@ float HPFilterProcessor::getMagnitudeResponse(float freq)
 
 float HPFilterProcessor::getFilterFequency()
 {
-	return m_filter.getCutoffFrequency();
+	return m_targetFrequency.load();
 }
 
 float HPFilterProcessor::getFilterGain()
 {
-	return m_gain.getGainLinear();
+	return m_targetGain.load();
 }
 
 std::vector<ChannelStripProcessorBase::ProcessorParam> HPFilterProcessor::getProcessorParams()
@@ -281,12 +421,43 @@ std::vector<ChannelStripProcessorBase::ProcessorParam> HPFilterProcessor::getPro
 	return std::vector<ChannelStripProcessorBase::ProcessorParam>{ { "hpff", "Highpass freq.", 20.0f, 20000.0f, 1.0f, 1.0f, 20.0f }, { "hpfg", "Highpass gain", 0.0f, 1.0f, 0.01f, 1.0f, 1.0f } };
 }
 
+void HPFilterProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+	ChannelStripProcessorBase::prepareToPlay(sampleRate, samplesPerBlock);
+
+	// the only place the DSP objects are prepared, starting right at the current values
+	dsp::ProcessSpec spec{ m_sampleRate, static_cast<uint32> (m_samplesPerBlock), 1 };
+	m_filter.prepare(spec);
+	m_filter.setCutoffFrequency(m_targetFrequency.load());
+	m_frequency.reset(m_sampleRate, getSmoothingSeconds());
+	m_frequency.setCurrentAndTargetValue(m_targetFrequency.load());
+	m_gain.setGainLinear(m_targetGain.load());
+	m_gain.setRampDurationSeconds(getSmoothingSeconds());
+	m_gain.prepare(spec);
+}
+
 void HPFilterProcessor::processBlock(AudioSampleBuffer& buffer, MidiBuffer&)
 {
 	dsp::AudioBlock<float> block(buffer);
-	dsp::ProcessContextReplacing<float> context(block);
-	m_filter.process(context);
-	m_gain.process(context);
+
+	// the block is split at the parameter events, so each one starts its smoothing at the exact sample it is due
+	auto numSamples = buffer.getNumSamples();
+	for (auto offset = 0; offset < numSamples;)
+	{
+		auto numSegmentSamples = applyDueParameterEvents(numSamples - offset);
+
+		// parameter changes reach the DSP objects only here, smoothed from where they are
+		m_frequency.setTargetValue(m_targetFrequency.load());
+		m_gain.setGainLinear(m_targetGain.load());
+
+		auto segment = block.getSubBlock(static_cast<size_t>(offset), static_cast<size_t>(numSegmentSamples));
+		processFilterSmoothed(m_filter, m_frequency, segment);
+		dsp::ProcessContextReplacing<float> context(segment);
+		m_gain.process(context);
+
+		advanceSamplePosition(numSegmentSamples);
+		offset += numSegmentSamples;
+	}
 }
 
 void HPFilterProcessor::reset()
@@ -303,23 +474,18 @@ void HPFilterProcessor::parameterValueChanged(int parameterIndex, float newValue
 	auto max = fParam->getNormalisableRange().getRange().getEnd();
 	auto newRangedValue = jmap(jlimit(0.0f, 1.0f, newValue), min, max);
 
+	// only the targets are set here, on whichever thread changed the parameter
 	if (parameterIndex == m_IdToIdxMap.at("hpff"))
 	{
-		m_filter.setCutoffFrequency(newRangedValue);
+		m_targetFrequency = newRangedValue;
 
 		DBG_IF_DEBUG("HPFP new hpff value:" + String(newRangedValue));
-
-		dsp::ProcessSpec spec{ m_sampleRate, static_cast<uint32> (m_samplesPerBlock), 1 };
-		m_filter.prepare(spec);
 	}
 	else if (parameterIndex == m_IdToIdxMap.at("hpfg"))
 	{
-		m_gain.setGainLinear(newRangedValue);
+		m_targetGain = newRangedValue;
 
 		DBG_IF_DEBUG("HPFP new hpfg value:" + String(newRangedValue));
-
-		dsp::ProcessSpec spec{ m_sampleRate, static_cast<uint32> (m_samplesPerBlock), 1 };
-		m_gain.prepare(spec);
 	}
 }
 
@@ -331,6 +497,14 @@ void HPFilterProcessor::updateParameterValues()
 	parameterValueChanged(idx, getNormalizedValue(getParameters().getUnchecked(idx)));
 }
 
+void HPFilterProcessor::setParameterTarget(ParameterEvent::Target target, float value) noexcept
+{
+	if (target == ParameterEvent::PET_Frequency)
+		m_targetFrequency = value;
+	else if (target == ParameterEvent::PET_Gain)
+		m_targetGain = value;
+}
+
 const String HPFilterProcessor::getName() const
 { 
 	return "HighPass"; 
@@ -355,7 +529,7 @@ float LPFilterProcessor::getMagnitudeResponse(float freq)
 	float magnitude = 0.0;
 	float T = 1 / m_sampleRate;
 
-	float wdCutoff = 2 * MathConstants<float>::pi * m_filter.getCutoffFrequency();
+	float wdCutoff = 2 * MathConstants<float>::pi * m_targetFrequency.load();
 
 	//Calculating pre-warped/analogue cutoff frequency to use in virtual analogue frequeny response calculations
 	float cutOff = (2 / T) * tan(wdCutoff * T / 2);
@@ -370,7 +544,7 @@ float LPFilterProcessor::getMagnitudeResponse(float freq)
 	 See Art Of VA Filter Design 3.8 Bilinear Transform Section */
 	magnitude = cutOff / (sValue + cutOff);
 
-	magnitude = magnitude * m_gain.getGainLinear();
+	magnitude = magnitude * m_targetGain.load();
 
 	//Convert to db for log db response display
 	magnitude = Decibels::gainToDecibels(magnitude, getMinDecibels());
@@ -379,12 +553,12 @@ float LPFilterProcessor::getMagnitudeResponse(float freq)
 
 float LPFilterProcessor::getFilterFequency()
 {
-	return m_filter.getCutoffFrequency();
+	return m_targetFrequency.load();
 }
 
 float LPFilterProcessor::getFilterGain()
 {
-	return m_gain.getGainLinear();
+	return m_targetGain.load();
 }
 
 std::vector<ChannelStripProcessorBase::ProcessorParam> LPFilterProcessor::getProcessorParams()
@@ -392,12 +566,43 @@ std::vector<ChannelStripProcessorBase::ProcessorParam> LPFilterProcessor::getPro
 	return std::vector<ChannelStripProcessorBase::ProcessorParam>{ { "lpff", "Lowpass freq.", 20.0f, 20000.0f, 1.0f, 1.0f, 20000.0f }, { "lpfg", "Lowpass gain", 0.0f, 1.0f, 0.01f, 1.0f, 1.0f } };
 }
 
+void LPFilterProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+	ChannelStripProcessorBase::prepareToPlay(sampleRate, samplesPerBlock);
+
+	// the only place the DSP objects are prepared, starting right at the current values
+	dsp::ProcessSpec spec{ m_sampleRate, static_cast<uint32> (m_samplesPerBlock), 1 };
+	m_filter.prepare(spec);
+	m_filter.setCutoffFrequency(m_targetFrequency.load());
+	m_frequency.reset(m_sampleRate, getSmoothingSeconds());
+	m_frequency.setCurrentAndTargetValue(m_targetFrequency.load());
+	m_gain.setGainLinear(m_targetGain.load());
+	m_gain.setRampDurationSeconds(getSmoothingSeconds());
+	m_gain.prepare(spec);
+}
+
 void LPFilterProcessor::processBlock(AudioSampleBuffer& buffer, MidiBuffer&)
 {
 	dsp::AudioBlock<float> block(buffer);
-	dsp::ProcessContextReplacing<float> context(block);
-	m_filter.process(context);
-	m_gain.process(context);
+
+	// the block is split at the parameter events, so each one starts its smoothing at the exact sample it is due
+	auto numSamples = buffer.getNumSamples();
+	for (auto offset = 0; offset < numSamples;)
+	{
+		auto numSegmentSamples = applyDueParameterEvents(numSamples - offset);
+
+		// parameter changes reach the DSP objects only here, smoothed from where they are
+		m_frequency.setTargetValue(m_targetFrequency.load());
+		m_gain.setGainLinear(m_targetGain.load());
+
+		auto segment = block.getSubBlock(static_cast<size_t>(offset), static_cast<size_t>(numSegmentSamples));
+		processFilterSmoothed(m_filter, m_frequency, segment);
+		dsp::ProcessContextReplacing<float> context(segment);
+		m_gain.process(context);
+
+		advanceSamplePosition(numSegmentSamples);
+		offset += numSegmentSamples;
+	}
 }
 
 void LPFilterProcessor::reset()
@@ -414,23 +619,18 @@ void LPFilterProcessor::parameterValueChanged(int parameterIndex, float newValue
 	auto max = fParam->getNormalisableRange().getRange().getEnd();
 	auto newRangedValue = jmap(jlimit(0.0f, 1.0f, newValue), min, max);
 
+	// only the targets are set here, on whichever thread changed the parameter
 	if (parameterIndex == m_IdToIdxMap.at("lpff"))
 	{
-		m_filter.setCutoffFrequency(newRangedValue);
+		m_targetFrequency = newRangedValue;
 
 		DBG_IF_DEBUG("LPFP new lpff value:" + String(newRangedValue));
-
-		dsp::ProcessSpec spec{ m_sampleRate, static_cast<uint32> (m_samplesPerBlock), 1 };
-		m_filter.prepare(spec);
 	}
 	else if (parameterIndex == m_IdToIdxMap.at("lpfg"))
 	{
-		m_gain.setGainLinear(newRangedValue);
+		m_targetGain = newRangedValue;
 
 		DBG_IF_DEBUG("LPFP new lpfg value:" + String(newRangedValue));
-
-		dsp::ProcessSpec spec{ m_sampleRate, static_cast<uint32> (m_samplesPerBlock), 1 };
-		m_gain.prepare(spec);
 	}
 }
 
@@ -442,6 +642,14 @@ void LPFilterProcessor::updateParameterValues()
 	parameterValueChanged(idx, getNormalizedValue(getParameters().getUnchecked(idx)));
 }
 
+void LPFilterProcessor::setParameterTarget(ParameterEvent::Target target, float value) noexcept
+{
+	if (target == ParameterEvent::PET_Frequency)
+		m_targetFrequency = value;
+	else if (target == ParameterEvent::PET_Gain)
+		m_targetGain = value;
+}
+
 const String LPFilterProcessor::getName() const 
 { 
 	return "LowPass"; 
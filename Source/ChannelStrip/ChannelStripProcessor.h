@@ -12,6 +12,8 @@
 
 #include <JuceHeader.h>
 
+#include "../Engine/ParameterEventQueue.h"
+
 //==============================================================================
 class ChannelStripProcessorBase  : public AudioProcessor, public AudioProcessorParameter::Listener
 {
@@ -79,8 +81,9 @@ public:
     void changeProgramName(int, const String&) override;
 
     //==============================================================================
-    void getStateInformation(MemoryBlock&) override;
-    void setStateInformation(const void*, int) override;
+    /** Compact binary state, the values of all parameters of the processor. */
+    void getStateInformation(MemoryBlock& destData) override;
+    void setStateInformation(const void* data, int sizeInBytes) override;
 
     //==============================================================================
     AudioProcessorEditor* createEditor() override;
@@ -93,14 +96,44 @@ public:
     static float getMappedValue(AudioProcessorParameter* param);
     static float getNormalizedValue(AudioProcessorParameter* param);
     static float getMinDecibels() { return -100.0f; };
+    /** Time cutoff and gain changes are smoothed over, wherever the strips are processed. */
+    static double getSmoothingSeconds() { return 0.05; };
+
+    //==============================================================================
+    /** Any thread. Schedules a change at a position of the timeline given by getSamplePosition(), false if the queue is full. */
+    bool postParameterEvent(const ParameterEvent& event) noexcept;
+    /** Audio thread only. As postParameterEvent(), without serialising with the other threads posting events. */
+    bool postParameterEventFromAudioThread(const ParameterEvent& event) noexcept;
+    /** Position of the next sample the processor is going to process, counted from its last prepareToPlay. */
+    int64 getSamplePosition() const noexcept { return m_samplePosition.load(); };
+    /** The parameter an event target of the processor belongs to, nullptr if it has none (the gain processor has no frequency). */
+    AudioParameterFloat* getTargetParameter(ParameterEvent::Target target) const noexcept;
+
+    /** Audio thread only. Applies the events due at the current position and returns the number of samples
+        that can be processed before the next one is due, at most maxSamples. To be followed by advanceSamplePosition(). */
+    int applyDueParameterEvents(int maxSamples) noexcept;
+    void advanceSamplePosition(int numSamples) noexcept;
+    /** Audio thread only. Applies the events due within the next numSamples at once and advances, for block-wise processing. */
+    void applyParameterEventsOfBlock(int numSamples) noexcept;
+
+    /** Audio thread only. Sets the target of the smoothing, as a change of the parameter would. */
+    virtual void setParameterTarget(ParameterEvent::Target target, float value) noexcept = 0;
 
 protected:
+    static constexpr uint32 stateMagic = 0x50435331; // "PCS1"
+
+    using SmoothedFrequency = SmoothedValue<float, ValueSmoothingTypes::Multiplicative>;
+    static void processFilterSmoothed(dsp::StateVariableTPTFilter<float>& filter, SmoothedFrequency& frequency, dsp::AudioBlock<float>& block);
+
     std::map<String, int> m_IdToIdxMap;
 
     double m_sampleRate{ 48000.0f };
     int m_samplesPerBlock{ 480 };
 
 private:
+    ParameterEventQueue m_parameterEvents;
+    std::atomic<int64> m_samplePosition{ 0 };
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChannelStripProcessorBase)
 };
@@ -117,18 +150,24 @@ public:
     float getFilterGain() override;
 
     //==============================================================================
+    void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void processBlock (AudioSampleBuffer& buffer, MidiBuffer&) override;
     void reset() override;
 
     //==============================================================================
     void parameterValueChanged(int parameterIndex, float newValue) override;
     void updateParameterValues() override;
+    void setParameterTarget(ParameterEvent::Target target, float value) noexcept override;
 
     const String getName() const override;
 
     std::vector<ChannelStripProcessorBase::ProcessorParam> getProcessorParams() override;
 
 private:
+    // written by any thread, picked up by processBlock
+    std::atomic<float> m_targetGain{ 1.0f };
+
+    // audio thread only
     dsp::Gain<float> m_gain;
 };
 
@@ -144,20 +183,28 @@ public:
     float getFilterGain() override;
 
     //==============================================================================
+    void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void processBlock(AudioSampleBuffer& buffer, MidiBuffer&) override;
     void reset() override;
 
     //==============================================================================
     void parameterValueChanged(int parameterIndex, float newValue) override;
     void updateParameterValues() override;
+    void setParameterTarget(ParameterEvent::Target target, float value) noexcept override;
 
     const String getName() const override;
 
     std::vector<ChannelStripProcessorBase::ProcessorParam> getProcessorParams() override;
 
 private:
+    // written by any thread, picked up by processBlock
+    std::atomic<float> m_targetFrequency{ 20.0f };
+    std::atomic<float> m_targetGain{ 1.0f };
+
+    // audio thread only
     dsp::StateVariableTPTFilter<float> m_filter;
     dsp::Gain<float> m_gain;
+    SmoothedFrequency m_frequency;
 };
 
 //==============================================================================
@@ -172,18 +219,26 @@ public:
     float getFilterGain() override;
 
     //==============================================================================
+    void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void processBlock(AudioSampleBuffer& buffer, MidiBuffer&) override;
     void reset() override;
 
     //==============================================================================
     void parameterValueChanged(int parameterIndex, float newValue) override;
     void updateParameterValues() override;
+    void setParameterTarget(ParameterEvent::Target target, float value) noexcept override;
 
     const String getName() const override;
 
     std::vector<ChannelStripProcessorBase::ProcessorParam> getProcessorParams() override;
 
 private:
+    // written by any thread, picked up by processBlock
+    std::atomic<float> m_targetFrequency{ 20000.0f };
+    std::atomic<float> m_targetGain{ 1.0f };
+
+    // audio thread only
     dsp::StateVariableTPTFilter<float> m_filter;
     dsp::Gain<float> m_gain;
+    SmoothedFrequency m_frequency;
 };
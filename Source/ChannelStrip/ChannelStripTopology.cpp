@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    ChannelStripTopology.cpp
+    Created: 18 Oct 2026 3:05:14am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "ChannelStripTopology.h"
+
+ChannelStripTopology ChannelStripTopology::getDefault()
+{
+    ChannelStripTopology topology;
+    topology.stages.push_back({ ChannelStripProcessorBase::CSPT_HighPass, ChannelStripProcessorBase::CSPT_LowPass });
+    topology.stages.push_back({ ChannelStripProcessorBase::CSPT_Gain });
+    return topology;
+}
+
+bool ChannelStripTopology::contains(ProcessorType type) const
+{
+    return getStageIndex(type) >= 0;
+}
+
+int ChannelStripTopology::getStageIndex(ProcessorType type) const
+{
+    for (auto i = 0; i < static_cast<int>(stages.size()); ++i)
+        if (std::find(stages[static_cast<size_t>(i)].begin(), stages[static_cast<size_t>(i)].end(), type) != stages[static_cast<size_t>(i)].end())
+            return i;
+
+    return -1;
+}
+
+int ChannelStripTopology::getMaxStageWidth() const
+{
+    auto width = 0;
+    for (auto const& stage : stages)
+        width = jmax(width, static_cast<int>(stage.size()));
+
+    return width;
+}
+
+bool ChannelStripTopology::isEngineCompatible() const
+{
+    // a filter stage with highpass and / or lowpass, optionally followed by gain
+    if (stages.empty() || stages.size() > 2)
+        return false;
+
+    for (auto type : stages.front())
+        if (type != ChannelStripProcessorBase::CSPT_HighPass && type != ChannelStripProcessorBase::CSPT_LowPass)
+            return false;
+
+    return stages.size() == 1 || stages.back() == Stage{ ChannelStripProcessorBase::CSPT_Gain };
+}
+
+bool ChannelStripTopology::insertProcessor(ProcessorType type, int stageIndex, bool parallel)
+{
+    if (type >= ChannelStripProcessorBase::CSPT_Invalid || contains(type))
+        return false;
+
+    stageIndex = jlimit(0, static_cast<int>(stages.size()), stageIndex);
+    if (parallel && stageIndex < static_cast<int>(stages.size()))
+        stages[static_cast<size_t>(stageIndex)].push_back(type);
+    else
+        stages.insert(stages.begin() + stageIndex, Stage{ type });
+
+    return true;
+}
+
+bool ChannelStripTopology::removeProcessor(ProcessorType type)
+{
+    auto stageIndex = getStageIndex(type);
+    if (stageIndex < 0)
+        return false;
+
+    auto& stage = stages[static_cast<size_t>(stageIndex)];
+    stage.erase(std::remove(stage.begin(), stage.end(), type), stage.end());
+    if (stage.empty())
+        stages.erase(stages.begin() + stageIndex);
+
+    return true;
+}
+
+bool ChannelStripTopology::moveProcessor(ProcessorType type, bool later)
+{
+    auto stageIndex = getStageIndex(type);
+    if (stageIndex < 0)
+        return false;
+
+    if (stages[static_cast<size_t>(stageIndex)].size() > 1)
+    {
+        removeProcessor(type);
+        return insertProcessor(type, later ? stageIndex + 1 : stageIndex, false);
+    }
+
+    auto otherIndex = later ? stageIndex + 1 : stageIndex - 1;
+    if (!isPositiveAndBelow(otherIndex, static_cast<int>(stages.size())))
+        return false;
+
+    std::swap(stages[static_cast<size_t>(stageIndex)], stages[static_cast<size_t>(otherIndex)]);
+    return true;
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    ChannelStripTopology.h
+    Created: 18 Oct 2026 3:05:14am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "ChannelStripProcessor.h"
+
+//==============================================================================
+/*
+    The order a strip runs its processors in, as edited by the user.
+    Stages are processed one after the other, the processors within a stage in
+    parallel (each fed with the stage input, their outputs summed up).
+    Every processor type appears at most once, processors not contained are
+    bypassed but keep their parameters.
+*/
+struct ChannelStripTopology
+{
+    using ProcessorType = ChannelStripProcessorBase::ChannelStripProcessorType;
+    using Stage = std::vector<ProcessorType>;
+
+    std::vector<Stage>  stages;
+
+    /** HP || LP -> Gain, what strips are created with. */
+    static ChannelStripTopology getDefault();
+
+    //==============================================================================
+    bool contains(ProcessorType type) const;
+    int getStageIndex(ProcessorType type) const;
+    int getMaxStageWidth() const;
+    /** Whether the flat strip engine, which always runs HP || LP -> Gain, can process it by leaving out processors. */
+    bool isEngineCompatible() const;
+
+    //==============================================================================
+    /** Adds the processor to the given stage, or as a new stage before it if not parallel. */
+    bool insertProcessor(ProcessorType type, int stageIndex, bool parallel);
+    bool removeProcessor(ProcessorType type);
+    /** A processor sharing its stage is taken out into a stage of its own before or after it,
+        otherwise its stage swaps places with the neighbouring one. */
+    bool moveProcessor(ProcessorType type, bool later);
+
+    bool operator==(const ChannelStripTopology& other) const { return stages == other.stages; };
+    bool operator!=(const ChannelStripTopology& other) const { return stages != other.stages; };
+};
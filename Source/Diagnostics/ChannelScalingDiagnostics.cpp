@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    ChannelScalingDiagnostics.cpp
+    Created: 18 Oct 2026 6:08:43am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "DiagnosticChecks.h"
+#include "DiagnosticsAudioDevice.h"
+
+#include "../Analyser/AnalyserComponent.h"
+#include "../ChannelStrip/ChannelStripEngine.h"
+#include "../Engine/ChannelActivityGate.h"
+#include "../Engine/ChannelLevelMeter.h"
+#include "../Routing/RoutingMatrixMixer.h"
+
+static constexpr double sampleRate = 48000.0;
+static constexpr int blockSize = 256;
+static constexpr int numBlocks = 500;
+
+bool runChannelScalingCheck(DiagnosticsReport& report)
+{
+    auto blockDurationMs = 1000.0 * blockSize / sampleRate;
+    report.log("routing, strip engine, activity gate, metering and analyser per block of " + String(blockSize) + " samples ("
+        + String(blockDurationMs, 2) + " ms), every output mixed from two inputs");
+
+    for (auto numChannels : { 16, 64, 128, 256 })
+    {
+        DiagnosticsAudioDevice device(numChannels, sampleRate, blockSize);
+
+        AudioBuffer<float> inputs(numChannels, blockSize);
+        AudioBuffer<float> routed(numChannels, blockSize);
+        AudioBuffer<float> outputs(numChannels, blockSize);
+        Random random(numChannels);
+        for (auto ch = 0; ch < numChannels; ++ch)
+            for (auto i = 0; i < blockSize; ++i)
+                inputs.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        RoutingMatrix matrix(numChannels, numChannels, 1);
+        for (auto out = 0; out < numChannels; ++out)
+        {
+            matrix.setGain(out, out, 0.5f);
+            matrix.setGain((out + 1) % numChannels, out, 0.5f);
+        }
+        matrix.updateActiveCrosspoints();
+
+        RoutingMatrixMixer mixer;
+        mixer.prepare(numChannels, numChannels, blockSize);
+        ChannelActivityGate gate;
+        gate.prepare(numChannels);
+        ChannelLevelMeter meter;
+        meter.prepare(numChannels);
+
+        ChannelStripEngine engine;
+        ScratchArena scratch;
+        engine.prepare(sampleRate, numChannels, blockSize);
+        scratch.prepare(ChannelStripEngine::getScratchSize(blockSize));
+        ChannelStripEngine::ChannelParameters parameters;
+        parameters.highPassCutoff = 80.0f;
+        parameters.highPassGain = 1.0f;
+        parameters.lowPassCutoff = 120.0f;
+        parameters.lowPassGain = 0.5f;
+        for (auto ch = 0; ch < numChannels; ++ch)
+            engine.setChannelParameters(ch, parameters);
+
+        std::unique_ptr<AnalyserComponent> analyser;
+        {
+            const MessageManagerLock lock(Thread::getCurrentThread());
+            if (!lock.lockWasGained())
+                return false;
+
+            analyser = std::make_unique<AnalyserComponent>();
+            analyser->audioDeviceAboutToStart(&device);
+        }
+
+        auto processRouting = [&] { mixer.process(matrix, inputs.getArrayOfReadPointers(), numChannels, routed.getArrayOfWritePointers(), numChannels, blockSize); };
+        auto processStrips = [&]
+        {
+            auto activeChannels = gate.beginRange(routed.getArrayOfReadPointers(), numChannels, blockSize);
+            engine.process(routed.getArrayOfReadPointers(), outputs.getArrayOfWritePointers(), numChannels, blockSize, scratch, activeChannels);
+            gate.endRange(outputs.getArrayOfReadPointers(), numChannels, blockSize);
+        };
+        auto processMetering = [&]
+        {
+            meter.beginBlock(numChannels);
+            meter.accumulate(outputs.getArrayOfReadPointers(), blockSize);
+            meter.endBlock();
+            analyser->audioDeviceIOCallback(outputs.getArrayOfReadPointers(), numChannels, nullptr, 0, blockSize);
+        };
+
+        auto routing = DiagnosticsReport::measure(numBlocks, processRouting);
+        auto strips = DiagnosticsReport::measure(numBlocks, processStrips);
+        auto metering = DiagnosticsReport::measure(numBlocks, processMetering);
+        auto total = DiagnosticsReport::measure(numBlocks, [&] { processRouting(); processStrips(); processMetering(); });
+
+        report.log(String(numChannels).paddedLeft(' ', 3) + " channels: routing " + String(routing.medianMs, 3) + " ms, strips " + String(strips.medianMs, 3)
+            + " ms, metering and analyser " + String(metering.medianMs, 3) + " ms (medians)");
+        report.log("              whole block " + DiagnosticsReport::toString(total) + ", " + String(100.0 * total.medianMs / blockDurationMs, 1) + " % of the block duration");
+
+        auto finite = true;
+        for (auto ch = 0; ch < numChannels; ++ch)
+            finite = finite && std::isfinite(meter.getPeakLevel(ch)) && meter.getPeakLevel(ch) > 0.0f;
+        report.expect(finite, String(numChannels) + " channels: every output carries signal");
+
+        // how much of the block it takes depends on the machine, it is only reported
+        if (numChannels == 256)
+            report.log(String("              256 channels ") + (total.medianMs < blockDurationMs ? "are" : "are NOT") + " processed within the block duration");
+
+        const MessageManagerLock lock;
+        analyser->audioDeviceStopped();
+        analyser.reset();
+    }
+
+    return report.getNumCheckFailures() == 0;
+}
@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    DiagnosticChecks.h
+    Created: 18 Oct 2026 4:05:52am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DiagnosticsReport.h"
+
+// The checks run by EngineDiagnostics, each returns false if any of its expectations failed.
+// Timings depend on the machine and are only reported, expectations are about results.
+
+/** Strip processing through the realtime worker pool against the device thread alone, 2 to 64 outputs. */
+bool runWorkerPoolScalingCheck(DiagnosticsReport& report);
+
+/** The SIMD strip filter kernel against the scalar one and dsp::StateVariableTPTFilter, for 1 to 3 register widths of channels. */
+bool runFilterKernelCheck(DiagnosticsReport& report);
+
+/** The compiled strip chain against the strip's processor graph, time per block and output. */
+bool runStripChainCheck(DiagnosticsReport& report);
+
+/** The flat per channel audio path from routing to the analyser at 16, 64, 128 and 256 channels. */
+bool runChannelScalingCheck(DiagnosticsReport& report);
+
+/** Strips processed by worker processes, driven by the diagnostics device at its pace and back to back. */
+bool runStripShardCheck(DiagnosticsReport& report);
+
+/** Rig snapshots saved and loaded at 1 to 256 channels, truncated or corrupted data and processor states. */
+bool runRigStateCheck(DiagnosticsReport& report);
+
+/** 10000 OSC messages per second over UDP on 127.0.0.1 into the remote control, callback durations with and without them. */
+bool runOSCLoadCheck(DiagnosticsReport& report);
+
+/** 320 MIDI controllers mapped to strip parameters, their changes placed at the offsets they arrived at within a block. */
+bool runMidiControllerCheck(DiagnosticsReport& report);
+
+/** The JACK client mode against a running server, e.g. 'jackd -d dummy'. Only run when named, as it needs the server. */
+bool runJackClientCheck(DiagnosticsReport& report);
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    DiagnosticStrips.cpp
+    Created: 18 Oct 2026 5:34:20am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "DiagnosticStrips.h"
+
+DiagnosticStrips::DiagnosticStrips()
+{
+}
+
+DiagnosticStrips::~DiagnosticStrips()
+{
+    const MessageManagerLock lock;
+    for (auto strip : m_strips)
+        strip->audioDeviceStopped();
+    m_strips.clear();
+}
+
+bool DiagnosticStrips::create(int numStrips, AudioIODevice& device, int maxBlockSize)
+{
+    const MessageManagerLock lock(Thread::getCurrentThread());
+    if (!lock.lockWasGained())
+        return false;
+
+    for (auto i = 0; i < numStrips; ++i)
+    {
+        auto strip = m_strips.add(new ChannelStripComponent());
+        strip->setMaximumBlockSize(maxBlockSize);
+        strip->audioDeviceAboutToStart(&device);
+    }
+
+    return true;
+}
+
+bool DiagnosticStrips::setCompiledChainEnabled(bool enabled)
+{
+    const MessageManagerLock lock(Thread::getCurrentThread());
+    if (!lock.lockWasGained())
+        return false;
+
+    for (auto strip : m_strips)
+        strip->setCompiledChainEnabled(enabled);
+
+    return true;
+}
+
+void DiagnosticStrips::resetProcessingState()
+{
+    for (auto strip : m_strips)
+        strip->resetProcessingState();
+}
+
+void DiagnosticStrips::process(int strip, const float* input, float* output, int numSamples)
+{
+    m_strips.getUnchecked(strip)->audioDeviceIOCallback(&input, 1, &output, 1, numSamples);
+}
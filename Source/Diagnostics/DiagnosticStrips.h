@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    DiagnosticStrips.h
+    Created: 18 Oct 2026 5:34:20am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "../ChannelStrip/ChannelStripComponent.h"
+
+//==============================================================================
+/*
+    A set of channel strips for the diagnostics checks to process directly.
+    The strips are components, so they are created, switched and destroyed
+    with the message manager locked, while the checks process them from their
+    own thread as the audio thread would.
+*/
+class DiagnosticStrips
+{
+public:
+    DiagnosticStrips();
+    ~DiagnosticStrips();
+
+    /** Returns false if the message manager could not be locked because the diagnostics are stopping. */
+    bool create(int numStrips, AudioIODevice& device, int maxBlockSize);
+    bool setCompiledChainEnabled(bool enabled);
+    void resetProcessingState();
+
+    int size() const noexcept { return m_strips.size(); };
+
+    void process(int strip, const float* input, float* output, int numSamples);
+
+private:
+    OwnedArray<ChannelStripComponent>   m_strips;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DiagnosticStrips)
+};
@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+    DiagnosticsAudioDevice.cpp
+    Created: 18 Oct 2026 4:18:05am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "DiagnosticsAudioDevice.h"
+
+// enough for a few minutes of callbacks, reserved up front so the device thread does not allocate
+static constexpr size_t maxRecordedCallbacks = 1 << 16;
+
+DiagnosticsAudioDevice::DiagnosticsAudioDevice(int numOutputChannels, double sampleRate, int bufferSize)
+    : AudioIODevice("Diagnostics", "Diagnostics"), Thread("DiagnosticsAudioDevice"),
+    m_numOutputChannels(jmax(1, numOutputChannels)), m_sampleRate(sampleRate), m_bufferSize(jmax(1, bufferSize))
+{
+    m_outputBuffer.setSize(m_numOutputChannels, m_bufferSize);
+    m_callbackDurationsMs.reserve(maxRecordedCallbacks);
+}
+
+DiagnosticsAudioDevice::~DiagnosticsAudioDevice()
+{
+    stop();
+}
+
+StringArray DiagnosticsAudioDevice::getOutputChannelNames()
+{
+    StringArray names;
+    for (auto i = 0; i < m_numOutputChannels; ++i)
+        names.add("Output " + String(i + 1));
+    return names;
+}
+
+StringArray DiagnosticsAudioDevice::getInputChannelNames()
+{
+    return {};
+}
+
+Array<double> DiagnosticsAudioDevice::getAvailableSampleRates()
+{
+    return { m_sampleRate };
+}
+
+Array<int> DiagnosticsAudioDevice::getAvailableBufferSizes()
+{
+    return { m_bufferSize };
+}
+
+int DiagnosticsAudioDevice::getDefaultBufferSize()
+{
+    return m_bufferSize;
+}
+
+String DiagnosticsAudioDevice::open(const BigInteger& inputChannels, const BigInteger& outputChannels, double sampleRate, int bufferSizeSamples)
+{
+    ignoreUnused(inputChannels, outputChannels, sampleRate, bufferSizeSamples);
+    return {};
+}
+
+void DiagnosticsAudioDevice::close()
+{
+    stop();
+}
+
+bool DiagnosticsAudioDevice::isOpen()
+{
+    return true;
+}
+
+void DiagnosticsAudioDevice::start(AudioIODeviceCallback* callback)
+{
+    stop();
+    if (callback == nullptr)
+        return;
+
+    callback->audioDeviceAboutToStart(this);
+
+    m_callback = callback;
+    m_numCallbacks = 0;
+    m_numOverruns = 0;
+    m_callbackDurationsMs.clear();
+    startThread(Thread::realtimeAudioPriority);
+}
+
+void DiagnosticsAudioDevice::stop()
+{
+    stopThread(5000);
+
+    if (auto callback = std::exchange(m_callback, nullptr))
+        callback->audioDeviceStopped();
+}
+
+bool DiagnosticsAudioDevice::isPlaying()
+{
+    return isThreadRunning();
+}
+
+String DiagnosticsAudioDevice::getLastError()
+{
+    return {};
+}
+
+int DiagnosticsAudioDevice::getCurrentBufferSizeSamples()
+{
+    return m_bufferSize;
+}
+
+double DiagnosticsAudioDevice::getCurrentSampleRate()
+{
+    return m_sampleRate;
+}
+
+int DiagnosticsAudioDevice::getCurrentBitDepth()
+{
+    return 32;
+}
+
+BigInteger DiagnosticsAudioDevice::getActiveOutputChannels() const
+{
+    BigInteger channels;
+    channels.setRange(0, m_numOutputChannels, true);
+    return channels;
+}
+
+BigInteger DiagnosticsAudioDevice::getActiveInputChannels() const
+{
+    return {};
+}
+
+int DiagnosticsAudioDevice::getOutputLatencyInSamples()
+{
+    return m_bufferSize;
+}
+
+int DiagnosticsAudioDevice::getInputLatencyInSamples()
+{
+    return 0;
+}
+
+std::vector<double> DiagnosticsAudioDevice::getCallbackDurationsMs() const
+{
+    jassert(!isThreadRunning());
+    return m_callbackDurationsMs;
+}
+
+void DiagnosticsAudioDevice::run()
+{
+    auto bufferDurationMs = 1000.0 * m_bufferSize / m_sampleRate;
+    auto nextCallbackMs = Time::getMillisecondCounterHiRes();
+
+    while (!threadShouldExit())
+    {
+        auto startTicks = Time::getHighResolutionTicks();
+        m_callback->audioDeviceIOCallback(nullptr, 0, m_outputBuffer.getArrayOfWritePointers(), m_numOutputChannels, m_bufferSize);
+        auto durationMs = 1000.0 * Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startTicks);
+
+        if (m_callbackDurationsMs.size() < maxRecordedCallbacks)
+            m_callbackDurationsMs.push_back(durationMs);
+        if (durationMs > bufferDurationMs)
+            ++m_numOverruns;
+        ++m_numCallbacks;
+
+        // paced like a device: the next buffer is due one buffer duration after the last one was, not after the callback returned
+        nextCallbackMs += bufferDurationMs;
+        auto nowMs = Time::getMillisecondCounterHiRes();
+        if (nextCallbackMs > nowMs)
+            Time::waitForMillisecondCounter(static_cast<uint32>(nextCallbackMs));
+        else
+            nextCallbackMs = nowMs;
+    }
+}
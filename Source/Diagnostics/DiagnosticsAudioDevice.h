@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    DiagnosticsAudioDevice.h
+    Created: 18 Oct 2026 4:18:05am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Stand-in output device for the diagnostics, without any hardware behind it.
+    Strips and the analyser are prepared from it like from a real device. Once
+    started, its own thread calls the callback at the pace a device with the
+    given sample rate and buffer size would, and the output is discarded.
+    Callbacks that take longer than a buffer lasts are counted as overruns.
+*/
+class DiagnosticsAudioDevice : public AudioIODevice,
+                               private Thread
+{
+public:
+    DiagnosticsAudioDevice(int numOutputChannels, double sampleRate, int bufferSize);
+    ~DiagnosticsAudioDevice() override;
+
+    //==============================================================================
+    StringArray getOutputChannelNames() override;
+    StringArray getInputChannelNames() override;
+    Array<double> getAvailableSampleRates() override;
+    Array<int> getAvailableBufferSizes() override;
+    int getDefaultBufferSize() override;
+
+    String open(const BigInteger& inputChannels, const BigInteger& outputChannels, double sampleRate, int bufferSizeSamples) override;
+    void close() override;
+    bool isOpen() override;
+
+    void start(AudioIODeviceCallback* callback) override;
+    void stop() override;
+    bool isPlaying() override;
+
+    String getLastError() override;
+    int getCurrentBufferSizeSamples() override;
+    double getCurrentSampleRate() override;
+    int getCurrentBitDepth() override;
+    BigInteger getActiveOutputChannels() const override;
+    BigInteger getActiveInputChannels() const override;
+    int getOutputLatencyInSamples() override;
+    int getInputLatencyInSamples() override;
+
+    //==============================================================================
+    int getNumCallbacks() const noexcept { return m_numCallbacks.load(); };
+    int getNumOverruns() const noexcept { return m_numOverruns.load(); };
+    /** The durations of the callbacks since the device was started. */
+    std::vector<double> getCallbackDurationsMs() const;
+
+private:
+    void run() override;
+
+    //==============================================================================
+    const int       m_numOutputChannels;
+    const double    m_sampleRate;
+    const int       m_bufferSize;
+
+    AudioBuffer<float>      m_outputBuffer;
+    AudioIODeviceCallback*  m_callback{ nullptr };
+
+    std::atomic<int>        m_numCallbacks{ 0 };
+    std::atomic<int>        m_numOverruns{ 0 };
+    std::vector<double>     m_callbackDurationsMs;  // written by the device thread only while it runs
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DiagnosticsAudioDevice)
+};
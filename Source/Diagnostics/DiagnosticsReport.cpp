@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    DiagnosticsReport.cpp
+    Created: 18 Oct 2026 4:12:37am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "DiagnosticsReport.h"
+
+#include <iostream>
+
+DiagnosticsReport::DiagnosticsReport()
+{
+}
+
+DiagnosticsReport::~DiagnosticsReport()
+{
+}
+
+void DiagnosticsReport::beginCheck(const String& name)
+{
+    m_checkStartFailures = m_numFailures;
+    log({});
+    log("== " + name);
+}
+
+void DiagnosticsReport::log(const String& line)
+{
+    std::cout << line.toStdString() << std::endl;
+}
+
+bool DiagnosticsReport::expect(bool condition, const String& description)
+{
+    if (!condition)
+        ++m_numFailures;
+
+    log(String(condition ? "  pass: " : "  FAIL: ") + description);
+    return condition;
+}
+
+DiagnosticsReport::Timing DiagnosticsReport::getTiming(std::vector<double> durationsMs)
+{
+    Timing timing;
+    if (durationsMs.empty())
+        return timing;
+
+    std::sort(durationsMs.begin(), durationsMs.end());
+    timing.minimumMs = durationsMs.front();
+    timing.medianMs = durationsMs[durationsMs.size() / 2];
+    timing.maximumMs = durationsMs.back();
+    return timing;
+}
+
+String DiagnosticsReport::toString(const Timing& timing)
+{
+    return "min " + String(timing.minimumMs, 3) + " ms, median " + String(timing.medianMs, 3) + " ms, max " + String(timing.maximumMs, 3) + " ms";
+}
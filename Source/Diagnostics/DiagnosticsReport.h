@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    DiagnosticsReport.h
+    Created: 18 Oct 2026 4:12:37am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    What the diagnostics checks write their measurements and expectations to.
+    Lines go to stdout as they are written, so a run can be followed live and
+    its output kept as a log. Failed expectations are counted for the exit code.
+*/
+class DiagnosticsReport
+{
+public:
+    struct Timing
+    {
+        double  minimumMs{ 0.0 };
+        double  medianMs{ 0.0 };
+        double  maximumMs{ 0.0 };
+    };
+
+    //==============================================================================
+    DiagnosticsReport();
+    ~DiagnosticsReport();
+
+    void beginCheck(const String& name);
+    void log(const String& line);
+    /** Logs the description as passed or failed, returns the condition. */
+    bool expect(bool condition, const String& description);
+
+    int getNumFailures() const noexcept { return m_numFailures; };
+    int getNumCheckFailures() const noexcept { return m_numFailures - m_checkStartFailures; };
+
+    //==============================================================================
+    /** Runs the function a few times untimed, then the given number of times timed. */
+    template <typename Function>
+    static Timing measure(int repetitions, Function&& function)
+    {
+        for (auto i = 0; i < jmin(repetitions, 10); ++i)
+            function();
+
+        std::vector<double> durations(static_cast<size_t>(jmax(1, repetitions)));
+        for (auto& duration : durations)
+        {
+            auto startTicks = Time::getHighResolutionTicks();
+            function();
+            duration = 1000.0 * Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startTicks);
+        }
+
+        return getTiming(durations);
+    }
+
+    static Timing getTiming(std::vector<double> durationsMs);
+    static String toString(const Timing& timing);
+
+private:
+    int m_numFailures{ 0 };
+    int m_checkStartFailures{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DiagnosticsReport)
+};
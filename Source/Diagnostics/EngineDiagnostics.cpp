@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    EngineDiagnostics.cpp
+    Created: 18 Oct 2026 4:05:52am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "EngineDiagnostics.h"
+
+#include "DiagnosticChecks.h"
+
+static constexpr const char* diagnosticsCommandLineOption = "--diagnostics";
+
+EngineDiagnostics::EngineDiagnostics(const StringArray& checkNames)
+    : Thread("EngineDiagnostics"), m_checkNames(checkNames)
+{
+}
+
+EngineDiagnostics::~EngineDiagnostics()
+{
+    stopThread(10000);
+}
+
+bool EngineDiagnostics::isDiagnosticsCommandLine(const String& commandLine)
+{
+    return StringArray::fromTokens(commandLine, true).contains(diagnosticsCommandLineOption);
+}
+
+StringArray EngineDiagnostics::getCheckNames(const String& commandLine)
+{
+    // the names following the option, up to the next option
+    auto arguments = StringArray::fromTokens(commandLine, true);
+    StringArray names;
+    for (auto i = arguments.indexOf(diagnosticsCommandLineOption) + 1; i > 0 && i < arguments.size() && !arguments[i].startsWith("-"); ++i)
+        names.add(arguments[i].unquoted());
+
+    return names;
+}
+
+const std::vector<EngineDiagnostics::Check>& EngineDiagnostics::getChecks()
+{
+    static const std::vector<Check> checks{
+        { "worker-pool", &runWorkerPoolScalingCheck, true },
+        { "filter-kernel", &runFilterKernelCheck, true },
+        { "strip-chain", &runStripChainCheck, true },
+        { "channel-scaling", &runChannelScalingCheck, true },
+        { "strip-shards", &runStripShardCheck, true },
+        { "rig-state", &runRigStateCheck, true },
+        { "osc-load", &runOSCLoadCheck, true },
+        { "midi-controllers", &runMidiControllerCheck, true },
+        { "jack", &runJackClientCheck, false },
+    };
+
+    return checks;
+}
+
+void EngineDiagnostics::start()
+{
+    startThread();
+}
+
+void EngineDiagnostics::run()
+{
+    StringArray available;
+    for (auto const& check : getChecks())
+        available.add(check.name);
+
+    for (auto const& name : m_checkNames)
+        if (name != "all")
+            m_report.expect(available.contains(name), "check '" + name + "' exists (available: " + available.joinIntoString(", ") + ")");
+
+    auto runAll = m_checkNames.isEmpty() || m_checkNames.contains("all");
+    for (auto const& check : getChecks())
+    {
+        if (threadShouldExit())
+            break;
+        if (!(runAll && check.runByDefault) && !m_checkNames.contains(check.name))
+            continue;
+
+        m_report.beginCheck(check.name);
+        if (!check.function(m_report))
+            m_report.log("'" + String(check.name) + "' failed");
+    }
+
+    m_report.log({});
+    m_report.log(m_report.getNumFailures() == 0 ? String("all checks passed") : String(m_report.getNumFailures()) + " expectation(s) failed");
+
+    if (onFinished)
+        onFinished(jmin(m_report.getNumFailures(), 125));
+}
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    EngineDiagnostics.h
+    Created: 18 Oct 2026 4:05:52am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "DiagnosticsReport.h"
+
+//==============================================================================
+/*
+    What the application runs instead of its window when started with
+    '--diagnostics [check ...]': the engine's benchmarks and verifications,
+    one after another on a thread of their own, with the message thread kept
+    running for the parts of the engine that depend on it.
+
+    Without check names all checks are run, except for those depending on
+    the environment (a running JACK server). The exit code is the number of
+    failed expectations (at most 125), so scripts can use a run as a gate.
+*/
+class EngineDiagnostics : private Thread
+{
+public:
+    explicit EngineDiagnostics(const StringArray& checkNames);
+    ~EngineDiagnostics() override;
+
+    static bool isDiagnosticsCommandLine(const String& commandLine);
+    static StringArray getCheckNames(const String& commandLine);
+
+    /** Called on the diagnostics thread when all checks ran, with the process exit code to use. */
+    std::function<void(int)> onFinished;
+
+    void start();
+
+private:
+    struct Check
+    {
+        const char* name;
+        bool (*function)(DiagnosticsReport& report);
+        bool runByDefault;  // false for checks depending on the environment, only run when named
+    };
+
+    static const std::vector<Check>& getChecks();
+
+    void run() override;
+
+    //==============================================================================
+    StringArray         m_checkNames;
+    DiagnosticsReport   m_report;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineDiagnostics)
+};
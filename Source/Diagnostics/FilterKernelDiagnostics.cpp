@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+
+    FilterKernelDiagnostics.cpp
+    Created: 18 Oct 2026 5:02:46am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "DiagnosticChecks.h"
+
+#include "../ChannelStrip/ChannelStripEngine.h"
+
+static constexpr double sampleRate = 48000.0;
+static constexpr int blockSize = 128;
+
+// the kernels do the same operations in the same order, only the compiler's contraction of them may differ
+static constexpr float kernelTolerance = 1.0e-5f;
+// against dsp::StateVariableTPTFilter, which computes its coefficients in single precision
+static constexpr float referenceTolerance = 1.0e-4f;
+
+struct KernelRun
+{
+    KernelRun(int numChannels, bool vectorised)
+        : outputs(numChannels, blockSize)
+    {
+        engine.prepare(sampleRate, numChannels, blockSize);
+        engine.setVectorisationEnabled(vectorised);
+        scratch.prepare(ChannelStripEngine::getScratchSize(blockSize));
+    }
+
+    void process(const AudioBuffer<float>& inputs, const bool* activeChannels = nullptr)
+    {
+        engine.process(inputs.getArrayOfReadPointers(), outputs.getArrayOfWritePointers(), outputs.getNumChannels(), blockSize, scratch, activeChannels);
+    }
+
+    ChannelStripEngine  engine;
+    ScratchArena        scratch;
+    AudioBuffer<float>  outputs;
+};
+
+static ChannelStripEngine::ChannelParameters getRandomParameters(Random& random)
+{
+    // cutoffs spread evenly over the octaves from 20 Hz to 20 kHz
+    ChannelStripEngine::ChannelParameters parameters;
+    parameters.highPassCutoff = 20.0f * std::pow(1000.0f, random.nextFloat());
+    parameters.highPassGain = random.nextFloat();
+    parameters.lowPassCutoff = 20.0f * std::pow(1000.0f, random.nextFloat());
+    parameters.lowPassGain = random.nextFloat();
+    parameters.gain = 0.25f + random.nextFloat();
+    return parameters;
+}
+
+static void fillWithNoise(AudioBuffer<float>& buffer, Random& random)
+{
+    for (auto ch = 0; ch < buffer.getNumChannels(); ++ch)
+        for (auto i = 0; i < buffer.getNumSamples(); ++i)
+            buffer.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+}
+
+static float getMaxDifference(const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+{
+    auto difference = 0.0f;
+    for (auto ch = 0; ch < jmin(a.getNumChannels(), b.getNumChannels()); ++ch)
+        for (auto i = 0; i < jmin(a.getNumSamples(), b.getNumSamples()); ++i)
+            difference = jmax(difference, std::abs(a.getSample(ch, i) - b.getSample(ch, i)));
+    return difference;
+}
+
+static bool checkKernelsAgree(DiagnosticsReport& report, int numChannels)
+{
+    KernelRun vectorised(numChannels, true);
+    KernelRun scalar(numChannels, false);
+    AudioBuffer<float> inputs(numChannels, blockSize);
+    Random random(numChannels);
+
+    auto setRandomParameters = [&]
+    {
+        for (auto ch = 0; ch < numChannels; ++ch)
+        {
+            auto parameters = getRandomParameters(random);
+            vectorised.engine.setChannelParameters(ch, parameters);
+            scalar.engine.setChannelParameters(ch, parameters);
+        }
+    };
+
+    // every third channel is skipped towards the end, which leaves inactive lanes in processed groups
+    HeapBlock<bool> activeChannels(static_cast<size_t>(numChannels));
+    std::fill(activeChannels.get(), activeChannels.get() + numChannels, true);
+    auto maxDifference = 0.0f;
+    auto inactiveSilent = true;
+    for (auto block = 0; block < 200; ++block)
+    {
+        // new targets in the middle of the run make the cutoffs and amounts ramp
+        if (block == 0 || block == 50 || block == 120)
+            setRandomParameters();
+        if (block == 150)
+            for (auto ch = 1; ch < numChannels; ch += 3)
+                activeChannels[ch] = false;
+
+        fillWithNoise(inputs, random);
+        vectorised.process(inputs, activeChannels.get());
+        scalar.process(inputs, activeChannels.get());
+
+        maxDifference = jmax(maxDifference, getMaxDifference(vectorised.outputs, scalar.outputs));
+        for (auto ch = 0; ch < numChannels; ++ch)
+            if (!activeChannels[ch])
+                inactiveSilent = inactiveSilent && vectorised.outputs.getMagnitude(ch, 0, blockSize) == 0.0f;
+    }
+
+    auto passed = report.expect(maxDifference <= kernelTolerance, String(numChannels) + " channels: SIMD and scalar kernel differ by at most " + String(maxDifference, 8));
+    if (numChannels > 1)
+        passed = report.expect(inactiveSilent, String(numChannels) + " channels: inactive lanes output silence") && passed;
+
+    return passed;
+}
+
+static bool checkAgainstReference(DiagnosticsReport& report, int numChannels, bool vectorisationEnabled)
+{
+    KernelRun run(numChannels, vectorisationEnabled);
+    AudioBuffer<float> inputs(numChannels, blockSize);
+    AudioBuffer<float> expected(numChannels, blockSize);
+    Random random(numChannels + 1000);
+
+    std::vector<ChannelStripEngine::ChannelParameters> parameters;
+    std::vector<dsp::StateVariableTPTFilter<float>> highPasses(static_cast<size_t>(numChannels));
+    std::vector<dsp::StateVariableTPTFilter<float>> lowPasses(static_cast<size_t>(numChannels));
+    for (auto ch = 0; ch < numChannels; ++ch)
+    {
+        parameters.push_back(getRandomParameters(random));
+        run.engine.setChannelParameters(ch, parameters.back());
+
+        auto& highPass = highPasses[static_cast<size_t>(ch)];
+        highPass.setType(dsp::StateVariableTPTFilterType::highpass);
+        highPass.prepare({ sampleRate, static_cast<uint32>(blockSize), 1 });
+        highPass.setCutoffFrequency(parameters.back().highPassCutoff);
+
+        auto& lowPass = lowPasses[static_cast<size_t>(ch)];
+        lowPass.setType(dsp::StateVariableTPTFilterType::lowpass);
+        lowPass.prepare({ sampleRate, static_cast<uint32>(blockSize), 1 });
+        lowPass.setCutoffFrequency(parameters.back().lowPassCutoff);
+    }
+
+    // the engine ramps its amounts up from silence, they have long settled after this
+    auto settleBlocks = static_cast<int>(std::ceil(15.0 * ChannelStripProcessorBase::getSmoothingSeconds() * sampleRate / blockSize));
+    auto maxDifference = 0.0f;
+    for (auto block = 0; block < settleBlocks + 20; ++block)
+    {
+        fillWithNoise(inputs, random);
+        run.process(inputs);
+
+        for (auto ch = 0; ch < numChannels; ++ch)
+        {
+            auto& channelParameters = parameters[static_cast<size_t>(ch)];
+            for (auto i = 0; i < blockSize; ++i)
+            {
+                auto x = inputs.getSample(ch, i);
+                auto y = channelParameters.gain * (channelParameters.highPassGain * highPasses[static_cast<size_t>(ch)].processSample(0, x)
+                                                 + channelParameters.lowPassGain * lowPasses[static_cast<size_t>(ch)].processSample(0, x));
+                expected.setSample(ch, i, y);
+            }
+        }
+
+        if (block >= settleBlocks)
+            maxDifference = jmax(maxDifference, getMaxDifference(run.outputs, expected));
+    }
+
+    return report.expect(maxDifference <= referenceTolerance, String(numChannels) + " channels: " + (vectorisationEnabled ? "SIMD" : "scalar")
+        + " kernel differs from dsp::StateVariableTPTFilter by at most " + String(maxDifference, 8));
+}
+
+bool runFilterKernelCheck(DiagnosticsReport& report)
+{
+    auto numLanes = ChannelStripEngine::getNumLanes();
+    report.log(String(numLanes) + " lanes per SIMD register, tolerance " + String(kernelTolerance, 6) + " between the kernels, "
+        + String(referenceTolerance, 6) + " against the reference");
+
+    // one to three groups, including every size of an incomplete last group
+    auto passed = true;
+    for (auto numChannels = 1; numChannels <= 3 * numLanes + 1; ++numChannels)
+        passed = checkKernelsAgree(report, numChannels) && passed;
+
+    for (auto numChannels : { 1, numLanes, 2 * numLanes + 1 })
+    {
+        passed = checkAgainstReference(report, numChannels, true) && passed;
+        passed = checkAgainstReference(report, numChannels, false) && passed;
+    }
+
+    for (auto vectorisationEnabled : { false, true })
+    {
+        KernelRun run(64, vectorisationEnabled);
+        AudioBuffer<float> inputs(64, blockSize);
+        Random random(64);
+        fillWithNoise(inputs, random);
+        for (auto ch = 0; ch < 64; ++ch)
+            run.engine.setChannelParameters(ch, getRandomParameters(random));
+
+        report.log(String(vectorisationEnabled ? "SIMD" : "scalar") + " kernel, 64 channels of " + String(blockSize) + " samples: "
+            + DiagnosticsReport::toString(DiagnosticsReport::measure(1000, [&] { run.process(inputs); })));
+    }
+
+    return passed;
+}
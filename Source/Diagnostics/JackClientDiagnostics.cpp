@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    JackClientDiagnostics.cpp
+    Created: 18 Oct 2026 7:02:18am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "DiagnosticChecks.h"
+
+#include "../Engine/JackClientDevice.h"
+
+static constexpr int numPorts = 8;
+
+//==============================================================================
+/*
+    Writes a tone straight into the port buffers it is handed, as the engine does,
+    and counts the cycles, including any larger than the device was started with.
+*/
+class JackClientCallback : public AudioIODeviceCallback
+{
+public:
+    void audioDeviceIOCallback(const float** inputChannelData, int numInputChannels, float** outputChannelData, int numOutputChannels, int numSamples) override
+    {
+        ignoreUnused(inputChannelData, numInputChannels);
+
+        if (numSamples > m_preparedBufferSize.load())
+            m_oversizedCallbacks.fetch_add(1, std::memory_order_relaxed);
+
+        for (auto i = 0; i < numSamples; ++i)
+        {
+            auto sample = 0.1f * std::sin(m_phase);
+            m_phase = std::fmod(m_phase + m_phaseIncrement, MathConstants<float>::twoPi);
+            for (auto ch = 0; ch < numOutputChannels; ++ch)
+                outputChannelData[ch][i] = sample;
+        }
+
+        m_callbacks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void audioDeviceAboutToStart(AudioIODevice* device) override
+    {
+        m_preparedBufferSize = device->getCurrentBufferSizeSamples();
+        m_phaseIncrement = static_cast<float>(MathConstants<double>::twoPi * 440.0 / device->getCurrentSampleRate());
+        m_callbacks = 0;
+    }
+
+    void audioDeviceStopped() override {}
+
+    int getNumCallbacks() const noexcept { return m_callbacks.load(); };
+    int getNumOversizedCallbacks() const noexcept { return m_oversizedCallbacks.load(); };
+
+private:
+    std::atomic<int>    m_preparedBufferSize{ 0 };
+    std::atomic<int>    m_callbacks{ 0 };
+    std::atomic<int>    m_oversizedCallbacks{ 0 };
+    float               m_phase{ 0.0f };
+    float               m_phaseIncrement{ 0.0f };
+};
+
+static bool setServerBufferSize(int bufferSize)
+{
+    // jack_bufsize talks to the same server as we do, JACK_DEFAULT_SERVER included
+    ChildProcess process;
+    return process.start(StringArray{ "jack_bufsize", String(bufferSize) }) && process.waitForProcessToFinish(5000) && process.getExitCode() == 0;
+}
+
+static bool waitFor(const std::function<bool()>& condition, int timeoutMs)
+{
+    for (auto waitedMs = 0; !condition() && waitedMs < timeoutMs; waitedMs += 10)
+        Thread::sleep(10);
+
+    return condition();
+}
+
+//==============================================================================
+bool runJackClientCheck(DiagnosticsReport& report)
+{
+    if (!report.expect(JackClientDevice::isAvailable(), "built with JACK support and libjack loaded"))
+        return false;
+
+    JackClientDevice device("PlacrossDiagnostics", numPorts);
+    BigInteger outputs;
+    outputs.setRange(0, numPorts, true);
+    auto error = device.open({}, outputs, 0.0, 0);
+    if (!report.expect(error.isEmpty(), "connected to the JACK server" + (error.isEmpty() ? String() : ": " + error)))
+        return false;
+
+    report.log("server running at " + String(device.getCurrentSampleRate()) + " Hz with buffers of " + String(device.getCurrentBufferSizeSamples()) + " samples");
+    report.expect(device.getActiveOutputChannels().countNumberOfSetBits() == numPorts, String(numPorts) + " ports registered, one per strip");
+
+    // set on the message thread, where the application would go through its reconfiguration path
+    std::atomic<bool> formatChanged{ false };
+    device.onServerFormatChanged = [&formatChanged] { formatChanged = true; };
+
+    JackClientCallback callback;
+    device.start(&callback);
+    Thread::sleep(2000);
+    auto expectedCallbacks = static_cast<int>(2.0 * device.getCurrentSampleRate() / device.getCurrentBufferSizeSamples());
+    report.expect(callback.getNumCallbacks() >= expectedCallbacks / 2, String(callback.getNumCallbacks()) + " of about " + String(expectedCallbacks) + " cycles reached the callback");
+
+    auto originalBufferSize = device.getCurrentBufferSizeSamples();
+    auto changedBufferSize = originalBufferSize == 256 ? 512 : 256;
+    if (setServerBufferSize(changedBufferSize))
+    {
+        report.expect(waitFor([&] { return formatChanged.load(); }, 3000), "the buffer size change arrives on the message thread");
+        report.expect(device.getCurrentBufferSizeSamples() == changedBufferSize, "the device reports the new buffer size of " + String(changedBufferSize));
+
+        // what the application does from onServerFormatChanged, the callback is restarted for the new size
+        device.start(&callback);
+        Thread::sleep(1000);
+        report.expect(callback.getNumCallbacks() > 0, "cycles reach the callback again after restarting it");
+
+        formatChanged = false;
+        setServerBufferSize(originalBufferSize);
+        waitFor([&] { return formatChanged.load(); }, 3000);
+    }
+    else
+    {
+        report.log("jack_bufsize could not change the server's buffer size, following it is not checked");
+    }
+
+    report.expect(callback.getNumOversizedCallbacks() == 0, "no cycle larger than what the callback was started with reached it");
+
+    device.close();
+    return report.getNumCheckFailures() == 0;
+}
@@ -0,0 +1,276 @@
+/*
+  ==============================================================================
+
+    MidiControllerDiagnostics.cpp
+    Created: 18 Oct 2026 8:17:38am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "DiagnosticChecks.h"
+
+#include "../ChannelStrip/ChannelStripProcessor.h"
+#include "../Remote/MidiRemoteControl.h"
+
+static constexpr double sampleRate = 48000.0;
+static constexpr int blockSize = 256;
+static constexpr int numStrips = 64;
+static constexpr int numStripParameters = 5;
+static constexpr int numMappings = numStrips * numStripParameters;
+// changes are placed at least this far into the block, so the delay until they are applied does not clip them to its start
+static constexpr int minimumOffset = 16;
+
+//==============================================================================
+// mapping m drives parameter m % 5 of strip m / 5, from controller m counted across the MIDI channels
+static int getMidiChannel(int mapping) { return mapping / MidiRemoteControl::numControllerNumbers + 1; }
+static int getControllerNumber(int mapping) { return mapping % MidiRemoteControl::numControllerNumbers; }
+
+static MidiRemoteControl::Mapping getMapping(int mapping)
+{
+    static const ChannelStripProcessorBase::ChannelStripProcessorType types[numStripParameters] = {
+        ChannelStripProcessorBase::CSPT_HighPass, ChannelStripProcessorBase::CSPT_HighPass,
+        ChannelStripProcessorBase::CSPT_LowPass, ChannelStripProcessorBase::CSPT_LowPass,
+        ChannelStripProcessorBase::CSPT_Gain };
+    static const ParameterEvent::Target targets[numStripParameters] = {
+        ParameterEvent::PET_Frequency, ParameterEvent::PET_Gain, ParameterEvent::PET_Frequency, ParameterEvent::PET_Gain, ParameterEvent::PET_Gain };
+
+    MidiRemoteControl::Mapping result;
+    result.strip = mapping / numStripParameters;
+    result.type = types[mapping % numStripParameters];
+    result.target = targets[mapping % numStripParameters];
+    return result;
+}
+
+static bool isEqual(const MidiRemoteControl::Mapping& a, const MidiRemoteControl::Mapping& b)
+{
+    return a.strip == b.strip && a.type == b.type && a.target == b.target;
+}
+
+// never 0 or 127, so every change moves the parameter away from its default at either end of the range
+static int getControllerValue(int mapping) { return 1 + (mapping * 37) % 126; }
+static int getOffset(int mapping) { return minimumOffset + (mapping * 53) % (blockSize - minimumOffset); }
+
+static float getParameterValue(const ChannelStripEngine::ChannelParameters& parameters, int stripParameter)
+{
+    switch (stripParameter)
+    {
+    case 0:     return parameters.highPassCutoff;
+    case 1:     return parameters.highPassGain;
+    case 2:     return parameters.lowPassCutoff;
+    case 3:     return parameters.lowPassGain;
+    default:    return parameters.gain;
+    }
+}
+
+static void sendController(MidiRemoteControl& remote, int mapping, int value, double timeStamp)
+{
+    auto message = MidiMessage::controllerEvent(getMidiChannel(mapping), getControllerNumber(mapping), value);
+    message.setTimeStamp(timeStamp);
+    remote.handleMessage(message);
+}
+
+//==============================================================================
+/*
+    Strip processors without the strips around them, as the audio thread sees them.
+*/
+class MidiControlledStrips
+{
+public:
+    MidiControlledStrips()
+    {
+        for (auto strip = 0; strip < numStrips; ++strip)
+        {
+            m_processors.push_back(std::make_unique<HPFilterProcessor>());
+            m_processors.push_back(std::make_unique<LPFilterProcessor>());
+            m_processors.push_back(std::make_unique<GainProcessor>());
+            auto first = m_processors.end() - 3;
+            m_stripProcessors.push_back({ first[0].get(), first[1].get(), first[2].get() });
+        }
+
+        for (auto& processor : m_processors)
+            processor->prepareToPlay(sampleRate, blockSize);
+    }
+
+    const std::vector<ChannelStripEngine::ChannelProcessors>& getStripProcessors() const noexcept { return m_stripProcessors; };
+
+    void applyParameterEvents(int numSamples)
+    {
+        for (auto& processor : m_processors)
+            processor->applyParameterEventsOfBlock(numSamples);
+    }
+
+    /** Steps through the block a sample at a time and returns the offset each strip parameter changed at, -1 where it did not. */
+    std::vector<int> getChangeOffsets(int numSamples)
+    {
+        std::vector<int> offsets(static_cast<size_t>(numMappings), -1);
+        std::vector<ChannelStripEngine::ChannelParameters> previous;
+        for (auto const& processors : m_stripProcessors)
+            previous.push_back(ChannelStripEngine::getChannelParameters(processors));
+
+        for (auto offset = 0; offset < numSamples; ++offset)
+        {
+            for (auto& processor : m_processors)
+            {
+                processor->applyDueParameterEvents(1);
+                processor->advanceSamplePosition(1);
+            }
+
+            for (auto strip = 0; strip < numStrips; ++strip)
+            {
+                auto parameters = ChannelStripEngine::getChannelParameters(m_stripProcessors[static_cast<size_t>(strip)]);
+                for (auto parameter = 0; parameter < numStripParameters; ++parameter)
+                    if (getParameterValue(parameters, parameter) != getParameterValue(previous[static_cast<size_t>(strip)], parameter))
+                        offsets[static_cast<size_t>(strip * numStripParameters + parameter)] = offset;
+                previous[static_cast<size_t>(strip)] = parameters;
+            }
+        }
+
+        return offsets;
+    }
+
+private:
+    std::vector<std::unique_ptr<ChannelStripProcessorBase>> m_processors;
+    std::vector<ChannelStripEngine::ChannelProcessors>      m_stripProcessors;
+};
+
+//==============================================================================
+static bool checkMappings(DiagnosticsReport& report, MidiRemoteControl& remote)
+{
+    for (auto mapping = 0; mapping < numMappings; ++mapping)
+        remote.setMapping(getMidiChannel(mapping), getControllerNumber(mapping), getMapping(mapping));
+
+    auto allMapped = true;
+    for (auto mapping = 0; mapping < numMappings; ++mapping)
+        allMapped = allMapped && isEqual(remote.getMapping(getMidiChannel(mapping), getControllerNumber(mapping)), getMapping(mapping));
+    report.expect(allMapped, String(numMappings) + " controllers on " + String(getMidiChannel(numMappings - 1)) + " MIDI channels are mapped to the parameters of " + String(numStrips) + " strips");
+
+    return report.getNumCheckFailures() == 0;
+}
+
+static bool checkSampleOffsets(DiagnosticsReport& report, MidiRemoteControl& remote, MidiControlledStrips& strips)
+{
+    // every controller moved once during the last block period, each at its own offset
+    auto blockStart = Time::getMillisecondCounterHiRes() * 0.001 - blockSize / sampleRate;
+    for (auto mapping = 0; mapping < numMappings; ++mapping)
+        sendController(remote, mapping, getControllerValue(mapping), blockStart + getOffset(mapping) / sampleRate);
+    remote.applyControllers(strips.getStripProcessors(), blockSize);
+    auto offsets = strips.getChangeOffsets(blockSize);
+
+    // the delay until the block is applied shifts all changes alike. The offsets are taken against the clock when the block
+    // is applied, a scheduler hiccup in between squeezes changes together at the block start, so the spacing is only reported.
+    auto shift = offsets[0] - getOffset(0);
+    auto allChanged = true;
+    auto inOrder = true;
+    auto maxDeviation = 0;
+    for (auto mapping = 0; mapping < numMappings; ++mapping)
+    {
+        auto offset = offsets[static_cast<size_t>(mapping)];
+        allChanged = allChanged && offset >= 0;
+        maxDeviation = jmax(maxDeviation, std::abs(offset - getOffset(mapping) - shift));
+        for (auto other = 0; other < numMappings; ++other)
+            inOrder = inOrder && (getOffset(other) >= getOffset(mapping) || offsets[static_cast<size_t>(other)] <= offset);
+    }
+    report.log(String(numMappings) + " controller changes within a block of " + String(blockSize) + " samples applied " + String(-shift) + " samples ahead of where they arrived, "
+        + "their spacing at most " + String(maxDeviation) + " samples off");
+    report.expect(allChanged, "every controller change reaches its strip parameter within the block");
+    report.expect(inOrder, "the changes are applied in the order of their timestamps");
+
+    auto allValues = true;
+    for (auto strip = 0; strip < numStrips; ++strip)
+    {
+        auto const& processors = strips.getStripProcessors()[static_cast<size_t>(strip)];
+        auto parameters = ChannelStripEngine::getChannelParameters(processors);
+        for (auto parameter = 0; parameter < numStripParameters; ++parameter)
+        {
+            auto mapping = strip * numStripParameters + parameter;
+            auto processor = parameter < 2 ? processors.highPass : parameter < 4 ? processors.lowPass : processors.gain;
+            auto expected = processor->getTargetParameter(getMapping(mapping).target)->getNormalisableRange().convertFrom0to1(getControllerValue(mapping) / 127.0f);
+            allValues = allValues && getParameterValue(parameters, parameter) == expected;
+        }
+    }
+    report.expect(allValues, "every parameter ends up at the value of its controller, mapped to the parameter's range");
+    report.expect(remote.getNumDropped() == 0, "no controller change was dropped");
+
+    // a block's worth of changes of all controllers, handed over and applied
+    auto perBlock = DiagnosticsReport::measure(100, [&] {
+        auto now = Time::getMillisecondCounterHiRes() * 0.001;
+        for (auto mapping = 0; mapping < numMappings; ++mapping)
+            sendController(remote, mapping, getControllerValue(mapping), now);
+        remote.applyControllers(strips.getStripProcessors(), blockSize);
+        strips.applyParameterEvents(blockSize);
+    });
+    report.log(String(numMappings) + " controller changes per block: " + DiagnosticsReport::toString(perBlock));
+
+    return report.getNumCheckFailures() == 0;
+}
+
+static bool checkLearning(DiagnosticsReport& report, MidiRemoteControl& remote, MidiControlledStrips& strips)
+{
+    // the parameter of mapping 0 moves to the first controller not mapped yet
+    remote.startLearning(getMapping(0));
+    sendController(remote, numMappings, 64, 0.0);
+    remote.applyControllers(strips.getStripProcessors(), blockSize);
+    strips.applyParameterEvents(blockSize);
+
+    report.expect(!remote.isLearning() && isEqual(remote.getMapping(getMidiChannel(numMappings), getControllerNumber(numMappings)), getMapping(0))
+        && !remote.getMapping(getMidiChannel(0), getControllerNumber(0)).isValid(), "learning moves the parameter to the controller moved first");
+
+    remote.removeMappings(1, ChannelStripProcessorBase::CSPT_LowPass);
+    auto removed = true;
+    for (auto mapping = 1; mapping < numMappings; ++mapping)
+    {
+        auto isLowPassOfStrip1 = getMapping(mapping).strip == 1 && getMapping(mapping).type == ChannelStripProcessorBase::CSPT_LowPass;
+        removed = removed && remote.getMapping(getMidiChannel(mapping), getControllerNumber(mapping)).isValid() != isLowPassOfStrip1;
+    }
+    report.expect(removed, "removing the mappings of a processor leaves those of all others");
+
+    return report.getNumCheckFailures() == 0;
+}
+
+static bool checkOverflow(DiagnosticsReport& report, MidiRemoteControl& remote, MidiControlledStrips& strips)
+{
+    // more changes than the fifo holds before the audio thread takes them, spread over the gain of all strips
+    auto numSent = MidiRemoteControl::fifoCapacity + 100;
+    auto droppedBefore = remote.getNumDropped();
+    for (auto i = 0; i < numSent; ++i)
+        sendController(remote, (i % numStrips) * numStripParameters + 4, i % 128, 0.0);
+    auto droppedByFifo = static_cast<int>(remote.getNumDropped() - droppedBefore);
+
+    remote.applyControllers(strips.getStripProcessors(), blockSize);
+    strips.applyParameterEvents(blockSize);
+
+    report.expect(droppedByFifo == numSent - (MidiRemoteControl::fifoCapacity - 1), String(droppedByFifo) + " changes beyond the fifo's capacity are counted as dropped");
+    report.expect(static_cast<int>(remote.getNumDropped() - droppedBefore) == droppedByFifo, "the changes in the fifo all fit the processors' event queues");
+
+    return report.getNumCheckFailures() == 0;
+}
+
+bool runMidiControllerCheck(DiagnosticsReport& report)
+{
+    std::unique_ptr<AudioDeviceManager> deviceManager;
+    std::unique_ptr<MidiRemoteControl> remote;
+    {
+        const MessageManagerLock lock(Thread::getCurrentThread());
+        if (!lock.lockWasGained())
+            return false;
+
+        // never enabled, the check hands the messages over itself
+        deviceManager = std::make_unique<AudioDeviceManager>();
+        remote = std::make_unique<MidiRemoteControl>(*deviceManager);
+        remote->prepare(sampleRate);
+    }
+
+    MidiControlledStrips strips;
+
+    auto passed = checkMappings(report, *remote);
+    passed = checkSampleOffsets(report, *remote, strips) && passed;
+    passed = checkLearning(report, *remote, strips) && passed;
+    passed = checkOverflow(report, *remote, strips) && passed;
+
+    const MessageManagerLock lock;
+    remote.reset();
+    deviceManager.reset();
+
+    return passed;
+}
@@ -0,0 +1,273 @@
+/*
+  ==============================================================================
+
+    OSCLoadDiagnostics.cpp
+    Created: 18 Oct 2026 7:52:14am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "DiagnosticChecks.h"
+#include "DiagnosticsAudioDevice.h"
+
+#include "../AudioPlayer/AudioPlayerComponent.h"
+#include "../ChannelStrip/ChannelStripProcessor.h"
+#include "../Remote/OSCRemoteControl.h"
+
+static constexpr double sampleRate = 48000.0;
+static constexpr int blockSize = 256;
+static constexpr int numChannels = 64;
+static constexpr int messagesPerMs = 10;
+static constexpr int transportIntervalMs = 50;
+
+static const char* const stripParameterAddresses[OSCRemoteControl::SP_NumParameters] = { "highpass/frequency", "highpass/gain", "lowpass/frequency", "lowpass/gain", "gain" };
+static const char* const transportAddresses[OSCRemoteControl::TC_NumCommands] = { "play", "stop", "next", "previous" };
+
+static OSCAddressPattern getStripAddress(int channel, int parameter)
+{
+    return OSCAddressPattern("/placross/strip/" + String(channel + 1) + "/" + stripParameterAddresses[parameter]);
+}
+
+// within the ranges the remote control clips to, so what arrives is what was sent
+static float getStripValue(int parameter, int step)
+{
+    if (parameter == OSCRemoteControl::SP_HighPassFrequency || parameter == OSCRemoteControl::SP_LowPassFrequency)
+        return 20.0f + static_cast<float>(step % 19980);
+
+    return static_cast<float>(step % 101) / 100.0f;
+}
+
+//==============================================================================
+/*
+    Sends strip and player values to the remote control over UDP on 127.0.0.1
+    at a fixed rate, and a transport command every now and then.
+*/
+class OSCLoadSender : public Thread
+{
+public:
+    explicit OSCLoadSender(int port)
+        : Thread("OSCLoadSender"), m_port(port)
+    {
+        for (auto channel = 0; channel < numChannels; ++channel)
+            for (auto parameter = 0; parameter < OSCRemoteControl::SP_NumParameters; ++parameter)
+                m_stripAddresses.push_back(getStripAddress(channel, parameter));
+    }
+
+    void run() override
+    {
+        OSCSender sender;
+        if (!sender.connect("127.0.0.1", m_port))
+            return;
+
+        auto startMs = Time::getMillisecondCounterHiRes();
+        auto nextMs = startMs;
+        auto step = 0;
+        for (auto tick = 0; !threadShouldExit(); ++tick)
+        {
+            for (auto i = 0; i < messagesPerMs; ++i, ++step)
+            {
+                auto index = step % static_cast<int>(m_stripAddresses.size() + 1);
+                auto sent = index < static_cast<int>(m_stripAddresses.size())
+                    ? sender.send(OSCMessage(m_stripAddresses[static_cast<size_t>(index)], getStripValue(index % OSCRemoteControl::SP_NumParameters, step)))
+                    : sender.send(OSCMessage(OSCAddressPattern("/placross/player/gain"), getStripValue(OSCRemoteControl::SP_Gain, step)));
+                if (sent)
+                    ++m_numSent;
+            }
+
+            if (tick % transportIntervalMs == 0)
+            {
+                auto command = static_cast<OSCRemoteControl::TransportCommand>((tick / transportIntervalMs) % OSCRemoteControl::TC_NumCommands);
+                if (sender.send(OSCMessage(OSCAddressPattern(String("/placross/player/") + transportAddresses[command]))))
+                {
+                    m_sentCommands.push_back(command);
+                    ++m_numSent;
+                }
+            }
+
+            nextMs += 1.0;
+            auto waitMs = nextMs - Time::getMillisecondCounterHiRes();
+            if (waitMs >= 1.0)
+                Thread::sleep(static_cast<int>(waitMs));
+        }
+
+        m_durationMs = Time::getMillisecondCounterHiRes() - startMs;
+    }
+
+    /** Once the thread has stopped. */
+    int getNumSent() const noexcept { return m_numSent; };
+    double getDurationMs() const noexcept { return m_durationMs; };
+    const std::vector<OSCRemoteControl::TransportCommand>& getSentCommands() const noexcept { return m_sentCommands; };
+
+private:
+    const int                                       m_port;
+    std::vector<OSCAddressPattern>                  m_stripAddresses;
+    int                                             m_numSent{ 0 };
+    double                                          m_durationMs{ 0.0 };
+    std::vector<OSCRemoteControl::TransportCommand> m_sentCommands;
+};
+
+//==============================================================================
+/*
+    A block as the engine runs it for remote controlled strips: the values received
+    are applied first, then every strip's processors process their output channel.
+*/
+class OSCLoadCallback : public AudioIODeviceCallback
+{
+public:
+    OSCLoadCallback(OSCRemoteControl& remote, AudioPlayerComponent& player)
+        : m_remote(remote), m_player(player)
+    {
+        for (auto channel = 0; channel < numChannels; ++channel)
+        {
+            m_processors.push_back(std::make_unique<HPFilterProcessor>());
+            m_processors.push_back(std::make_unique<LPFilterProcessor>());
+            m_processors.push_back(std::make_unique<GainProcessor>());
+            auto first = m_processors.end() - 3;
+            m_stripProcessors.push_back({ first[0].get(), first[1].get(), first[2].get() });
+        }
+    }
+
+    void audioDeviceIOCallback(const float** inputChannelData, int numInputChannels, float** outputChannelData, int numOutputChannels, int numSamples) override
+    {
+        ignoreUnused(inputChannelData, numInputChannels);
+
+        m_remote.applyParameters(m_stripProcessors, m_player);
+
+        for (auto ch = 0; ch < jmin(numOutputChannels, numChannels); ++ch)
+        {
+            AudioBuffer<float> buffer(&outputChannelData[ch], 1, numSamples);
+            buffer.clear();
+
+            auto const& processors = m_stripProcessors[static_cast<size_t>(ch)];
+            for (auto processor : { processors.highPass, processors.lowPass, processors.gain })
+                processor->processBlock(buffer, m_midi);
+        }
+    }
+
+    void audioDeviceAboutToStart(AudioIODevice* device) override
+    {
+        for (auto& processor : m_processors)
+            processor->prepareToPlay(device->getCurrentSampleRate(), device->getCurrentBufferSizeSamples());
+    }
+
+    void audioDeviceStopped() override {}
+
+    const ChannelStripEngine::ChannelProcessors& getStripProcessors(int channel) const { return m_stripProcessors[static_cast<size_t>(channel)]; };
+
+private:
+    OSCRemoteControl&                                       m_remote;
+    AudioPlayerComponent&                                   m_player;
+    std::vector<std::unique_ptr<ChannelStripProcessorBase>> m_processors;
+    std::vector<ChannelStripEngine::ChannelProcessors>      m_stripProcessors;
+    MidiBuffer                                              m_midi;
+};
+
+//==============================================================================
+static String getTimings(DiagnosticsAudioDevice& device)
+{
+    return String(device.getNumCallbacks()) + " callbacks, " + String(device.getNumOverruns()) + " overruns, "
+        + DiagnosticsReport::toString(DiagnosticsReport::getTiming(device.getCallbackDurationsMs()));
+}
+
+bool runOSCLoadCheck(DiagnosticsReport& report)
+{
+    auto blockDurationMs = 1000.0 * blockSize / sampleRate;
+    report.log(String(numChannels) + " remote controlled strips, " + String(messagesPerMs * 1000) + " messages per second over UDP on 127.0.0.1, blocks of "
+        + String(blockSize) + " samples (" + String(blockDurationMs, 2) + " ms)");
+
+    std::unique_ptr<OSCRemoteControl> remote;
+    std::unique_ptr<AudioPlayerComponent> player;
+    std::vector<OSCRemoteControl::TransportCommand> receivedCommands;    // message thread
+    {
+        const MessageManagerLock lock(Thread::getCurrentThread());
+        if (!lock.lockWasGained())
+            return false;
+
+        player = std::make_unique<AudioPlayerComponent>();
+        remote = std::make_unique<OSCRemoteControl>();
+        remote->onTransportCommand = [&receivedCommands](OSCRemoteControl::TransportCommand command) { receivedCommands.push_back(command); };
+
+        // a port in the dynamic range nothing else is likely to listen on
+        auto& random = Random::getSystemRandom();
+        for (auto attempt = 0; attempt < 20 && remote->getPort() == 0; ++attempt)
+            remote->setPort(49152 + random.nextInt(16000));
+    }
+
+    auto stopRemote = [&]
+    {
+        const MessageManagerLock lock;
+        remote.reset();
+        player.reset();
+    };
+
+    if (!report.expect(remote->getPort() != 0, "the remote control listens on a UDP port"))
+    {
+        stopRemote();
+        return false;
+    }
+
+    DiagnosticsAudioDevice device(numChannels, sampleRate, blockSize);
+    OSCLoadCallback callback(*remote, *player);
+
+    device.start(&callback);
+    Thread::sleep(2000);
+    device.stop();
+    auto idleMedianMs = DiagnosticsReport::getTiming(device.getCallbackDurationsMs()).medianMs;
+    report.log("without messages: " + getTimings(device));
+
+    OSCLoadSender sender(remote->getPort());
+    device.start(&callback);
+    sender.startThread();
+    Thread::sleep(3000);
+    sender.stopThread(2000);
+
+    // the last value of every parameter, sent once the load is off, has to be the one the processors end up with
+    OSCSender finalSender;
+    auto numFinalSent = 0;
+    if (finalSender.connect("127.0.0.1", remote->getPort()))
+    {
+        for (auto channel = 0; channel < numChannels; ++channel)
+            for (auto parameter = 0; parameter < OSCRemoteControl::SP_NumParameters; ++parameter)
+                if (finalSender.send(OSCMessage(getStripAddress(channel, parameter), getStripValue(parameter, channel * 7 + parameter))))
+                    ++numFinalSent;
+    }
+    Thread::sleep(500);
+    device.stop();
+
+    auto loaded = DiagnosticsReport::getTiming(device.getCallbackDurationsMs());
+    report.log("under load:       " + getTimings(device));
+    report.log(String(sender.getNumSent()) + " messages in " + String(sender.getDurationMs() / 1000.0, 2) + " s ("
+        + String(sender.getNumSent() * 1000.0 / jmax(sender.getDurationMs(), 1.0), 0) + " per second), " + String(remote->getNumReceived()) + " received, "
+        + String(remote->getNumCoalesced()) + " coalesced, " + String(remote->getNumRejected()) + " rejected");
+    report.log("callback median " + String(loaded.medianMs - idleMedianMs, 4) + " ms longer under load, "
+        + String(100.0 * loaded.medianMs / blockDurationMs, 1) + " % of the block duration");
+
+    // UDP may drop messages when the socket buffer fills up, how many depends on the machine, it is only reported
+    auto numSent = static_cast<uint32>(sender.getNumSent() + numFinalSent);
+    report.log(String(100.0 * remote->getNumReceived() / jmax(numSent, static_cast<uint32>(1)), 2) + " % of the " + String(numSent) + " messages arrived");
+    report.expect(remote->getNumRejected() == 0, "every message arriving is understood and queued");
+
+    auto allApplied = true;
+    for (auto channel = 0; channel < numChannels; ++channel)
+    {
+        auto parameters = ChannelStripEngine::getChannelParameters(callback.getStripProcessors(channel));
+        auto expected = [channel](int parameter) { return getStripValue(parameter, channel * 7 + parameter); };
+        allApplied = allApplied && parameters.highPassCutoff == expected(OSCRemoteControl::SP_HighPassFrequency) && parameters.highPassGain == expected(OSCRemoteControl::SP_HighPassGain)
+            && parameters.lowPassCutoff == expected(OSCRemoteControl::SP_LowPassFrequency) && parameters.lowPassGain == expected(OSCRemoteControl::SP_LowPassGain)
+            && parameters.gain == expected(OSCRemoteControl::SP_Gain);
+    }
+    report.expect(allApplied, "the last value sent for each strip parameter is the one applied");
+
+    // the timer hands the commands over to the message thread every 50 ms
+    Thread::sleep(200);
+    {
+        const MessageManagerLock lock;
+        report.expect(!sender.getSentCommands().empty() && receivedCommands == sender.getSentCommands(),
+            String(static_cast<int>(receivedCommands.size())) + " of " + String(static_cast<int>(sender.getSentCommands().size())) + " transport commands run, in the order sent");
+    }
+
+    stopRemote();
+
+    return report.getNumCheckFailures() == 0;
+}
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    RigStateDiagnostics.cpp
+    Created: 18 Oct 2026 7:29:56am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "DiagnosticChecks.h"
+
+#include "../Engine/RigSnapshot.h"
+#include "../ChannelStrip/ChannelStripProcessor.h"
+
+// offset of the first strip value behind the header and the routing bits
+static int getFirstStripValueOffset(const RigSnapshot& snapshot)
+{
+    return 14 + ((snapshot.numInputChannels + 7) / 8) * snapshot.numOutputChannels;
+}
+
+static RigSnapshot createRandomSnapshot(int numChannels, Random& random)
+{
+    RigSnapshot snapshot;
+    snapshot.numInputChannels = numChannels;
+    snapshot.numOutputChannels = numChannels;
+
+    for (auto out = 0; out < numChannels; ++out)
+        for (auto in = 0; in < numChannels; ++in)
+            if (random.nextInt(8) == 0)
+                snapshot.routing.insert(std::make_pair(in, out));
+
+    for (auto i = 0; i < numChannels; ++i)
+    {
+        ChannelStripEngine::ChannelParameters strip;
+        strip.highPassCutoff = 20.0f + 19980.0f * random.nextFloat();
+        strip.highPassGain = random.nextFloat();
+        strip.lowPassCutoff = 20.0f + 19980.0f * random.nextFloat();
+        strip.lowPassGain = random.nextFloat();
+        strip.gain = random.nextFloat();
+        snapshot.strips.push_back(strip);
+    }
+
+    snapshot.analyser.holdTimeMs = random.nextInt(5000);
+    snapshot.analyser.maxDB = -6.0f;
+    snapshot.analyser.minDB = -96.0f;
+    return snapshot;
+}
+
+static bool isEqual(const RigSnapshot& a, const RigSnapshot& b)
+{
+    if (a.numInputChannels != b.numInputChannels || a.numOutputChannels != b.numOutputChannels || a.routing != b.routing || a.strips.size() != b.strips.size())
+        return false;
+
+    for (size_t i = 0; i < a.strips.size(); ++i)
+        if (a.strips[i].highPassCutoff != b.strips[i].highPassCutoff || a.strips[i].highPassGain != b.strips[i].highPassGain
+            || a.strips[i].lowPassCutoff != b.strips[i].lowPassCutoff || a.strips[i].lowPassGain != b.strips[i].lowPassGain || a.strips[i].gain != b.strips[i].gain)
+            return false;
+
+    return a.analyser.holdTimeMs == b.analyser.holdTimeMs && a.analyser.minDB == b.analyser.minDB && a.analyser.maxDB == b.analyser.maxDB;
+}
+
+static void writeFloatAt(MemoryBlock& data, int offset, float value)
+{
+    uint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bits = ByteOrder::swapIfBigEndian(bits);
+    data.copyFrom(&bits, offset, sizeof(bits));
+}
+
+//==============================================================================
+static bool checkRoundTrips(DiagnosticsReport& report)
+{
+    Random random(21);
+    for (auto numChannels : { 1, 16, 64, 256 })
+    {
+        auto snapshot = createRandomSnapshot(numChannels, random);
+        MemoryBlock data;
+        RigSnapshot loaded;
+
+        auto save = DiagnosticsReport::measure(200, [&] { snapshot.toMemoryBlock(data); });
+        auto load = DiagnosticsReport::measure(200, [&] { loaded.fromMemory(data.getData(), data.getSize()); });
+
+        report.log(String(numChannels).paddedLeft(' ', 3) + " channels, " + String(static_cast<int>(data.getSize())) + " bytes: save " + DiagnosticsReport::toString(save));
+        report.log("                          load " + DiagnosticsReport::toString(load));
+        report.expect(isEqual(snapshot, loaded), String(numChannels) + " channels: the loaded snapshot equals the saved one");
+    }
+
+    return report.getNumCheckFailures() == 0;
+}
+
+static bool checkInvalidData(DiagnosticsReport& report)
+{
+    Random random(2100);
+    auto snapshot = createRandomSnapshot(16, random);
+    MemoryBlock data;
+    snapshot.toMemoryBlock(data);
+
+    // whatever is rejected has to leave the snapshot read into as it was
+    auto previous = createRandomSnapshot(4, random);
+    auto isRejected = [&previous](const MemoryBlock& candidate)
+    {
+        auto target = previous;
+        return !target.fromMemory(candidate.getData(), candidate.getSize()) && isEqual(target, previous);
+    };
+
+    auto allTruncationsRejected = true;
+    for (size_t size = 0; size < data.getSize(); ++size)
+        allTruncationsRejected = allTruncationsRejected && isRejected(MemoryBlock(data.getData(), size));
+    report.expect(allTruncationsRejected, "every truncation of the data is rejected");
+
+    auto wrongMagic = data;
+    wrongMagic[0] = static_cast<char>(wrongMagic[0] ^ 0x01);
+    report.expect(isRejected(wrongMagic), "a wrong magic number is rejected");
+
+    auto wrongVersion = data;
+    wrongVersion[4] = static_cast<char>(RigSnapshot::formatVersion + 1);
+    report.expect(isRejected(wrongVersion), "an unknown format version is rejected");
+
+    auto tooManyChannels = data;
+    tooManyChannels[8] = static_cast<char>((RigSnapshot::maxChannels + 1) & 0xff);
+    tooManyChannels[9] = static_cast<char>((RigSnapshot::maxChannels + 1) >> 8);
+    report.expect(isRejected(tooManyChannels), "more than " + String(RigSnapshot::maxChannels) + " channels are rejected");
+
+    auto firstStripValue = getFirstStripValueOffset(snapshot);
+    for (auto value : { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() })
+    {
+        auto nonFinite = data;
+        writeFloatAt(nonFinite, firstStripValue + 3 * static_cast<int>(sizeof(float)), value);
+        report.expect(isRejected(nonFinite), "a strip value of " + String(value) + " is rejected");
+
+        auto nonFiniteAnalyser = data;
+        writeFloatAt(nonFiniteAnalyser, static_cast<int>(data.getSize() - sizeof(float)), value);
+        report.expect(isRejected(nonFiniteAnalyser), "an analyser range of " + String(value) + " is rejected");
+    }
+
+    // values out of range are taken, clipped to the ranges of the processors' parameters
+    auto outOfRange = data;
+    writeFloatAt(outOfRange, firstStripValue, 1.0e9f);
+    writeFloatAt(outOfRange, firstStripValue + 4 * static_cast<int>(sizeof(float)), -5.0f);
+    writeFloatAt(outOfRange, static_cast<int>(data.getSize() - sizeof(float)), 1000.0f);
+    RigSnapshot clipped;
+    auto loaded = clipped.fromMemory(outOfRange.getData(), outOfRange.getSize());
+    report.expect(loaded && clipped.strips[0].highPassCutoff == 20000.0f && clipped.strips[0].gain == 0.0f && clipped.analyser.maxDB == 24.0f,
+        "out of range values are clipped to the parameter ranges");
+
+    return report.getNumCheckFailures() == 0;
+}
+
+static std::vector<float> getParameterValues(ChannelStripProcessorBase& processor)
+{
+    std::vector<float> values;
+    for (auto param : processor.getParameters())
+        if (auto fParam = dynamic_cast<AudioParameterFloat*>(param))
+            values.push_back(fParam->get());
+    return values;
+}
+
+static bool checkProcessorState(DiagnosticsReport& report)
+{
+    HPFilterProcessor saved;
+    saved.getParameters()[0]->setValueNotifyingHost(0.7f);
+    saved.getParameters()[1]->setValueNotifyingHost(0.3f);
+
+    MemoryBlock state;
+    saved.getStateInformation(state);
+
+    HPFilterProcessor restored;
+    restored.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    report.expect(getParameterValues(restored) == getParameterValues(saved), "a processor's state restores its parameters");
+
+    // the first value follows magic, type and parameter count, the second one would still be valid
+    auto nonFinite = state;
+    writeFloatAt(nonFinite, 6, std::numeric_limits<float>::quiet_NaN());
+    HPFilterProcessor untouched;
+    auto defaults = getParameterValues(untouched);
+    untouched.setStateInformation(nonFinite.getData(), static_cast<int>(nonFinite.getSize()));
+    report.expect(getParameterValues(untouched) == defaults, "a processor state with a value that is not finite is rejected as a whole");
+
+    return report.getNumCheckFailures() == 0;
+}
+
+bool runRigStateCheck(DiagnosticsReport& report)
+{
+    auto passed = checkRoundTrips(report);
+    passed = checkInvalidData(report) && passed;
+    passed = checkProcessorState(report) && passed;
+    return passed;
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    StripChainDiagnostics.cpp
+    Created: 18 Oct 2026 5:51:09am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "DiagnosticChecks.h"
+#include "DiagnosticsAudioDevice.h"
+#include "DiagnosticStrips.h"
+
+static constexpr double sampleRate = 48000.0;
+static constexpr int numStrips = 16;
+static constexpr int numBlocks = 500;
+
+// both run the same coefficients, the graph's processors compute theirs in single precision
+static constexpr float pathTolerance = 1.0e-3f;
+
+bool runStripChainCheck(DiagnosticsReport& report)
+{
+    report.log(String(numStrips) + " strips with the default topology, processed one after another");
+
+    for (auto blockSize : { 32, 256, 1024 })
+    {
+        DiagnosticsAudioDevice device(numStrips, sampleRate, blockSize);
+        DiagnosticStrips strips;
+        if (!strips.create(numStrips, device, blockSize))
+            return false;
+
+        AudioBuffer<float> input(numStrips, blockSize);
+        Random random(blockSize);
+        for (auto i = 0; i < numStrips; ++i)
+            for (auto sample = 0; sample < blockSize; ++sample)
+                input.setSample(i, sample, random.nextFloat() * 2.0f - 1.0f);
+
+        auto processBlocks = [&](AudioBuffer<float>& output, bool compiledChainEnabled)
+        {
+            strips.setCompiledChainEnabled(compiledChainEnabled);
+            strips.resetProcessingState();
+
+            return DiagnosticsReport::measure(numBlocks, [&] {
+                for (auto i = 0; i < numStrips; ++i)
+                    strips.process(i, input.getReadPointer(i), output.getWritePointer(i), blockSize);
+            });
+        };
+
+        AudioBuffer<float> graphOutput(numStrips, blockSize);
+        AudioBuffer<float> chainOutput(numStrips, blockSize);
+        auto graph = processBlocks(graphOutput, false);
+        auto chain = processBlocks(chainOutput, true);
+
+        report.log(String(blockSize).paddedLeft(' ', 4) + " samples: graph " + DiagnosticsReport::toString(graph));
+        report.log("              chain " + DiagnosticsReport::toString(chain)
+            + ", speedup " + String(graph.medianMs / jmax(chain.medianMs, 0.000001), 2));
+
+        auto maxDifference = 0.0f;
+        for (auto i = 0; i < numStrips; ++i)
+            for (auto sample = 0; sample < blockSize; ++sample)
+                maxDifference = jmax(maxDifference, std::abs(graphOutput.getSample(i, sample) - chainOutput.getSample(i, sample)));
+        report.expect(maxDifference <= pathTolerance, String(blockSize) + " samples: chain and graph output differ by at most " + String(maxDifference, 6));
+    }
+
+    return report.getNumCheckFailures() == 0;
+}
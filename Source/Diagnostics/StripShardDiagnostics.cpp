@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    StripShardDiagnostics.cpp
+    Created: 18 Oct 2026 6:37:25am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "DiagnosticChecks.h"
+#include "DiagnosticsAudioDevice.h"
+
+#include "../Engine/StripShardHost.h"
+
+static constexpr double sampleRate = 48000.0;
+static constexpr int blockSize = 256;
+static constexpr int numChannels = 32;
+static constexpr int numShards = 2;
+
+//==============================================================================
+/*
+    Drives the shard host from the diagnostics device's callback thread, as the
+    device thread would, and keeps track of channels coming back silent.
+*/
+class StripShardCallback : public AudioIODeviceCallback
+{
+public:
+    explicit StripShardCallback(StripShardHost& host)
+        : m_host(host), m_inputs(numChannels, blockSize)
+    {
+        Random random(numChannels);
+        for (auto ch = 0; ch < numChannels; ++ch)
+            for (auto i = 0; i < blockSize; ++i)
+                m_inputs.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        // a highpass at 20 Hz passing everything above it
+        for (auto& parameters : m_parameters)
+        {
+            parameters.highPassCutoff = 20.0f;
+            parameters.highPassGain = 1.0f;
+        }
+    }
+
+    void audioDeviceIOCallback(const float** inputChannelData, int numInputChannels, float** outputChannelData, int numOutputChannels, int numSamples) override
+    {
+        ignoreUnused(inputChannelData, numInputChannels);
+
+        numOutputChannels = jmin(numOutputChannels, numChannels);
+        m_host.process(m_inputs.getArrayOfReadPointers(), outputChannelData, m_parameters.data(), numOutputChannels, numSamples);
+
+        for (auto ch = 0; ch < numOutputChannels; ++ch)
+            if (FloatVectorOperations::findMaximum(outputChannelData[ch], numSamples) <= 0.0f)
+                m_silentChannelBlocks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void audioDeviceAboutToStart(AudioIODevice*) override {}
+    void audioDeviceStopped() override {}
+
+    int getSilentChannelBlocks() const noexcept { return m_silentChannelBlocks.load(); };
+
+private:
+    StripShardHost&     m_host;
+    AudioBuffer<float>  m_inputs;
+    std::array<ChannelStripEngine::ChannelParameters, numChannels>  m_parameters;
+    std::atomic<int>    m_silentChannelBlocks{ 0 };
+};
+
+//==============================================================================
+bool runStripShardCheck(DiagnosticsReport& report)
+{
+    auto blockDurationMs = 1000.0 * blockSize / sampleRate;
+    report.log(String(numChannels) + " channels on " + String(numShards) + " worker processes, blocks of " + String(blockSize) + " samples ("
+        + String(blockDurationMs, 2) + " ms)");
+
+    StripShardHost host;
+    {
+        const MessageManagerLock lock(Thread::getCurrentThread());
+        if (!lock.lockWasGained())
+            return false;
+
+        if (!report.expect(host.start(numShards, numChannels, blockSize, sampleRate), "the worker processes are started"))
+            return false;
+    }
+
+    DiagnosticsAudioDevice device(numChannels, sampleRate, blockSize);
+    StripShardCallback callback(host);
+
+    // the workers need a moment to attach to their shared memory, blocks late meanwhile are not counted against them
+    device.start(&callback);
+    Thread::sleep(1000);
+    auto lateBefore = host.getNumLateBlocks();
+    auto droppedBefore = host.getNumDroppedBlocks();
+    auto silentBefore = callback.getSilentChannelBlocks();
+    auto callbacksBefore = device.getNumCallbacks();
+    Thread::sleep(3000);
+    auto lateBlocks = host.getNumLateBlocks() - lateBefore;
+    auto droppedBlocks = host.getNumDroppedBlocks() - droppedBefore;
+    auto silentChannelBlocks = callback.getSilentChannelBlocks() - silentBefore;
+    auto numCallbacks = device.getNumCallbacks() - callbacksBefore;
+    device.stop();
+
+    // how many blocks the workers miss depends on the machine and its load, it is only reported
+    auto shardBlocks = jmax(1, numCallbacks * numShards);
+    report.log("paced like a device: " + String(numCallbacks) + " callbacks, " + String(lateBlocks) + " late and " + String(droppedBlocks) + " dropped blocks ("
+        + String(100.0 * (lateBlocks + droppedBlocks) / shardBlocks, 2) + " % of the shard blocks), "
+        + String(device.getNumOverruns()) + " overruns, callbacks " + DiagnosticsReport::toString(DiagnosticsReport::getTiming(device.getCallbackDurationsMs())));
+    report.expect(silentChannelBlocks <= (lateBlocks + droppedBlocks) * numChannels, "only the channels of late or dropped blocks come back silent");
+
+    // back to back calls leave the workers no time at all, the host has to count those blocks late instead of waiting for them
+    AudioBuffer<float> outputs(numChannels, blockSize);
+    auto lateBeforeBurst = host.getNumLateBlocks();
+    auto burst = DiagnosticsReport::measure(200, [&] { callback.audioDeviceIOCallback(nullptr, 0, outputs.getArrayOfWritePointers(), numChannels, blockSize); });
+    report.log("back to back: " + String(host.getNumLateBlocks() - lateBeforeBurst) + " late and " + String(host.getNumDroppedBlocks()) + " dropped blocks, calls "
+        + DiagnosticsReport::toString(burst) + ", the longest " + String(100.0 * burst.maximumMs / blockDurationMs, 1) + " % of the block duration");
+
+    report.log(host.getReport());
+    report.expect(host.getNumFailedShards() == 0, "no worker process failed");
+
+    const MessageManagerLock lock;
+    host.stop();
+
+    return report.getNumCheckFailures() == 0;
+}
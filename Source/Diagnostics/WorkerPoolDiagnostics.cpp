@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    WorkerPoolDiagnostics.cpp
+    Created: 18 Oct 2026 4:31:14am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "DiagnosticChecks.h"
+#include "DiagnosticsAudioDevice.h"
+#include "DiagnosticStrips.h"
+
+#include "../Engine/RealtimeWorkerPool.h"
+
+static constexpr double sampleRate = 48000.0;
+static constexpr int blockSize = 256;
+static constexpr int numBlocks = 500;
+
+struct StripTaskContext
+{
+    DiagnosticStrips*               strips;
+    const float* const*             inputs;
+    float* const*                   outputs;
+    int                             numSamples;
+};
+
+static void processStripTask(void* context, int channel)
+{
+    auto stripTaskContext = static_cast<StripTaskContext*>(context);
+    stripTaskContext->strips->process(channel, stripTaskContext->inputs[channel], stripTaskContext->outputs[channel], stripTaskContext->numSamples);
+}
+
+bool runWorkerPoolScalingCheck(DiagnosticsReport& report)
+{
+    DiagnosticsAudioDevice device(64, sampleRate, blockSize);
+    RealtimeWorkerPool pool;
+    auto options = RealtimeWorkerPool::getDefaultOptions();
+
+    report.log("blocks of " + String(blockSize) + " samples (" + String(1000.0 * blockSize / sampleRate, 2) + " ms), "
+        + String(options.numWorkerThreads) + " worker threads, at least " + String(options.minTasksForParallel) + " strips to go parallel");
+
+    for (auto numOutputs : { 2, 4, 8, 16, 32, 64 })
+    {
+        DiagnosticStrips strips;
+        if (!strips.create(numOutputs, device, blockSize))
+            return false;
+
+        AudioBuffer<float> input(numOutputs, blockSize);
+        Random random(numOutputs);
+        for (auto i = 0; i < numOutputs; ++i)
+            for (auto sample = 0; sample < blockSize; ++sample)
+                input.setSample(i, sample, random.nextFloat() * 2.0f - 1.0f);
+
+        auto processBlocks = [&](AudioBuffer<float>& output, int numWorkerThreads)
+        {
+            options.numWorkerThreads = numWorkerThreads;
+            pool.setOptions(options);
+
+            strips.resetProcessingState();
+
+            StripTaskContext stripTaskContext{ &strips, input.getArrayOfReadPointers(), output.getArrayOfWritePointers(), blockSize };
+            return DiagnosticsReport::measure(numBlocks, [&] { pool.run(&processStripTask, &stripTaskContext, numOutputs); });
+        };
+
+        AudioBuffer<float> serialOutput(numOutputs, blockSize);
+        AudioBuffer<float> parallelOutput(numOutputs, blockSize);
+        auto serial = processBlocks(serialOutput, 0);
+        auto parallel = processBlocks(parallelOutput, RealtimeWorkerPool::getDefaultOptions().numWorkerThreads);
+
+        report.log(String(numOutputs).paddedLeft(' ', 3) + " outputs: device thread only " + DiagnosticsReport::toString(serial));
+        report.log("             worker pool " + DiagnosticsReport::toString(parallel)
+            + ", speedup " + String(serial.medianMs / jmax(parallel.medianMs, 0.000001), 2));
+
+        auto matches = true;
+        for (auto i = 0; i < numOutputs; ++i)
+            for (auto sample = 0; sample < blockSize; ++sample)
+                matches = matches && serialOutput.getSample(i, sample) == parallelOutput.getSample(i, sample);
+        report.expect(matches, String(numOutputs) + " outputs processed by the pool match the device thread alone");
+    }
+
+    return report.getNumCheckFailures() == 0;
+}
@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    ChannelActivityGate.cpp
+    Created: 17 Oct 2026 10:31:07pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "ChannelActivityGate.h"
+
+ChannelActivityGate::ChannelActivityGate()
+{
+}
+
+ChannelActivityGate::~ChannelActivityGate()
+{
+}
+
+void ChannelActivityGate::prepare(int maxChannels)
+{
+    // mute and solo survive a re-prepare with the same or a larger channel count
+    auto numElements = static_cast<size_t>(jmax(1, maxChannels));
+    std::unique_ptr<std::atomic<bool>[]> muted(new std::atomic<bool>[numElements]);
+    std::unique_ptr<std::atomic<bool>[]> soloed(new std::atomic<bool>[numElements]);
+    for (auto i = 0; i < static_cast<int>(numElements); ++i)
+    {
+        muted[i] = i < m_maxChannels && m_muted[i].load();
+        soloed[i] = i < m_maxChannels && m_soloed[i].load();
+    }
+    m_muted = std::move(muted);
+    m_soloed = std::move(soloed);
+
+    m_maxChannels = jmax(0, maxChannels);
+
+    m_active.calloc(numElements);
+    m_becameInactive.calloc(numElements);
+    m_inputSilent.calloc(numElements);
+    m_tailRunning.calloc(numElements);
+}
+
+void ChannelActivityGate::setChannelMuted(int channel, bool muted) noexcept
+{
+    if (isPositiveAndBelow(channel, m_maxChannels))
+        m_muted[channel] = muted;
+}
+
+bool ChannelActivityGate::isChannelMuted(int channel) const noexcept
+{
+    return isPositiveAndBelow(channel, m_maxChannels) && m_muted[channel].load();
+}
+
+void ChannelActivityGate::setChannelSoloed(int channel, bool soloed) noexcept
+{
+    if (isPositiveAndBelow(channel, m_maxChannels))
+        m_soloed[channel] = soloed;
+}
+
+bool ChannelActivityGate::isChannelSoloed(int channel) const noexcept
+{
+    return isPositiveAndBelow(channel, m_maxChannels) && m_soloed[channel].load();
+}
+
+bool ChannelActivityGate::isSilent(const float* data, int numSamples) noexcept
+{
+    auto range = FloatVectorOperations::findMinAndMax(data, numSamples);
+    return range.getStart() > -silenceThreshold && range.getEnd() < silenceThreshold;
+}
+
+const bool* ChannelActivityGate::beginRange(const float* const* inputs, int numChannels, int numSamples) noexcept
+{
+    numChannels = jmin(numChannels, m_maxChannels);
+
+    auto anySoloed = false;
+    for (auto ch = 0; ch < numChannels && !anySoloed; ++ch)
+        anySoloed = m_soloed[ch].load(std::memory_order_relaxed);
+
+    for (auto ch = 0; ch < numChannels; ++ch)
+    {
+        auto wasActive = m_active[ch];
+
+        auto audible = !m_muted[ch].load(std::memory_order_relaxed) && (!anySoloed || m_soloed[ch].load(std::memory_order_relaxed));
+        if (audible)
+        {
+            m_inputSilent[ch] = isSilent(inputs[ch], numSamples);
+            if (!m_inputSilent[ch])
+                m_tailRunning[ch] = true;
+
+            m_active[ch] = m_tailRunning[ch];
+        }
+        else
+        {
+            // muting cuts off the tail as well
+            m_tailRunning[ch] = false;
+            m_active[ch] = false;
+        }
+
+        m_becameInactive[ch] = wasActive && !m_active[ch];
+    }
+
+    return m_active.get();
+}
+
+void ChannelActivityGate::endRange(const float* const* outputs, int numChannels, int numSamples) noexcept
+{
+    numChannels = jmin(numChannels, m_maxChannels);
+
+    // a strip fed with silence is done once its output has decayed below the threshold as well
+    m_anyTailRunning = false;
+    for (auto ch = 0; ch < numChannels; ++ch)
+    {
+        if (m_active[ch] && m_inputSilent[ch] && isSilent(outputs[ch], numSamples))
+            m_tailRunning[ch] = false;
+
+        m_anyTailRunning = m_anyTailRunning || m_tailRunning[ch];
+    }
+}
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    ChannelActivityGate.h
+    Created: 17 Oct 2026 10:31:07pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Decides per channel and range of samples whether a strip has to be processed at all.
+
+    A channel is skipped when it is muted (or another one is soloed), or when its input
+    has been silent and the strip's decay tail has died away, which is taken from its
+    output dropping below the silence threshold as well. Skipped channels are expected
+    to output zeros and to have their filter state cleared, so they come back from
+    silence without stale state and do not keep decaying into denormals.
+*/
+class ChannelActivityGate
+{
+public:
+    ChannelActivityGate();
+    ~ChannelActivityGate();
+
+    /** -120 dBFS, for both the input peak and the tail of the output. */
+    static constexpr float silenceThreshold = 1.0e-6f;
+
+    /** Not to be called while the audio thread is using the gate. */
+    void prepare(int maxChannels);
+
+    //==============================================================================
+    /** Any thread. */
+    void setChannelMuted(int channel, bool muted) noexcept;
+    bool isChannelMuted(int channel) const noexcept;
+    void setChannelSoloed(int channel, bool soloed) noexcept;
+    bool isChannelSoloed(int channel) const noexcept;
+
+    //==============================================================================
+    /** Audio thread only. Returns per channel if it has to be processed for this range. */
+    const bool* beginRange(const float* const* inputs, int numChannels, int numSamples) noexcept;
+    /** Audio thread only. Takes the processed outputs of the range to track the decay tails. */
+    void endRange(const float* const* outputs, int numChannels, int numSamples) noexcept;
+
+    bool isChannelActive(int channel) const noexcept { return m_active[channel]; };
+    /** True for the range a channel is skipped for the first time, when its state has to be cleared. */
+    bool hasChannelBecomeInactive(int channel) const noexcept { return m_becameInactive[channel]; };
+    /** False once all strips of the last range are done with their decay tails (or muted). */
+    bool hasRunningTails() const noexcept { return m_anyTailRunning; };
+
+private:
+    static bool isSilent(const float* data, int numSamples) noexcept;
+
+    //==============================================================================
+    int     m_maxChannels{ 0 };
+    bool    m_anyTailRunning{ false };
+
+    std::unique_ptr<std::atomic<bool>[]>    m_muted;
+    std::unique_ptr<std::atomic<bool>[]>    m_soloed;
+
+    HeapBlock<bool>     m_active;
+    HeapBlock<bool>     m_becameInactive;
+    HeapBlock<bool>     m_inputSilent;
+    HeapBlock<bool>     m_tailRunning;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChannelActivityGate)
+};
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    ChannelLevelMeter.cpp
+    Created: 17 Oct 2026 8:12:40pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "ChannelLevelMeter.h"
+
+ChannelLevelMeter::ChannelLevelMeter()
+{
+}
+
+ChannelLevelMeter::~ChannelLevelMeter()
+{
+}
+
+void ChannelLevelMeter::prepare(int maxChannels)
+{
+    m_maxChannels = jmax(0, maxChannels);
+
+    auto numElements = static_cast<size_t>(jmax(1, m_maxChannels));
+    m_blockPeaks.calloc(numElements);
+    m_blockSumsOfSquares.calloc(numElements);
+
+    m_peakLevels.reset(new std::atomic<float>[numElements]);
+    m_rmsLevels.reset(new std::atomic<float>[numElements]);
+    for (size_t i = 0; i < numElements; ++i)
+    {
+        m_peakLevels[i] = 0.0f;
+        m_rmsLevels[i] = 0.0f;
+    }
+}
+
+void ChannelLevelMeter::beginBlock(int numChannels) noexcept
+{
+    m_blockChannels = jmin(numChannels, m_maxChannels);
+    m_blockSamples = 0;
+
+    FloatVectorOperations::clear(m_blockPeaks.get(), m_blockChannels);
+    for (int ch = 0; ch < m_blockChannels; ++ch)
+        m_blockSumsOfSquares[ch] = 0.0;
+}
+
+void ChannelLevelMeter::accumulate(const float* const* channels, int numSamples) noexcept
+{
+    for (int ch = 0; ch < m_blockChannels; ++ch)
+    {
+        auto data = channels[ch];
+
+        auto range = FloatVectorOperations::findMinAndMax(data, numSamples);
+        m_blockPeaks[ch] = jmax(m_blockPeaks[ch], -range.getStart(), range.getEnd());
+
+        auto sumOfSquares = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+            sumOfSquares += data[i] * data[i];
+        m_blockSumsOfSquares[ch] += sumOfSquares;
+    }
+
+    m_blockSamples += numSamples;
+}
+
+void ChannelLevelMeter::endBlock() noexcept
+{
+    if (m_blockSamples <= 0)
+        return;
+
+    for (int ch = 0; ch < m_blockChannels; ++ch)
+    {
+        m_peakLevels[ch] = m_blockPeaks[ch];
+        m_rmsLevels[ch] = static_cast<float>(std::sqrt(m_blockSumsOfSquares[ch] / m_blockSamples));
+    }
+}
+
+float ChannelLevelMeter::getPeakLevel(int channel) const noexcept
+{
+    return isPositiveAndBelow(channel, m_maxChannels) ? m_peakLevels[channel].load() : 0.0f;
+}
+
+float ChannelLevelMeter::getRMSLevel(int channel) const noexcept
+{
+    return isPositiveAndBelow(channel, m_maxChannels) ? m_rmsLevels[channel].load() : 0.0f;
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    ChannelLevelMeter.h
+    Created: 17 Oct 2026 8:12:40pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Peak and RMS level per channel of the most recent block. The audio thread
+    accumulates a block in one or several consecutive ranges and publishes the
+    result in endBlock, from where any thread can read it.
+*/
+class ChannelLevelMeter
+{
+public:
+    ChannelLevelMeter();
+    ~ChannelLevelMeter();
+
+    /** Not to be called while the audio thread is metering. */
+    void prepare(int maxChannels);
+
+    //==============================================================================
+    /** Audio thread only. */
+    void beginBlock(int numChannels) noexcept;
+    void accumulate(const float* const* channels, int numSamples) noexcept;
+    void endBlock() noexcept;
+
+    //==============================================================================
+    int getNumChannels() const noexcept { return m_maxChannels; };
+    float getPeakLevel(int channel) const noexcept;
+    float getRMSLevel(int channel) const noexcept;
+
+private:
+    //==============================================================================
+    int     m_maxChannels{ 0 };
+    int     m_blockChannels{ 0 };
+    int     m_blockSamples{ 0 };
+
+    HeapBlock<float>    m_blockPeaks;
+    HeapBlock<double>   m_blockSumsOfSquares;
+
+    std::unique_ptr<std::atomic<float>[]>   m_peakLevels;
+    std::unique_ptr<std::atomic<float>[]>   m_rmsLevels;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChannelLevelMeter)
+};
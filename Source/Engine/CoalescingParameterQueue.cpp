@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    CoalescingParameterQueue.cpp
+    Created: 18 Oct 2026 4:21:37am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "CoalescingParameterQueue.h"
+
+CoalescingParameterQueue::CoalescingParameterQueue(int numParameters)
+    : m_numParameters(jmax(1, numParameters)),
+    m_slots(new Slot[static_cast<size_t>(jmax(1, numParameters))]),
+    m_fifo(2 * jmax(1, numParameters) + 1)
+{
+    m_queuedParameters.allocate(static_cast<size_t>(m_fifo.getTotalSize()), true);
+}
+
+CoalescingParameterQueue::~CoalescingParameterQueue()
+{
+}
+
+void CoalescingParameterQueue::push(int parameter, float value) noexcept
+{
+    if (!isPositiveAndBelow(parameter, m_numParameters))
+    {
+        jassertfalse;
+        return;
+    }
+
+    m_numPushed.fetch_add(1, std::memory_order_relaxed);
+
+    auto& slot = m_slots[static_cast<size_t>(parameter)];
+    slot.value.store(value);
+    if (slot.queued.exchange(true))
+    {
+        m_numCoalesced.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // a parameter is queued at most once, plus once more while a drain has it cleared but not yet released, so there is always room for it
+    int start1, size1, start2, size2;
+    m_fifo.prepareToWrite(1, start1, size1, start2, size2);
+    jassert(size1 + size2 == 1);
+    if (size1 + size2 < 1)
+        return;
+
+    m_queuedParameters[size1 > 0 ? start1 : start2] = parameter;
+    m_fifo.finishedWrite(1);
+}
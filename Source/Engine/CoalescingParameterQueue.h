@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    CoalescingParameterQueue.h
+    Created: 18 Oct 2026 4:21:37am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Lock-free handover of parameter values from one producer thread to one consumer
+    thread, keeping only the latest value of each parameter.
+
+    Every parameter has a fixed slot holding its value. Only the first update of a
+    slot since the consumer last took it queues the parameter, any further update
+    just overwrites the value. So however fast updates come in, the queue never
+    overflows and the consumer handles each parameter at most once per drain.
+    Nothing is allocated after construction.
+*/
+class CoalescingParameterQueue
+{
+public:
+    explicit CoalescingParameterQueue(int numParameters);
+    ~CoalescingParameterQueue();
+
+    int getNumParameters() const noexcept { return m_numParameters; };
+
+    /** Producer thread only. */
+    void push(int parameter, float value) noexcept;
+
+    /** Consumer thread only. Calls handler(parameter, value) with the latest value of each
+        parameter updated since the last drain, returns the number of parameters handled.
+        Updates coming in meanwhile are left for the next drain. */
+    template <typename Handler>
+    int drain(Handler&& handler) noexcept
+    {
+        auto numReady = m_fifo.getNumReady();
+        if (numReady == 0)
+            return 0;
+
+        int start1, size1, start2, size2;
+        m_fifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+        auto handle = [this, &handler](int start, int size)
+        {
+            for (auto i = start; i < start + size; ++i)
+            {
+                auto parameter = m_queuedParameters[i];
+                auto& slot = m_slots[static_cast<size_t>(parameter)];
+
+                // cleared before reading, so an update racing with this one queues the parameter again
+                slot.queued.store(false);
+                handler(parameter, slot.value.load());
+            }
+        };
+        handle(start1, size1);
+        handle(start2, size2);
+
+        m_fifo.finishedRead(size1 + size2);
+        return numReady;
+    }
+
+    /** Any thread. Number of updates pushed, and of those that only overwrote a value still queued. */
+    uint32 getNumPushed() const noexcept { return m_numPushed.load(std::memory_order_relaxed); };
+    uint32 getNumCoalesced() const noexcept { return m_numCoalesced.load(std::memory_order_relaxed); };
+
+private:
+    struct Slot
+    {
+        std::atomic<float>  value{ 0.0f };
+        std::atomic<bool>   queued{ false };
+    };
+
+    const int                   m_numParameters;
+    std::unique_ptr<Slot[]>     m_slots;
+    AbstractFifo                m_fifo;     // twice the parameters, plus the entry a full AbstractFifo always keeps free
+    HeapBlock<int>              m_queuedParameters;
+
+    std::atomic<uint32>         m_numPushed{ 0 };
+    std::atomic<uint32>         m_numCoalesced{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CoalescingParameterQueue)
+};
@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    EngineConfiguration.h
+    Created: 17 Oct 2026 5:31:18pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "../ChannelStrip/ChannelStripComponent.h"
+#include "../ChannelStrip/ChannelStripEngine.h"
+
+// the most output channels (and so strips) the engine and its remote controls are set up for
+static constexpr int MAX_SUPPORTED_OUTPUTS = 256;
+
+//==============================================================================
+/*
+    Immutable description of what the audio thread has to process. It is built on
+    the message thread whenever the channel setup changes and handed to the audio
+    thread as a whole through a RealtimeSnapshotPublisher, so the audio thread never
+    sees the strip components themselves being added or removed.
+
+    The strips referenced here are owned by the content component and are not
+    destroyed while a configuration referencing them might still be in use.
+*/
+struct EngineConfiguration
+{
+    EngineConfiguration(uint32 configurationVersion, int inputChannelCount, int outputChannelCount)
+        : version(configurationVersion), numInputChannels(inputChannelCount), numOutputChannels(outputChannelCount)
+    {
+    }
+
+    const uint32    version;
+    const int       numInputChannels;
+    const int       numOutputChannels;
+
+    std::vector<ChannelStripComponent*>                 strips;             // one per output channel
+    std::vector<ChannelStripEngine::ChannelProcessors>  stripProcessors;    // one per output channel, processors outside a strip's topology left out
+    std::vector<bool>                                   stripsWithCustomTopology;   // one per output channel, processed by the strip's own chain instead of the strip engine once it is compiled
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineConfiguration)
+};
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    FixedBlockAdapter.cpp
+    Created: 17 Oct 2026 9:58:14pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "FixedBlockAdapter.h"
+
+FixedBlockAdapter::FixedBlockAdapter(RenderFunction renderFunction, void* context)
+    : m_renderFunction(renderFunction), m_renderContext(context)
+{
+}
+
+FixedBlockAdapter::~FixedBlockAdapter()
+{
+}
+
+int FixedBlockAdapter::calculateLatencySamples(int deviceBlockSize, int internalBlockSize) noexcept
+{
+    if (deviceBlockSize <= 0 || internalBlockSize <= 0)
+        return 0;
+
+    auto a = deviceBlockSize;
+    auto b = internalBlockSize;
+    while (b != 0)
+    {
+        auto r = a % b;
+        a = b;
+        b = r;
+    }
+
+    return internalBlockSize - a;
+}
+
+void FixedBlockAdapter::prepare(int numChannels, int internalBlockSize, int deviceBlockSize)
+{
+    m_numChannels = jmax(0, numChannels);
+    m_internalBlockSize = jmax(1, internalBlockSize);
+    m_deviceBlockSize = jmax(1, deviceBlockSize);
+
+    // the fifo never holds more than the latency (< one internal block), one device chunk and one internal block
+    auto capacity = 2 * m_internalBlockSize + m_deviceBlockSize;
+    m_renderBuffer.setSize(m_numChannels, m_internalBlockSize, false, true, false);
+    m_fifoBuffer.setSize(m_numChannels, capacity + 1, false, true, false);
+    m_fifo.setTotalSize(capacity + 1);
+
+    reset();
+}
+
+void FixedBlockAdapter::reset() noexcept
+{
+    m_fifo.reset();
+    m_fifoBuffer.clear();
+    m_pendingSamples = 0;
+
+    // prime with the silence that makes up the latency
+    auto latencySamples = calculateLatencySamples(m_deviceBlockSize, m_internalBlockSize);
+    m_fifo.finishedWrite(latencySamples);
+    m_latencySamples = latencySamples;
+}
+
+void FixedBlockAdapter::process(AudioBuffer<float>& outputBuffer, int startSample, int numSamples) noexcept
+{
+    // device blocks larger than what was prepared for are taken in chunks, so the fifo cannot overflow
+    for (auto offset = 0; offset < numSamples; offset += m_deviceBlockSize)
+        processChunk(outputBuffer, startSample + offset, jmin(m_deviceBlockSize, numSamples - offset));
+}
+
+void FixedBlockAdapter::processChunk(AudioBuffer<float>& outputBuffer, int startSample, int numSamples) noexcept
+{
+    auto numChannels = jmin(m_numChannels, outputBuffer.getNumChannels());
+
+    // render as many full internal blocks as the device has consumed samples for ...
+    m_pendingSamples += numSamples;
+    while (m_pendingSamples >= m_internalBlockSize && m_fifo.getFreeSpace() >= m_internalBlockSize)
+    {
+        m_renderFunction(m_renderContext, m_renderBuffer, m_internalBlockSize);
+
+        int start1, size1, start2, size2;
+        m_fifo.prepareToWrite(m_internalBlockSize, start1, size1, start2, size2);
+        for (auto i = 0; i < m_numChannels; ++i)
+        {
+            if (size1 > 0)
+                m_fifoBuffer.copyFrom(i, start1, m_renderBuffer, i, 0, size1);
+            if (size2 > 0)
+                m_fifoBuffer.copyFrom(i, start2, m_renderBuffer, i, size1, size2);
+        }
+        m_fifo.finishedWrite(size1 + size2);
+
+        m_pendingSamples -= m_internalBlockSize;
+    }
+
+    // ... and hand out what the device asks for
+    int start1, size1, start2, size2;
+    m_fifo.prepareToRead(numSamples, start1, size1, start2, size2);
+    for (auto i = 0; i < numChannels; ++i)
+    {
+        if (size1 > 0)
+            outputBuffer.copyFrom(i, startSample, m_fifoBuffer, i, start1, size1);
+        if (size2 > 0)
+            outputBuffer.copyFrom(i, startSample + size1, m_fifoBuffer, i, start2, size2);
+    }
+    m_fifo.finishedRead(size1 + size2);
+
+    for (auto i = numChannels; i < outputBuffer.getNumChannels(); ++i)
+        outputBuffer.clear(i, startSample, numSamples);
+
+    // an irregular device block made the fifo run dry, what is missing is output as silence and adds to the latency
+    auto numSamplesMissing = numSamples - (size1 + size2);
+    if (numSamplesMissing > 0)
+    {
+        for (auto i = 0; i < numChannels; ++i)
+            outputBuffer.clear(i, startSample + size1 + size2, numSamplesMissing);
+
+        m_latencySamples += numSamplesMissing;
+        m_underruns++;
+    }
+}
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    FixedBlockAdapter.h
+    Created: 17 Oct 2026 9:58:14pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Decouples the block size the engine renders with from what the device asks for.
+    Device callbacks of any size are served from a pre-allocated FIFO that is refilled
+    in blocks of exactly the internal block size.
+
+    An internal block is only rendered once the device has consumed as many samples
+    as the block holds, the same timing processing device input would have. That keeps
+    the work per callback deterministic and requires the FIFO to be primed with
+    internalBlockSize - gcd(deviceBlockSize, internalBlockSize) samples of silence, which
+    is the latency the adapter adds. Should the device deliver irregular block sizes and
+    the FIFO run dry, the missing samples are output as silence and the latency grows
+    by that amount, so getLatencySamples() is always exact.
+*/
+class FixedBlockAdapter
+{
+public:
+    using RenderFunction = void (*)(void* context, AudioBuffer<float>& buffer, int numSamples);
+
+    //==============================================================================
+    FixedBlockAdapter(RenderFunction renderFunction, void* context);
+    ~FixedBlockAdapter();
+
+    static int calculateLatencySamples(int deviceBlockSize, int internalBlockSize) noexcept;
+
+    /** Not to be called while the audio thread is processing. */
+    void prepare(int numChannels, int internalBlockSize, int deviceBlockSize);
+    void reset() noexcept;
+
+    int getInternalBlockSize() const noexcept { return m_internalBlockSize; };
+    int getLatencySamples() const noexcept { return m_latencySamples.load(); };
+    int getNumUnderruns() const noexcept { return m_underruns.load(); };
+
+    //==============================================================================
+    /** Audio thread only. */
+    void process(AudioBuffer<float>& outputBuffer, int startSample, int numSamples) noexcept;
+
+private:
+    void processChunk(AudioBuffer<float>& outputBuffer, int startSample, int numSamples) noexcept;
+
+    //==============================================================================
+    RenderFunction  m_renderFunction;
+    void*           m_renderContext;
+
+    int     m_numChannels{ 0 };
+    int     m_internalBlockSize{ 0 };
+    int     m_deviceBlockSize{ 0 };
+    int     m_pendingSamples{ 0 };
+
+    AudioBuffer<float>  m_renderBuffer;
+    AudioBuffer<float>  m_fifoBuffer;
+    AbstractFifo        m_fifo{ 1 };
+
+    std::atomic<int>    m_latencySamples{ 0 };
+    std::atomic<int>    m_underruns{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FixedBlockAdapter)
+};
@@ -0,0 +1,390 @@
+/*
+  ==============================================================================
+
+    JackClientDevice.cpp
+    Created: 18 Oct 2026 12:21:43am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "JackClientDevice.h"
+
+#if PLACROSS_JACK
+ #include <dlfcn.h>
+ #include <jack/jack.h>
+
+//==============================================================================
+/*
+    libjack is loaded on first use, the same way JUCE's own JACK support does it,
+    so the application still starts on systems without JACK installed.
+*/
+struct JackLibrary
+{
+    JackLibrary()
+    {
+        m_handle = dlopen("libjack.so.0", RTLD_LAZY | RTLD_LOCAL);
+        if (m_handle == nullptr)
+            return;
+
+        load(client_open, "jack_client_open");
+        load(client_close, "jack_client_close");
+        load(activate, "jack_activate");
+        load(deactivate, "jack_deactivate");
+        load(port_register, "jack_port_register");
+        load(port_unregister, "jack_port_unregister");
+        load(port_get_buffer, "jack_port_get_buffer");
+        load(port_get_latency_range, "jack_port_get_latency_range");
+        load(get_buffer_size, "jack_get_buffer_size");
+        load(get_sample_rate, "jack_get_sample_rate");
+        load(set_process_callback, "jack_set_process_callback");
+        load(set_buffer_size_callback, "jack_set_buffer_size_callback");
+        load(set_sample_rate_callback, "jack_set_sample_rate_callback");
+        load(on_shutdown, "jack_on_shutdown");
+    }
+
+    template <typename FunctionType>
+    void load(FunctionType& function, const char* name)
+    {
+        function = reinterpret_cast<FunctionType>(dlsym(m_handle, name));
+        m_complete = m_complete && function != nullptr;
+    }
+
+    bool isLoaded() const noexcept { return m_handle != nullptr && m_complete; };
+
+    static JackLibrary& getInstance()
+    {
+        static JackLibrary library;
+        return library;
+    }
+
+    void*   m_handle{ nullptr };
+    bool    m_complete{ true };
+
+    decltype(&::jack_client_open)               client_open{ nullptr };
+    decltype(&::jack_client_close)              client_close{ nullptr };
+    decltype(&::jack_activate)                  activate{ nullptr };
+    decltype(&::jack_deactivate)                deactivate{ nullptr };
+    decltype(&::jack_port_register)             port_register{ nullptr };
+    decltype(&::jack_port_unregister)           port_unregister{ nullptr };
+    decltype(&::jack_port_get_buffer)           port_get_buffer{ nullptr };
+    decltype(&::jack_port_get_latency_range)    port_get_latency_range{ nullptr };
+    decltype(&::jack_get_buffer_size)           get_buffer_size{ nullptr };
+    decltype(&::jack_get_sample_rate)           get_sample_rate{ nullptr };
+    decltype(&::jack_set_process_callback)      set_process_callback{ nullptr };
+    decltype(&::jack_set_buffer_size_callback)  set_buffer_size_callback{ nullptr };
+    decltype(&::jack_set_sample_rate_callback)  set_sample_rate_callback{ nullptr };
+    decltype(&::jack_on_shutdown)               on_shutdown{ nullptr };
+};
+#endif
+
+//==============================================================================
+JackClientDevice::JackClientDevice(const String& clientName, int maxNumPorts)
+    : AudioIODevice(clientName, "JACK"), m_maxNumPorts(jmax(1, maxNumPorts))
+{
+}
+
+JackClientDevice::~JackClientDevice()
+{
+    close();
+    cancelPendingUpdate();
+}
+
+bool JackClientDevice::isAvailable()
+{
+#if PLACROSS_JACK
+    return JackLibrary::getInstance().isLoaded();
+#else
+    return false;
+#endif
+}
+
+StringArray JackClientDevice::getOutputChannelNames()
+{
+    StringArray names;
+    for (int i = 0; i < m_maxNumPorts; ++i)
+        names.add("strip_" + String(i + 1));
+
+    return names;
+}
+
+StringArray JackClientDevice::getInputChannelNames()
+{
+    return {};
+}
+
+Array<double> JackClientDevice::getAvailableSampleRates()
+{
+    return { m_sampleRate };
+}
+
+Array<int> JackClientDevice::getAvailableBufferSizes()
+{
+    return { m_bufferSize };
+}
+
+int JackClientDevice::getDefaultBufferSize()
+{
+    return m_bufferSize;
+}
+
+String JackClientDevice::open(const BigInteger& inputChannels, const BigInteger& outputChannels, double sampleRate, int bufferSizeSamples)
+{
+    ignoreUnused(inputChannels, sampleRate, bufferSizeSamples);
+
+    close();
+
+#if PLACROSS_JACK
+    auto& jack = JackLibrary::getInstance();
+    if (!jack.isLoaded())
+    {
+        m_lastError = "libjack could not be loaded";
+        return m_lastError;
+    }
+
+    jack_status_t status;
+    auto client = jack.client_open(getName().toRawUTF8(), JackNoStartServer, &status);
+    if (client == nullptr)
+    {
+        m_lastError = "Could not connect to the JACK server (status " + String::toHexString(static_cast<int>(status)) + ")";
+        return m_lastError;
+    }
+    m_client = client;
+
+    // one port per strip, registered before activating, so connections can be made as soon as the client shows up
+    m_activeOutputs.clear();
+    for (int i = 0; i < m_maxNumPorts; ++i)
+    {
+        if (!outputChannels[i])
+            continue;
+
+        auto port = jack.port_register(client, ("strip_" + String(i + 1)).toRawUTF8(), JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput | JackPortIsTerminal, 0);
+        if (port == nullptr)
+        {
+            m_lastError = "Could not register port strip_" + String(i + 1);
+            close();
+            return m_lastError;
+        }
+
+        m_ports.push_back(port);
+        m_activeOutputs.setBit(i);
+    }
+    m_portBuffers.calloc(jmax<size_t>(1, m_ports.size()));
+
+    m_bufferSize = static_cast<int>(jack.get_buffer_size(client));
+    m_sampleRate = static_cast<double>(jack.get_sample_rate(client));
+    m_serverBufferSize = m_bufferSize;
+    m_serverSampleRate = m_sampleRate;
+    m_serverShutDown = false;
+
+    jack.set_process_callback(client, &JackClientDevice::processCallback, this);
+    jack.set_buffer_size_callback(client, &JackClientDevice::bufferSizeCallback, this);
+    jack.set_sample_rate_callback(client, &JackClientDevice::sampleRateCallback, this);
+    jack.on_shutdown(client, &JackClientDevice::shutdownCallback, this);
+
+    if (jack.activate(client) != 0)
+    {
+        m_lastError = "Could not activate the JACK client";
+        close();
+        return m_lastError;
+    }
+
+    m_lastError.clear();
+    return {};
+#else
+    ignoreUnused(outputChannels);
+    m_lastError = "Built without JACK support (PLACROSS_JACK)";
+    return m_lastError;
+#endif
+}
+
+void JackClientDevice::close()
+{
+    stop();
+
+#if PLACROSS_JACK
+    if (m_client != nullptr)
+    {
+        auto& jack = JackLibrary::getInstance();
+        auto client = static_cast<jack_client_t*>(m_client);
+
+        // no more process callbacks after deactivating, so the ports can go
+        jack.deactivate(client);
+        for (auto port : m_ports)
+            jack.port_unregister(client, static_cast<jack_port_t*>(port));
+        jack.client_close(client);
+    }
+#endif
+
+    m_client = nullptr;
+    m_ports.clear();
+    m_activeOutputs.clear();
+}
+
+bool JackClientDevice::isOpen()
+{
+    return m_client != nullptr;
+}
+
+void JackClientDevice::start(AudioIODeviceCallback* callback)
+{
+    if (!isOpen() || callback == nullptr)
+        return;
+
+    stop();
+
+    callback->audioDeviceAboutToStart(this);
+
+    const ScopedLock sl(m_callbackLock);
+    m_callback = callback;
+}
+
+void JackClientDevice::stop()
+{
+    AudioIODeviceCallback* callback = nullptr;
+    {
+        const ScopedLock sl(m_callbackLock);
+        std::swap(callback, m_callback);
+    }
+
+    if (callback != nullptr)
+        callback->audioDeviceStopped();
+}
+
+bool JackClientDevice::isPlaying()
+{
+    return m_callback != nullptr;
+}
+
+String JackClientDevice::getLastError()
+{
+    return m_lastError;
+}
+
+int JackClientDevice::getCurrentBufferSizeSamples()
+{
+    return m_bufferSize;
+}
+
+double JackClientDevice::getCurrentSampleRate()
+{
+    return m_sampleRate;
+}
+
+int JackClientDevice::getCurrentBitDepth()
+{
+    return 32;
+}
+
+BigInteger JackClientDevice::getActiveOutputChannels() const
+{
+    return m_activeOutputs;
+}
+
+BigInteger JackClientDevice::getActiveInputChannels() const
+{
+    return {};
+}
+
+int JackClientDevice::getOutputLatencyInSamples()
+{
+#if PLACROSS_JACK
+    if (m_client != nullptr && !m_ports.empty())
+    {
+        jack_latency_range_t range;
+        JackLibrary::getInstance().port_get_latency_range(static_cast<jack_port_t*>(m_ports.front()), JackPlaybackLatency, &range);
+        return static_cast<int>(range.max);
+    }
+#endif
+
+    return 0;
+}
+
+int JackClientDevice::getInputLatencyInSamples()
+{
+    return 0;
+}
+
+//==============================================================================
+int JackClientDevice::processCallback(uint32 numFrames, void* context)
+{
+#if PLACROSS_JACK
+    auto device = static_cast<JackClientDevice*>(context);
+    auto& jack = JackLibrary::getInstance();
+
+    // the port buffers are only valid for this cycle and have to be fetched every time
+    auto numPorts = static_cast<int>(device->m_ports.size());
+    for (int i = 0; i < numPorts; ++i)
+        device->m_portBuffers[i] = static_cast<float*>(jack.port_get_buffer(static_cast<jack_port_t*>(device->m_ports[i]), numFrames));
+
+    // while being reconfigured, the cycle is skipped instead of waiting for it
+    const ScopedTryLock sl(device->m_callbackLock);
+    if (sl.isLocked() && device->m_callback != nullptr && static_cast<int>(numFrames) <= device->m_bufferSize)
+    {
+        device->m_callback->audioDeviceIOCallback(nullptr, 0, device->m_portBuffers.get(), numPorts, static_cast<int>(numFrames));
+    }
+    else
+    {
+        for (int i = 0; i < numPorts; ++i)
+            FloatVectorOperations::clear(device->m_portBuffers[i], static_cast<int>(numFrames));
+    }
+#else
+    ignoreUnused(numFrames, context);
+#endif
+
+    return 0;
+}
+
+// the notification callbacks run on a JACK thread, nothing but recording the change is done there
+int JackClientDevice::bufferSizeCallback(uint32 numFrames, void* context)
+{
+    auto device = static_cast<JackClientDevice*>(context);
+    device->m_serverBufferSize = static_cast<int>(numFrames);
+    device->triggerAsyncUpdate();
+
+    return 0;
+}
+
+int JackClientDevice::sampleRateCallback(uint32 sampleRate, void* context)
+{
+    auto device = static_cast<JackClientDevice*>(context);
+    device->m_serverSampleRate = static_cast<double>(sampleRate);
+    device->triggerAsyncUpdate();
+
+    return 0;
+}
+
+void JackClientDevice::shutdownCallback(void* context)
+{
+    auto device = static_cast<JackClientDevice*>(context);
+    device->m_serverShutDown = true;
+    device->triggerAsyncUpdate();
+}
+
+void JackClientDevice::handleAsyncUpdate()
+{
+    if (m_serverShutDown.exchange(false))
+    {
+        m_lastError = "JACK server shut down";
+
+        const ScopedLock sl(m_callbackLock);
+        if (m_callback != nullptr)
+            m_callback->audioDeviceError(m_lastError);
+        return;
+    }
+
+    // JACK announces the current values once on activation as well
+    auto bufferSize = m_serverBufferSize.load();
+    auto sampleRate = m_serverSampleRate.load();
+    if (bufferSize == m_bufferSize && sampleRate == m_sampleRate)
+        return;
+
+    {
+        const ScopedLock sl(m_callbackLock);
+        m_bufferSize = bufferSize;
+        m_sampleRate = sampleRate;
+    }
+
+    if (onServerFormatChanged)
+        onServerFormatChanged();
+}
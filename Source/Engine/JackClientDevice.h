@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    JackClientDevice.h
+    Created: 18 Oct 2026 12:21:43am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// JACK client mode needs the JACK headers at build time, libjack itself is loaded at runtime.
+// The Linux exporter defines it, the other platforms build without.
+#ifndef PLACROSS_JACK
+ #define PLACROSS_JACK 0
+#endif
+
+//==============================================================================
+/*
+    Native JACK client with one output port per channel strip ("strip_1", "strip_2", ...).
+
+    It is an AudioIODevice so the strips and the analyser can be prepared from it like
+    from any other device, but it is not run through AudioDeviceManager and AudioSourcePlayer:
+    the callback it is started with gets the JACK port buffers themselves and renders into
+    them directly.
+
+    Buffer size and sample rate changes of the JACK server arrive on JACK's notification
+    thread. They are only recorded there and handed to the message thread, where the owner
+    takes them through its regular reconfiguration path (onServerFormatChanged).
+    Cycles that JACK runs meanwhile with a larger buffer output silence.
+*/
+class JackClientDevice : public AudioIODevice,
+                         private AsyncUpdater
+{
+public:
+    JackClientDevice(const String& clientName, int maxNumPorts);
+    ~JackClientDevice() override;
+
+    /** False if built without PLACROSS_JACK or if libjack could not be loaded. */
+    static bool isAvailable();
+
+    //==============================================================================
+    StringArray getOutputChannelNames() override;
+    StringArray getInputChannelNames() override;
+    Array<double> getAvailableSampleRates() override;
+    Array<int> getAvailableBufferSizes() override;
+    int getDefaultBufferSize() override;
+
+    /** Sample rate and buffer size are the ones of the JACK server, the requested ones are ignored. */
+    String open(const BigInteger& inputChannels, const BigInteger& outputChannels, double sampleRate, int bufferSizeSamples) override;
+    void close() override;
+    bool isOpen() override;
+
+    void start(AudioIODeviceCallback* callback) override;
+    void stop() override;
+    bool isPlaying() override;
+
+    String getLastError() override;
+    int getCurrentBufferSizeSamples() override;
+    double getCurrentSampleRate() override;
+    int getCurrentBitDepth() override;
+    BigInteger getActiveOutputChannels() const override;
+    BigInteger getActiveInputChannels() const override;
+    int getOutputLatencyInSamples() override;
+    int getInputLatencyInSamples() override;
+
+    //==============================================================================
+    /** Called on the message thread once the server's buffer size or sample rate changed,
+        the new values are already returned by the device then. The callback is not restarted
+        by the device itself. */
+    std::function<void()>   onServerFormatChanged;
+
+private:
+    static int processCallback(uint32 numFrames, void* context);
+    static int bufferSizeCallback(uint32 numFrames, void* context);
+    static int sampleRateCallback(uint32 sampleRate, void* context);
+    static void shutdownCallback(void* context);
+
+    void handleAsyncUpdate() override;
+
+    //==============================================================================
+    const int   m_maxNumPorts;
+
+    void*               m_client{ nullptr };    // jack_client_t
+    std::vector<void*>  m_ports;                // jack_port_t, one per active output
+    HeapBlock<float*>   m_portBuffers;
+    BigInteger          m_activeOutputs;
+
+    int                 m_bufferSize{ 0 };
+    double              m_sampleRate{ 0.0 };
+    String              m_lastError;
+
+    // as announced by JACK's notification thread, taken over on the message thread
+    std::atomic<int>    m_serverBufferSize{ 0 };
+    std::atomic<double> m_serverSampleRate{ 0.0 };
+    std::atomic<bool>   m_serverShutDown{ false };
+
+    CriticalSection         m_callbackLock;
+    AudioIODeviceCallback*  m_callback{ nullptr };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(JackClientDevice)
+};
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    ParameterEventQueue.cpp
+    Created: 18 Oct 2026 1:12:36am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "ParameterEventQueue.h"
+
+ParameterEventQueue::ParameterEventQueue()
+{
+}
+
+ParameterEventQueue::~ParameterEventQueue()
+{
+}
+
+bool ParameterEventQueue::post(const ParameterEvent& event) noexcept
+{
+    const SpinLock::ScopedLockType lock(m_postLock);
+
+    return push(m_fifo, m_posted, event);
+}
+
+bool ParameterEventQueue::postFromAudioThread(const ParameterEvent& event) noexcept
+{
+    return push(m_audioThreadFifo, m_audioThreadPosted, event);
+}
+
+bool ParameterEventQueue::push(AbstractFifo& fifo, std::array<ParameterEvent, capacity>& posted, const ParameterEvent& event) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+    if (size1 + size2 < 1)
+        return false;
+
+    posted[static_cast<size_t>(size1 > 0 ? start1 : start2)] = event;
+    fifo.finishedWrite(1);
+    return true;
+}
+
+void ParameterEventQueue::collectPostedEvents() noexcept
+{
+    collectPostedEvents(m_audioThreadFifo, m_audioThreadPosted);
+    collectPostedEvents(m_fifo, m_posted);
+}
+
+void ParameterEventQueue::collectPostedEvents(AbstractFifo& fifo, const std::array<ParameterEvent, capacity>& posted) noexcept
+{
+    // posted events stay in the fifo while the pending list is full, they are not lost, only late
+    auto numToCollect = jmin(fifo.getNumReady(), capacity - m_numPending);
+    if (numToCollect <= 0)
+        return;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numToCollect, start1, size1, start2, size2);
+
+    auto insert = [this](const ParameterEvent& event)
+    {
+        // insertion from the back keeps events of the same position in the order they were posted
+        auto i = m_numPending;
+        while (i > 0 && m_pending[static_cast<size_t>(i - 1)].samplePosition > event.samplePosition)
+        {
+            m_pending[static_cast<size_t>(i)] = m_pending[static_cast<size_t>(i - 1)];
+            --i;
+        }
+        m_pending[static_cast<size_t>(i)] = event;
+        ++m_numPending;
+    };
+
+    for (auto i = 0; i < size1; ++i)
+        insert(posted[static_cast<size_t>(start1 + i)]);
+    for (auto i = 0; i < size2; ++i)
+        insert(posted[static_cast<size_t>(start2 + i)]);
+
+    fifo.finishedRead(size1 + size2);
+}
+
+const ParameterEvent* ParameterEventQueue::popDueEvent(int64 samplePosition) noexcept
+{
+    collectPostedEvents();
+
+    if (m_numPending == 0 || m_pending[0].samplePosition > samplePosition)
+        return nullptr;
+
+    m_dueEvent = m_pending[0];
+    --m_numPending;
+    for (auto i = 0; i < m_numPending; ++i)
+        m_pending[static_cast<size_t>(i)] = m_pending[static_cast<size_t>(i + 1)];
+
+    return &m_dueEvent;
+}
+
+int ParameterEventQueue::getSamplesToNextEvent(int64 samplePosition, int maxSamples) noexcept
+{
+    collectPostedEvents();
+
+    if (m_numPending == 0)
+        return maxSamples;
+
+    return static_cast<int>(jlimit(int64(0), static_cast<int64>(maxSamples), m_pending[0].samplePosition - samplePosition));
+}
+
+void ParameterEventQueue::clear() noexcept
+{
+    m_fifo.finishedRead(m_fifo.getNumReady());
+    m_audioThreadFifo.finishedRead(m_audioThreadFifo.getNumReady());
+    m_numPending = 0;
+}
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    ParameterEventQueue.h
+    Created: 18 Oct 2026 1:12:36am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** A cutoff or gain change, to take effect at a position of a strip's sample timeline. */
+struct ParameterEvent
+{
+    enum Target
+    {
+        PET_Frequency,
+        PET_Gain
+    };
+
+    int64   samplePosition{ 0 };
+    Target  target{ PET_Gain };
+    float   value{ 0.0f };      // Hz or linear gain
+};
+
+//==============================================================================
+/*
+    Fixed capacity queue of timestamped parameter events for one strip processor.
+
+    Any number of threads (automation, remote control, morphs) can post events, the
+    audio thread is the only consumer. Posted events are moved into a pending list
+    sorted by position, from which the audio thread takes them once the timeline has
+    reached them, so a block can be split at the exact sample an event is due.
+    Events posted for a position already passed are due right away.
+
+    Nothing is allocated after construction. Posting fails while the queue is full,
+    as the consumer never waits for the producers, only producers serialise among
+    themselves. Events generated on the audio thread itself (MIDI controllers) have
+    a fifo of their own, so the audio thread never spins on the producers' lock.
+*/
+class ParameterEventQueue
+{
+public:
+    static constexpr int capacity = 128;
+
+    ParameterEventQueue();
+    ~ParameterEventQueue();
+
+    /** Any thread but the audio thread. Returns false if the event could not be queued. */
+    bool post(const ParameterEvent& event) noexcept;
+    /** Audio thread only, without taking the producers' lock. Returns false if the event could not be queued. */
+    bool postFromAudioThread(const ParameterEvent& event) noexcept;
+
+    //==============================================================================
+    /** Audio thread only. Returns the next event due at or before the position, nullptr if there is none. */
+    const ParameterEvent* popDueEvent(int64 samplePosition) noexcept;
+    /** Audio thread only. Number of samples from the position to the next pending event, at most maxSamples. */
+    int getSamplesToNextEvent(int64 samplePosition, int maxSamples) noexcept;
+    /** Audio thread only, or while it is not running. Drops all posted and pending events. */
+    void clear() noexcept;
+
+private:
+    void collectPostedEvents() noexcept;
+    void collectPostedEvents(AbstractFifo& fifo, const std::array<ParameterEvent, capacity>& posted) noexcept;
+    static bool push(AbstractFifo& fifo, std::array<ParameterEvent, capacity>& posted, const ParameterEvent& event) noexcept;
+
+    //==============================================================================
+    AbstractFifo                            m_fifo{ capacity };
+    std::array<ParameterEvent, capacity>    m_posted;
+    SpinLock                                m_postLock;
+
+    // single producer, the audio thread
+    AbstractFifo                            m_audioThreadFifo{ capacity };
+    std::array<ParameterEvent, capacity>    m_audioThreadPosted;
+
+    // audio thread only
+    std::array<ParameterEvent, capacity>    m_pending;
+    int                                     m_numPending{ 0 };
+    ParameterEvent                          m_dueEvent;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterEventQueue)
+};
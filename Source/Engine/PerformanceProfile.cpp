@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+    PerformanceProfile.cpp
+    Created: 17 Oct 2026 11:02:36pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "PerformanceProfile.h"
+
+#if JUCE_LINUX
+ #include <pthread.h>
+ #include <sched.h>
+ #include <unistd.h>
+ #include <alloca.h>
+ #include <sys/mman.h>
+ #include <sys/resource.h>
+#endif
+
+PerformanceProfile::PerformanceProfile()
+{
+}
+
+PerformanceProfile::~PerformanceProfile()
+{
+}
+
+bool PerformanceProfile::isSupported() noexcept
+{
+#if JUCE_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PerformanceProfile::setSettings(const Settings& settings)
+{
+    m_settings = settings;
+    m_settings.deviceThreadPriority = jlimit(1, 99, m_settings.deviceThreadPriority);
+    m_settings.workerThreadPriority = jlimit(1, 99, m_settings.workerThreadPriority);
+    m_settings.stackPrefaultBytes = jmax(0, m_settings.stackPrefaultBytes);
+}
+
+void PerformanceProfile::applyProcessSettings()
+{
+    m_processReport.clear();
+    m_processWarnings.clear();
+    m_deviceThreadResult = TSR_Pending;
+
+    if (!m_settings.enabled)
+        return;
+
+#if JUCE_LINUX
+    // realtime priorities need either CAP_SYS_NICE or a sufficient RLIMIT_RTPRIO
+    struct rlimit rtprioLimit;
+    if (getrlimit(RLIMIT_RTPRIO, &rtprioLimit) == 0 && geteuid() != 0)
+    {
+        auto maxPriority = jmax(m_settings.deviceThreadPriority, m_settings.workerThreadPriority);
+        if (rtprioLimit.rlim_cur != RLIM_INFINITY && static_cast<int>(rtprioLimit.rlim_cur) < maxPriority)
+            m_processWarnings.add("RLIMIT_RTPRIO is " + String(static_cast<int>(rtprioLimit.rlim_cur)) + ", SCHED_FIFO priority " + String(maxPriority)
+                + " needs CAP_SYS_NICE or an rtprio entry in /etc/security/limits.conf");
+    }
+
+    // the pinning mask has to name cores the process is allowed to run on
+    if (m_settings.cpuAffinityMask != 0)
+    {
+        cpu_set_t allowedCpus;
+        CPU_ZERO(&allowedCpus);
+        if (sched_getaffinity(0, sizeof(allowedCpus), &allowedCpus) == 0)
+        {
+            StringArray cores, unavailableCores;
+            for (int cpu = 0; cpu < 64; ++cpu)
+            {
+                if ((m_settings.cpuAffinityMask & (uint64(1) << cpu)) == 0)
+                    continue;
+
+                if (CPU_ISSET(cpu, &allowedCpus))
+                    cores.add(String(cpu));
+                else
+                    unavailableCores.add(String(cpu));
+            }
+
+            m_processReport.add("DSP threads pinned to cores " + cores.joinIntoString(","));
+            if (!unavailableCores.isEmpty())
+                m_processWarnings.add("Cores " + unavailableCores.joinIntoString(",") + " of the affinity mask are not available to the process");
+        }
+    }
+
+    if (m_settings.lockMemory)
+    {
+        // everything the engine allocated so far is faulted in and locked, everything allocated later is locked on first touch
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0)
+        {
+            m_processReport.add("Process memory locked");
+        }
+        else
+        {
+            struct rlimit memlockLimit;
+            auto limitText = (getrlimit(RLIMIT_MEMLOCK, &memlockLimit) == 0 && memlockLimit.rlim_cur != RLIM_INFINITY)
+                ? String(static_cast<int64>(memlockLimit.rlim_cur / 1024)) + " kB" : String("unknown");
+            m_processWarnings.add("mlockall failed (" + String(strerror(errno)) + "), RLIMIT_MEMLOCK is " + limitText
+                + ", needs CAP_IPC_LOCK or a memlock entry in /etc/security/limits.conf");
+        }
+    }
+#else
+    m_processWarnings.add("Performance profile is not supported on this platform");
+#endif
+
+    for (auto const& warning : m_processWarnings)
+        DBG("PerformanceProfile: " + warning);
+}
+
+void PerformanceProfile::applyToDeviceThread() noexcept
+{
+    if (!m_settings.enabled)
+        return;
+
+    auto applied = applyToCurrentThread(m_settings.deviceThreadPriority, m_settings.cpuAffinityMask, m_settings.stackPrefaultBytes);
+    m_deviceThreadResult = applied ? TSR_Applied : TSR_Failed;
+}
+
+bool PerformanceProfile::applyToCurrentThread(int priority, uint64 affinityMask, int stackPrefaultBytes) noexcept
+{
+    auto applied = true;
+
+#if JUCE_LINUX
+    if (priority > 0)
+    {
+        struct sched_param param;
+        param.sched_priority = jlimit(sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO), priority);
+        applied = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0 && applied;
+    }
+
+    if (affinityMask != 0)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int cpu = 0; cpu < 64; ++cpu)
+            if ((affinityMask & (uint64(1) << cpu)) != 0)
+                CPU_SET(cpu, &cpus);
+        applied = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0 && applied;
+    }
+
+    // map the part of the stack the processing is going to use
+    if (stackPrefaultBytes > 0)
+    {
+        auto stack = static_cast<char*>(alloca(static_cast<size_t>(stackPrefaultBytes)));
+        prefault(stack, static_cast<size_t>(stackPrefaultBytes));
+    }
+#else
+    ignoreUnused(priority, affinityMask, stackPrefaultBytes);
+    applied = false;
+#endif
+
+    return applied;
+}
+
+void PerformanceProfile::prefault(void* data, size_t numBytes) noexcept
+{
+    static constexpr size_t pageSize = 4096;
+
+    auto bytes = static_cast<volatile char*>(data);
+    for (size_t i = 0; i < numBytes; i += pageSize)
+        bytes[i] = bytes[i];
+    if (numBytes > 0)
+        bytes[numBytes - 1] = bytes[numBytes - 1];
+}
+
+String PerformanceProfile::getReport(int numWorkerThreadFailures) const
+{
+    if (!m_settings.enabled)
+        return "Performance profile disabled";
+
+    StringArray report(m_processReport);
+
+    switch (m_deviceThreadResult.load())
+    {
+    case TSR_Applied:
+        report.add("Device thread running SCHED_FIFO " + String(m_settings.deviceThreadPriority));
+        break;
+    case TSR_Failed:
+        report.add("WARNING: Device thread could not be set to SCHED_FIFO " + String(m_settings.deviceThreadPriority) + " / pinned");
+        break;
+    case TSR_Pending:
+    default:
+        report.add("Device thread not set up yet, waiting for the first callback");
+        break;
+    }
+
+    if (numWorkerThreadFailures > 0)
+        report.add("WARNING: " + String(numWorkerThreadFailures) + " DSP thread(s) could not be set to SCHED_FIFO " + String(m_settings.workerThreadPriority) + " / pinned");
+
+    for (auto const& warning : m_processWarnings)
+        report.add("WARNING: " + warning);
+
+    return report.joinIntoString("\n");
+}
@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    PerformanceProfile.h
+    Created: 17 Oct 2026 11:02:36pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Settings for deterministic latency on Linux, applied when audio starts:
+    SCHED_FIFO scheduling and CPU pinning of the device callback and all DSP
+    threads, locking the process memory and pre-faulting the engine buffers
+    and thread stacks.
+
+    The scheduling part has to be done by each thread for itself, which the
+    DSP threads do at their start and the device thread with its first callback.
+    Missing privileges (RLIMIT_RTPRIO, RLIMIT_MEMLOCK, CAP_SYS_NICE) do not
+    prevent audio from running, they are flagged in the report instead.
+    On other platforms the profile only reports itself as unsupported.
+*/
+class PerformanceProfile
+{
+public:
+    struct Settings
+    {
+        bool    enabled{ false };
+        int     deviceThreadPriority{ 80 };         // SCHED_FIFO priority, 1..99
+        int     workerThreadPriority{ 70 };         // for worker pool and pipeline threads, below the device thread
+        uint64  cpuAffinityMask{ 0 };               // the (isolated) cores all DSP threads are pinned to, 0 leaves them unpinned
+        bool    lockMemory{ true };
+        int     stackPrefaultBytes{ 256 * 1024 };
+    };
+
+    //==============================================================================
+    PerformanceProfile();
+    ~PerformanceProfile();
+
+    static bool isSupported() noexcept;
+
+    void setSettings(const Settings& settings);
+    const Settings& getSettings() const noexcept { return m_settings; };
+
+    //==============================================================================
+    /** Message thread, when audio starts. Locks the memory and checks what the threads will be permitted to apply. */
+    void applyProcessSettings();
+
+    /** Device thread, with its first callback. */
+    void applyToDeviceThread() noexcept;
+
+    /** To be called by each DSP thread for itself, returns false if any of it was not permitted.
+        Involves syscalls, so it is meant for thread start only. */
+    static bool applyToCurrentThread(int priority, uint64 affinityMask, int stackPrefaultBytes) noexcept;
+
+    /** Touches every page of the given memory, so it is mapped before the audio thread gets to it. */
+    static void prefault(void* data, size_t numBytes) noexcept;
+
+    //==============================================================================
+    /** What was applied and what is missing for the profile to be effective. */
+    String getReport(int numWorkerThreadFailures = 0) const;
+
+private:
+    enum ThreadSetupResult
+    {
+        TSR_Pending,
+        TSR_Applied,
+        TSR_Failed
+    };
+
+    //==============================================================================
+    Settings            m_settings;
+
+    StringArray         m_processReport;
+    StringArray         m_processWarnings;
+    std::atomic<int>    m_deviceThreadResult{ TSR_Pending };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PerformanceProfile)
+};
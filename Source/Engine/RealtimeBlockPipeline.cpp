@@ -0,0 +1,261 @@
+/*
+  ==============================================================================
+
+    RealtimeBlockPipeline.cpp
+    Created: 17 Oct 2026 4:05:32pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "RealtimeBlockPipeline.h"
+
+#include "PerformanceProfile.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+static inline void cpuRelax() noexcept
+{
+#if JUCE_INTEL
+    _mm_pause();
+#endif
+}
+
+//==============================================================================
+class RealtimeBlockPipeline::StageThread : public Thread
+{
+public:
+    StageThread(RealtimeBlockPipeline& pipeline)
+        : Thread("RealtimeBlockPipeline"), m_pipeline(pipeline)
+    {
+    }
+
+    void wakeUp()
+    {
+        if (m_sleeping.load())
+            m_wakeEvent.signal();
+    }
+
+    void run() override
+    {
+        static constexpr int spinIterations = 20000;
+
+        while (!threadShouldExit())
+        {
+            if (m_pipeline.m_threadSettingsPending.exchange(false))
+            {
+                if (!PerformanceProfile::applyToCurrentThread(m_pipeline.m_threadPriority.load(), m_pipeline.m_threadAffinityMask.load(), 64 * 1024))
+                    m_pipeline.m_threadSetupFailures = 1;
+                else
+                    m_pipeline.m_threadSetupFailures = 0;
+            }
+
+            auto producedAnything = false;
+            for (int spin = 0; !producedAnything && spin < spinIterations; ++spin)
+            {
+                producedAnything = m_pipeline.produceRequestedSlots();
+                if (!producedAnything)
+                    cpuRelax();
+            }
+
+            if (!producedAnything)
+            {
+                // announce going to sleep before checking once more, so a request in between is not missed
+                m_sleeping = true;
+                if (!m_pipeline.produceRequestedSlots() && !threadShouldExit())
+                    m_wakeEvent.wait(100);
+                m_sleeping = false;
+            }
+        }
+    }
+
+private:
+    RealtimeBlockPipeline&  m_pipeline;
+    WaitableEvent           m_wakeEvent;
+    std::atomic<bool>       m_sleeping{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StageThread)
+};
+
+
+//==============================================================================
+RealtimeBlockPipeline::RealtimeBlockPipeline(ProduceFunction produceFunction, void* context)
+    : m_produceFunction(produceFunction), m_produceContext(context)
+{
+    m_stageThread = std::make_unique<StageThread>(*this);
+    m_stageThread->startThread(9);
+}
+
+RealtimeBlockPipeline::~RealtimeBlockPipeline()
+{
+    m_stageThread->signalThreadShouldExit();
+    m_stageThread->wakeUp();
+    m_stageThread->stopThread(1000);
+}
+
+void RealtimeBlockPipeline::setThreadSettings(int realtimePriority, uint64 cpuAffinityMask) noexcept
+{
+    m_threadPriority = realtimePriority;
+    m_threadAffinityMask = cpuAffinityMask;
+    m_threadSettingsPending = true;
+    m_stageThread->wakeUp();
+}
+
+void RealtimeBlockPipeline::prepare(double sampleRate, int numChannels, int blockSize)
+{
+    ignoreUnused(sampleRate);
+
+    stop();
+
+    m_numChannels = jmax(0, numChannels);
+    m_blockSize = jmax(1, blockSize);
+    m_latencySamples = m_blockSize;
+
+    for (auto& slot : m_slots)
+        slot.buffer.setSize(m_numChannels, m_blockSize, false, true, false);
+
+    m_silence.calloc(static_cast<size_t>(m_blockSize));
+    m_readPointers.calloc(static_cast<size_t>(jmax(1, m_numChannels)));
+}
+
+void RealtimeBlockPipeline::stop()
+{
+    deactivate();
+
+    for (auto& slot : m_slots)
+        while (slot.state.load() == SS_Producing)
+            Thread::sleep(1);
+}
+
+bool RealtimeBlockPipeline::activate() noexcept
+{
+    if (m_active)
+        return true;
+
+    // the producer is still busy with a slot dropped when deactivating, it is not ours to reset yet
+    for (auto& slot : m_slots)
+        if (slot.state.load() == SS_Producing)
+            return false;
+
+    // the first slot is output as silence while the second one is produced, which makes up the one block of latency
+    m_slots[0].buffer.clear();
+    m_slots[0].state = SS_Ready;
+    requestSlot(1);
+
+    m_readSlot = 0;
+    m_readPosition = 0;
+    m_samplesBehind = 0;
+    m_active = true;
+
+    return true;
+}
+
+void RealtimeBlockPipeline::deactivate() noexcept
+{
+    m_active = false;
+
+    // withdraw requests not yet picked up, a slot in production is left to the producer and never read
+    for (auto& slot : m_slots)
+    {
+        auto expected = static_cast<int>(SS_Requested);
+        slot.state.compare_exchange_strong(expected, SS_Idle);
+        expected = static_cast<int>(SS_Ready);
+        slot.state.compare_exchange_strong(expected, SS_Idle);
+    }
+}
+
+bool RealtimeBlockPipeline::isProducing() const noexcept
+{
+    for (auto& slot : m_slots)
+        if (slot.state.load() == SS_Producing)
+            return true;
+
+    return false;
+}
+
+const float* const* RealtimeBlockPipeline::getReadPointers(int& numSamplesAvailable) noexcept
+{
+    jassert(m_active);
+
+    // after an underrun, what should have been output meanwhile is dropped, which gets the output back to one block behind
+    while (m_samplesBehind > 0 && m_slots[m_readSlot].state.load() == SS_Ready)
+    {
+        auto numSamplesToSkip = jmin(m_samplesBehind, m_blockSize - m_readPosition);
+        m_samplesBehind -= numSamplesToSkip;
+        m_readPosition += numSamplesToSkip;
+        if (m_readPosition >= m_blockSize)
+        {
+            requestSlot(m_readSlot);
+
+            m_readSlot = 1 - m_readSlot;
+            m_readPosition = 0;
+        }
+    }
+
+    auto& slot = m_slots[m_readSlot];
+
+    // the producer had a whole block period for this slot, waiting any longer would only make the strips miss the deadline
+    numSamplesAvailable = m_blockSize - m_readPosition;
+
+    m_readingSilence = slot.state.load() != SS_Ready;
+    if (m_readingSilence)
+    {
+        m_underruns.fetch_add(1);
+        for (int ch = 0; ch < m_numChannels; ++ch)
+            m_readPointers[ch] = m_silence.get();
+    }
+    else
+    {
+        for (int ch = 0; ch < m_numChannels; ++ch)
+            m_readPointers[ch] = slot.buffer.getReadPointer(ch, m_readPosition);
+    }
+
+    return m_readPointers.get();
+}
+
+void RealtimeBlockPipeline::advance(int numSamples) noexcept
+{
+    // on an underrun silence has been output instead, that much of the slot is skipped once it got ready
+    if (m_readingSilence)
+    {
+        m_samplesBehind += numSamples;
+        return;
+    }
+
+    m_readPosition += numSamples;
+    if (m_readPosition >= m_blockSize)
+    {
+        requestSlot(m_readSlot);
+
+        m_readSlot = 1 - m_readSlot;
+        m_readPosition = 0;
+    }
+}
+
+void RealtimeBlockPipeline::requestSlot(int slotIndex) noexcept
+{
+    m_slots[slotIndex].state = SS_Requested;
+    m_stageThread->wakeUp();
+}
+
+bool RealtimeBlockPipeline::produceRequestedSlots()
+{
+    auto producedAnything = false;
+
+    for (auto& slot : m_slots)
+    {
+        auto expected = static_cast<int>(SS_Requested);
+        if (slot.state.compare_exchange_strong(expected, SS_Producing))
+        {
+            ScopedNoDenormals noDenormals;
+            m_produceFunction(m_produceContext, slot.buffer, m_blockSize);
+
+            slot.state = SS_Ready;
+            producedAnything = true;
+        }
+    }
+
+    return producedAnything;
+}
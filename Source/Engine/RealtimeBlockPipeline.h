@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    RealtimeBlockPipeline.h
+    Created: 17 Oct 2026 4:05:32pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Two-stage pipeline that moves the first part of the audio processing to a
+    dedicated thread, at the cost of one block of latency.
+
+    The producer stage (running on the pipeline thread) renders fixed size blocks
+    into one of two pre-allocated slot buffers while the consumer (the audio thread)
+    reads the other one. When the consumer has read a slot entirely, the slot is
+    handed back to the producer to be refilled and the consumer goes on with the
+    other one, that the producer has filled meanwhile.
+
+    Activating and deactivating is done by the consumer itself, so it can be
+    switched at runtime. Neither of them waits for the producer: a block still in
+    production when deactivating is dropped once finished, and activating is retried
+    with the next block until it is. Until then the pipeline thread still runs the
+    producer stage, so whoever runs that stage directly instead has to wait for
+    isProducing() to turn false, e.g. outputting silence meanwhile.
+
+    The consumer never waits either. A slot not ready in time is replaced by
+    silence, and as much of it is skipped once it is ready, so the output stays
+    exactly one block behind the producer stage.
+*/
+class RealtimeBlockPipeline
+{
+public:
+    using ProduceFunction = void (*)(void* context, AudioBuffer<float>& buffer, int numSamples);
+
+    //==============================================================================
+    RealtimeBlockPipeline(ProduceFunction produceFunction, void* context);
+    ~RealtimeBlockPipeline();
+
+    /** Not to be called while the consumer is running. */
+    void prepare(double sampleRate, int numChannels, int blockSize);
+    /** Not to be called while the consumer is running. Deactivates and waits for a block in production, so what the
+        producer stage uses can be released afterwards. */
+    void stop();
+
+    /** One block, underruns drop what came too late instead of delaying everything after it. */
+    int getLatencySamples() const noexcept { return m_latencySamples.load(); };
+    int getNumUnderruns() const noexcept { return m_underruns.load(); };
+
+    /** SCHED_FIFO priority and cores for the pipeline thread, which it applies to itself before producing the next time. */
+    void setThreadSettings(int realtimePriority, uint64 cpuAffinityMask) noexcept;
+    int getNumThreadSetupFailures() const noexcept { return m_threadSetupFailures.load(); };
+
+    //==============================================================================
+    /** Consumer thread only. Activating fails while a block from before the last deactivation is still in production. */
+    bool activate() noexcept;
+    void deactivate() noexcept;
+    /** Any thread. */
+    bool isActive() const noexcept { return m_active.load(); };
+    /** Any thread. Whether the pipeline thread is running the producer stage, possibly for a block dropped when deactivating. */
+    bool isProducing() const noexcept;
+
+    /** Consumer thread only. Returns the channels of the current read position and the number of
+        samples readable from them. Has to be followed by advance() with the number of samples read. */
+    const float* const* getReadPointers(int& numSamplesAvailable) noexcept;
+    void advance(int numSamples) noexcept;
+
+private:
+    class StageThread;
+
+    enum SlotState
+    {
+        SS_Idle,
+        SS_Requested,
+        SS_Producing,
+        SS_Ready
+    };
+
+    struct Slot
+    {
+        AudioBuffer<float>  buffer;
+        std::atomic<int>    state{ SS_Idle };
+    };
+
+    //==============================================================================
+    void requestSlot(int slotIndex) noexcept;
+    bool produceRequestedSlots();
+
+    //==============================================================================
+    ProduceFunction     m_produceFunction;
+    void*               m_produceContext;
+
+    Slot                m_slots[2];
+    int                 m_blockSize{ 0 };
+
+    std::atomic<bool>   m_active{ false };
+    bool                m_readingSilence{ false };
+    int                 m_readSlot{ 0 };
+    int                 m_readPosition{ 0 };
+    int                 m_samplesBehind{ 0 };   // silence output on underruns, skipped from the slots once they are ready
+    HeapBlock<float>        m_silence;
+    HeapBlock<const float*> m_readPointers;
+    int                     m_numChannels{ 0 };
+
+    std::atomic<int>    m_underruns{ 0 };
+    std::atomic<int>    m_latencySamples{ 0 };
+
+    std::atomic<int>    m_threadPriority{ 0 };
+    std::atomic<uint64> m_threadAffinityMask{ 0 };
+    std::atomic<bool>   m_threadSettingsPending{ false };
+    std::atomic<int>    m_threadSetupFailures{ 0 };
+
+    std::unique_ptr<StageThread>    m_stageThread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RealtimeBlockPipeline)
+};
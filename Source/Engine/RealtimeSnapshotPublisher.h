@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+    RealtimeSnapshotPublisher.h
+    Created: 17 Oct 2026 10:12:41am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Hands immutable snapshot objects from the message thread to a single
+    realtime reader thread without ever blocking or allocating on the reader side.
+
+    The message thread publishes a new snapshot by swapping an atomic pointer.
+    The replaced snapshot is kept in a retire list and only deleted (again on the
+    message thread) once the reader is guaranteed not to hold it anymore. For that,
+    the reader brackets each access with a ScopedReader that bumps an epoch counter
+    to an odd value on entry and back to an even value on exit.
+*/
+template <typename SnapshotType>
+class RealtimeSnapshotPublisher : private Timer
+{
+public:
+    //==============================================================================
+    class ScopedReader
+    {
+    public:
+        explicit ScopedReader(RealtimeSnapshotPublisher& publisher) noexcept
+            : m_publisher(publisher)
+        {
+            m_snapshot = m_publisher.beginRead();
+        }
+        ~ScopedReader() noexcept
+        {
+            m_publisher.endRead();
+        }
+
+        const SnapshotType* get() const noexcept { return m_snapshot; }
+        const SnapshotType* operator->() const noexcept { return m_snapshot; }
+        explicit operator bool() const noexcept { return m_snapshot != nullptr; }
+
+    private:
+        RealtimeSnapshotPublisher&  m_publisher;
+        const SnapshotType*         m_snapshot{ nullptr };
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedReader)
+    };
+
+    //==============================================================================
+    RealtimeSnapshotPublisher() = default;
+    ~RealtimeSnapshotPublisher() override
+    {
+        stopTimer();
+
+        // the reader is expected to be stopped by now
+        jassert((m_readerEpoch.load() & 1) == 0);
+
+        delete m_published.exchange(nullptr);
+        for (auto& retired : m_retired)
+            delete retired.first;
+    }
+
+    //==============================================================================
+    /** Message thread only. Replaces the currently published snapshot. */
+    void publish(std::unique_ptr<SnapshotType> snapshot)
+    {
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        auto previous = m_published.exchange(snapshot.release());
+        if (previous != nullptr)
+            m_retired.push_back(std::make_pair(previous, m_readerEpoch.load()));
+
+        collectGarbage();
+    }
+
+    /** Message thread only. Access to the most recently published snapshot for non-realtime readers. */
+    const SnapshotType* getPublished() const noexcept
+    {
+        return m_published.load();
+    }
+
+    //==============================================================================
+    /** Reader thread only. Prefer ScopedReader, these are for reads spanning several calls.
+        Every beginRead must be paired with exactly one endRead and the returned snapshot
+        must not be used after it. */
+    const SnapshotType* beginRead() noexcept
+    {
+        m_readerEpoch.fetch_add(1);
+        return m_published.load();
+    }
+
+    void endRead() noexcept
+    {
+        m_readerEpoch.fetch_add(1);
+    }
+
+private:
+    //==============================================================================
+    void collectGarbage()
+    {
+        auto currentEpoch = m_readerEpoch.load();
+
+        // a snapshot retired while the reader was idle (even epoch) cannot be referenced anymore,
+        // one retired while the reader was active is safe to delete as soon as that pass has finished
+        auto it = m_retired.begin();
+        while (it != m_retired.end())
+        {
+            if ((it->second & 1) == 0 || it->second != currentEpoch)
+            {
+                delete it->first;
+                it = m_retired.erase(it);
+            }
+            else
+                ++it;
+        }
+
+        if (m_retired.empty())
+            stopTimer();
+        else if (!isTimerRunning())
+            startTimer(100);
+    }
+
+    void timerCallback() override
+    {
+        collectGarbage();
+    }
+
+    //==============================================================================
+    std::atomic<SnapshotType*>                      m_published{ nullptr };
+    std::atomic<uint64>                             m_readerEpoch{ 0 };
+    std::vector<std::pair<SnapshotType*, uint64>>   m_retired;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RealtimeSnapshotPublisher)
+};
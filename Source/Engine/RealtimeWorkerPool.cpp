@@ -0,0 +1,248 @@
+/*
+  ==============================================================================
+
+    RealtimeWorkerPool.cpp
+    Created: 17 Oct 2026 1:21:08pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "RealtimeWorkerPool.h"
+
+#include "PerformanceProfile.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+static inline void cpuRelax() noexcept
+{
+#if JUCE_INTEL
+    _mm_pause();
+#endif
+}
+
+//==============================================================================
+class RealtimeWorkerPool::Worker : public Thread
+{
+public:
+    Worker(RealtimeWorkerPool& pool, int participantIndex)
+        : Thread("RealtimeWorker " + String(participantIndex)), m_pool(pool), m_participantIndex(participantIndex)
+    {
+    }
+
+    void wakeUp()
+    {
+        m_wakeEvent.signal();
+    }
+
+    void run() override
+    {
+        auto& options = m_pool.m_options;
+        if (options.realtimePriority > 0 || options.cpuAffinityMask != 0)
+        {
+            if (!PerformanceProfile::applyToCurrentThread(options.realtimePriority, options.cpuAffinityMask, 64 * 1024))
+                m_pool.m_threadSetupFailures.fetch_add(1);
+        }
+
+        auto seenGeneration = m_pool.m_generation.load();
+
+        while (!threadShouldExit())
+        {
+            auto generation = m_pool.m_generation.load();
+            for (int spin = 0; generation == seenGeneration && spin < m_pool.m_options.spinIterations; ++spin)
+            {
+                cpuRelax();
+                generation = m_pool.m_generation.load();
+            }
+
+            if (generation == seenGeneration)
+            {
+                // announce going to sleep before checking once more, so a dispatch in between is not missed
+                m_pool.m_sleepingWorkers.fetch_add(1);
+                if (m_pool.m_generation.load() == seenGeneration && !threadShouldExit())
+                    m_wakeEvent.wait(100);
+                m_pool.m_sleepingWorkers.fetch_sub(1);
+                continue;
+            }
+
+            seenGeneration = generation;
+
+            ScopedNoDenormals noDenormals;
+            m_pool.executeTasks(m_participantIndex);
+        }
+    }
+
+private:
+    RealtimeWorkerPool& m_pool;
+    const int           m_participantIndex;
+    WaitableEvent       m_wakeEvent;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Worker)
+};
+
+
+//==============================================================================
+RealtimeWorkerPool::RealtimeWorkerPool()
+{
+    m_ranges.reset(new std::atomic<uint64>[1]);
+    m_ranges[0] = packRange(0, 0);
+}
+
+RealtimeWorkerPool::~RealtimeWorkerPool()
+{
+    m_enabled = false;
+    while (m_dispatching.load())
+        Thread::yield();
+
+    stopWorkers();
+}
+
+RealtimeWorkerPool::Options RealtimeWorkerPool::getDefaultOptions()
+{
+    Options options;
+    options.numWorkerThreads = jmax(0, SystemStats::getNumCpus() - 1);
+    return options;
+}
+
+void RealtimeWorkerPool::setOptions(const Options& options)
+{
+    // keep the audio thread out of the pool while the workers are replaced, it runs all tasks itself meanwhile
+    m_enabled = false;
+    while (m_dispatching.load())
+        Thread::yield();
+
+    stopWorkers();
+
+    m_threadSetupFailures = 0;
+    m_options = options;
+    m_options.numWorkerThreads = jmax(0, m_options.numWorkerThreads);
+    m_options.minTasksForParallel = jmax(2, m_options.minTasksForParallel);
+
+    startWorkers();
+
+    m_enabled = !m_workers.empty();
+}
+
+void RealtimeWorkerPool::startWorkers()
+{
+    m_numParticipants = m_options.numWorkerThreads + 1;
+    m_ranges.reset(new std::atomic<uint64>[static_cast<size_t>(m_numParticipants)]);
+    for (int i = 0; i < m_numParticipants; ++i)
+        m_ranges[i] = packRange(0, 0);
+
+    for (int i = 1; i < m_numParticipants; ++i)
+    {
+        auto worker = std::make_unique<Worker>(*this, i);
+        worker->startThread(9);
+        m_workers.push_back(std::move(worker));
+    }
+}
+
+void RealtimeWorkerPool::stopWorkers()
+{
+    for (auto& worker : m_workers)
+        worker->signalThreadShouldExit();
+    for (auto& worker : m_workers)
+    {
+        worker->wakeUp();
+        worker->stopThread(1000);
+    }
+    m_workers.clear();
+
+    m_numParticipants = 1;
+}
+
+void RealtimeWorkerPool::run(TaskFunction taskFunction, void* context, int numTasks) noexcept
+{
+    if (numTasks <= 0)
+        return;
+
+    m_dispatching = true;
+
+    if (!m_enabled.load() || numTasks < m_options.minTasksForParallel)
+    {
+        m_dispatching = false;
+
+        for (int i = 0; i < numTasks; ++i)
+            taskFunction(context, i);
+        return;
+    }
+
+    // the task description has to be complete before the ranges make any task visible
+    m_taskFunction = taskFunction;
+    m_taskContext = context;
+    m_pendingTasks = numTasks;
+
+    auto tasksPerParticipant = numTasks / m_numParticipants;
+    auto remainder = numTasks % m_numParticipants;
+    auto begin = 0;
+    for (int i = 0; i < m_numParticipants; ++i)
+    {
+        auto end = begin + tasksPerParticipant + (i < remainder ? 1 : 0);
+        m_ranges[i] = packRange(static_cast<uint32>(begin), static_cast<uint32>(end));
+        begin = end;
+    }
+
+    m_generation.fetch_add(1);
+
+    if (m_sleepingWorkers.load() > 0)
+    {
+        for (auto& worker : m_workers)
+            worker->wakeUp();
+    }
+
+    executeTasks(0);
+
+    // join: the remaining tasks are being finished by workers that already took them
+    while (m_pendingTasks.load() > 0)
+        cpuRelax();
+
+    m_dispatching = false;
+}
+
+void RealtimeWorkerPool::executeTasks(int participantIndex) noexcept
+{
+    int taskIndex = 0;
+    while (popOwnTask(participantIndex, taskIndex) || stealTask(participantIndex, taskIndex))
+    {
+        m_taskFunction.load()(m_taskContext.load(), taskIndex);
+        m_pendingTasks.fetch_sub(1);
+    }
+}
+
+bool RealtimeWorkerPool::popOwnTask(int participantIndex, int& taskIndex) noexcept
+{
+    auto& range = m_ranges[participantIndex];
+    auto current = range.load();
+    while (getRangeBegin(current) < getRangeEnd(current))
+    {
+        if (range.compare_exchange_weak(current, packRange(getRangeBegin(current) + 1, getRangeEnd(current))))
+        {
+            taskIndex = static_cast<int>(getRangeBegin(current));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool RealtimeWorkerPool::stealTask(int participantIndex, int& taskIndex) noexcept
+{
+    for (int offset = 1; offset < m_numParticipants; ++offset)
+    {
+        auto& range = m_ranges[(participantIndex + offset) % m_numParticipants];
+        auto current = range.load();
+        while (getRangeBegin(current) < getRangeEnd(current))
+        {
+            if (range.compare_exchange_weak(current, packRange(getRangeBegin(current), getRangeEnd(current) - 1)))
+            {
+                taskIndex = static_cast<int>(getRangeEnd(current) - 1);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
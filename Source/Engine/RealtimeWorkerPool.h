@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    RealtimeWorkerPool.h
+    Created: 17 Oct 2026 1:21:08pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Pool of pre-spawned worker threads to fan out per-block work (e.g. one task per
+    channel strip) from the audio thread across cores and join again before returning.
+
+    The calling thread participates as one of the workers. Tasks are initially split
+    into one contiguous range per participant, participants that run out of work steal
+    from the back of the others' ranges. Workers spin for a while after each block
+    before going to sleep, so with a running audio device they are usually still
+    spinning when the next block is dispatched and no lock or syscall is involved.
+    Only workers that actually went to sleep are woken through their WaitableEvent.
+*/
+class RealtimeWorkerPool
+{
+public:
+    struct Options
+    {
+        int numWorkerThreads{ 0 };          // threads in addition to the calling thread
+        int minTasksForParallel{ 4 };       // less tasks than this are run on the calling thread only
+        int spinIterations{ 20000 };        // idle spins of a worker before it goes to sleep
+        int realtimePriority{ 0 };          // SCHED_FIFO priority the workers set for themselves, 0 leaves it to Thread
+        uint64 cpuAffinityMask{ 0 };        // cores the workers pin themselves to, 0 leaves them unpinned
+    };
+
+    using TaskFunction = void (*)(void* context, int taskIndex);
+
+    //==============================================================================
+    RealtimeWorkerPool();
+    ~RealtimeWorkerPool();
+
+    static Options getDefaultOptions();
+
+    //==============================================================================
+    void setOptions(const Options& options);
+    const Options& getOptions() const noexcept { return m_options; };
+    int getNumWorkerThreads() const noexcept { return static_cast<int>(m_workers.size()); };
+    int getNumThreadSetupFailures() const noexcept { return m_threadSetupFailures.load(); };
+
+    //==============================================================================
+    void run(TaskFunction taskFunction, void* context, int numTasks) noexcept;
+
+private:
+    class Worker;
+
+    //==============================================================================
+    void startWorkers();
+    void stopWorkers();
+    void executeTasks(int participantIndex) noexcept;
+    bool popOwnTask(int participantIndex, int& taskIndex) noexcept;
+    bool stealTask(int participantIndex, int& taskIndex) noexcept;
+
+    static uint64 packRange(uint32 begin, uint32 end) noexcept { return (static_cast<uint64>(begin) << 32) | end; };
+    static uint32 getRangeBegin(uint64 range) noexcept { return static_cast<uint32>(range >> 32); };
+    static uint32 getRangeEnd(uint64 range) noexcept { return static_cast<uint32>(range & 0xffffffff); };
+
+    //==============================================================================
+    Options                                 m_options;
+    std::vector<std::unique_ptr<Worker>>    m_workers;
+    std::unique_ptr<std::atomic<uint64>[]>  m_ranges;   // one task range per participant, index 0 is the calling thread
+    int                                     m_numParticipants{ 1 };
+
+    std::atomic<TaskFunction>   m_taskFunction{ nullptr };
+    std::atomic<void*>          m_taskContext{ nullptr };
+    std::atomic<int>            m_pendingTasks{ 0 };
+    std::atomic<uint32>         m_generation{ 0 };
+    std::atomic<int>            m_sleepingWorkers{ 0 };
+    std::atomic<int>            m_threadSetupFailures{ 0 };
+
+    std::atomic<bool>           m_enabled{ false };
+    std::atomic<bool>           m_dispatching{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RealtimeWorkerPool)
+};
@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+    RigMorph.cpp
+    Created: 18 Oct 2026 2:24:51am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "RigMorph.h"
+
+// the morph's matrices get versions of their own, so they never match one published by the routing component
+static constexpr uint32 morphRoutingVersionFlag = 0x80000000;
+
+static bool isCutoff(int value) noexcept
+{
+    return value == RigMorph::SV_HighPassCutoff || value == RigMorph::SV_LowPassCutoff;
+}
+
+static float getStripValue(const ChannelStripEngine::ChannelParameters& parameters, int value) noexcept
+{
+    switch (value)
+    {
+    case RigMorph::SV_HighPassCutoff:
+        return parameters.highPassCutoff;
+    case RigMorph::SV_HighPassGain:
+        return parameters.highPassGain;
+    case RigMorph::SV_LowPassCutoff:
+        return parameters.lowPassCutoff;
+    case RigMorph::SV_LowPassGain:
+        return parameters.lowPassGain;
+    case RigMorph::SV_Gain:
+    default:
+        return parameters.gain;
+    }
+}
+
+std::unique_ptr<RigMorph::Plan> RigMorph::createPlan(const RigSnapshot& from, const RigSnapshot& to, double seconds, double sampleRate, uint32 version)
+{
+    auto plan = std::make_unique<Plan>();
+    plan->version = version;
+    plan->numStrips = static_cast<int>(jmax(from.strips.size(), to.strips.size()));
+    plan->numInputs = jmax(from.numInputChannels, to.numInputChannels);
+    plan->numOutputs = jmax(from.numOutputChannels, to.numOutputChannels);
+    plan->lengthSamples = jmax(int64(1), static_cast<int64>(seconds * sampleRate));
+
+    // a strip's defaults are the processors' parameter defaults
+    ChannelStripEngine::ChannelParameters defaults;
+    defaults.highPassCutoff = 20.0f;
+    defaults.highPassGain = 1.0f;
+    defaults.lowPassCutoff = 20000.0f;
+    defaults.lowPassGain = 1.0f;
+    defaults.gain = 1.0f;
+
+    plan->stripFrom.resize(static_cast<size_t>(SV_NumValues * plan->numStrips));
+    plan->stripDelta.resize(static_cast<size_t>(SV_NumValues * plan->numStrips));
+    for (auto value = 0; value < SV_NumValues; ++value)
+    {
+        for (auto strip = 0; strip < plan->numStrips; ++strip)
+        {
+            auto fromValue = getStripValue(strip < static_cast<int>(from.strips.size()) ? from.strips[static_cast<size_t>(strip)] : defaults, value);
+            auto toValue = getStripValue(strip < static_cast<int>(to.strips.size()) ? to.strips[static_cast<size_t>(strip)] : defaults, value);
+            if (isCutoff(value))
+            {
+                fromValue = std::log(jmax(1.0f, fromValue));
+                toValue = std::log(jmax(1.0f, toValue));
+            }
+
+            auto index = static_cast<size_t>(value * plan->numStrips + strip);
+            plan->stripFrom[index] = fromValue;
+            plan->stripDelta[index] = toValue - fromValue;
+        }
+    }
+
+    auto getRoutingGains = [plan = plan.get()](const RigSnapshot& snapshot)
+    {
+        std::vector<float> gains(static_cast<size_t>(plan->numInputs * plan->numOutputs), 0.0f);
+        for (auto const& crosspoint : snapshot.routing)
+            if (isPositiveAndBelow(crosspoint.first, plan->numInputs) && isPositiveAndBelow(crosspoint.second, plan->numOutputs))
+                gains[static_cast<size_t>(crosspoint.second * plan->numInputs + crosspoint.first)] = 1.0f;
+        return gains;
+    };
+    auto fromGains = getRoutingGains(from);
+    auto toGains = getRoutingGains(to);
+
+    // crosspoints silent in both snapshots stay out of the morph altogether
+    for (auto out = 0; out < plan->numOutputs; ++out)
+    {
+        for (auto in = 0; in < plan->numInputs; ++in)
+        {
+            auto index = static_cast<size_t>(out * plan->numInputs + in);
+            if (fromGains[index] == 0.0f && toGains[index] == 0.0f)
+                continue;
+
+            plan->routingInputs.push_back(in);
+            plan->routingOutputs.push_back(out);
+            plan->routingFrom.push_back(fromGains[index]);
+            plan->routingDelta.push_back(toGains[index] - fromGains[index]);
+        }
+    }
+
+    return plan;
+}
+
+//==============================================================================
+RigMorph::RigMorph()
+{
+}
+
+RigMorph::~RigMorph()
+{
+}
+
+void RigMorph::prepare(int maxStrips, int maxInputs, int maxOutputs)
+{
+    m_maxStrips = jmax(0, maxStrips);
+    m_stripValues.calloc(static_cast<size_t>(jmax(1, SV_NumValues * m_maxStrips)));
+    m_routing = std::make_unique<RoutingMatrix>(maxInputs, maxOutputs, morphRoutingVersionFlag);
+    m_routing->reserveActiveCrosspoints();
+    m_routing->finishActiveCrosspoints();
+    m_morphingCrosspoints.calloc(static_cast<size_t>(jmax(1, maxInputs * maxOutputs)));
+    m_morphingActiveIndices.calloc(static_cast<size_t>(jmax(1, maxInputs * maxOutputs)));
+    m_numMorphingCrosspoints = 0;
+
+    // a morph running while re-preparing starts over
+    m_planVersion = 0;
+    m_finished = true;
+}
+
+bool RigMorph::process(const Plan& plan, int numSamples) noexcept
+{
+    if (plan.version != m_planVersion)
+    {
+        m_planVersion = plan.version;
+        m_position = 0;
+        m_finished = false;
+
+        if (m_routing != nullptr)
+            adoptRoutingPlan(plan);
+    }
+
+    if (m_finished || m_routing == nullptr)
+        return false;
+
+    m_position = jmin(m_position + numSamples, plan.lengthSamples);
+    m_finished = m_position >= plan.lengthSamples;
+    auto t = static_cast<float>(static_cast<double>(m_position) / static_cast<double>(plan.lengthSamples));
+
+    // each parameter is one contiguous pass over all strips
+    auto numStrips = jmin(plan.numStrips, m_maxStrips);
+    for (auto value = 0; value < SV_NumValues; ++value)
+    {
+        auto values = m_stripValues.get() + value * m_maxStrips;
+        FloatVectorOperations::copy(values, plan.stripFrom.data() + value * plan.numStrips, numStrips);
+        FloatVectorOperations::addWithMultiply(values, plan.stripDelta.data() + value * plan.numStrips, t, numStrips);
+
+        if (isCutoff(value))
+            for (auto strip = 0; strip < numStrips; ++strip)
+                values[strip] = std::exp(values[strip]);
+    }
+
+    // only the crosspoints that differ between the snapshots move, the matrix keeps its active crosspoints
+    for (auto i = 0; i < m_numMorphingCrosspoints; ++i)
+    {
+        auto index = static_cast<size_t>(m_morphingCrosspoints[i]);
+        m_routing->setActiveGain(m_morphingActiveIndices[i], plan.routingOutputs[index], plan.routingFrom[index] + t * plan.routingDelta[index]);
+    }
+    m_routing->setVersion(morphRoutingVersionFlag | (++m_routingVersion & ~morphRoutingVersionFlag), !m_routingLayoutChanged);
+    m_routingLayoutChanged = false;
+
+    return true;
+}
+
+void RigMorph::adoptRoutingPlan(const Plan& plan) noexcept
+{
+    // the active crosspoints are the ones set in either snapshot, those set in both with the same gain never change
+    m_routing->clearActiveCrosspoints();
+    m_numMorphingCrosspoints = 0;
+
+    auto activeIndex = 0;
+    for (size_t i = 0; i < plan.routingInputs.size(); ++i)
+    {
+        auto in = plan.routingInputs[i];
+        auto out = plan.routingOutputs[i];
+        if (in >= m_routing->getNumInputs() || out >= m_routing->getNumOutputs())
+            continue;
+
+        m_routing->addActiveCrosspoint(in, out);
+        m_routing->setActiveGain(activeIndex, out, plan.routingFrom[i]);
+
+        if (plan.routingDelta[i] != 0.0f)
+        {
+            m_morphingCrosspoints[m_numMorphingCrosspoints] = static_cast<int>(i);
+            m_morphingActiveIndices[m_numMorphingCrosspoints] = activeIndex;
+            ++m_numMorphingCrosspoints;
+        }
+
+        ++activeIndex;
+    }
+
+    m_routing->finishActiveCrosspoints();
+    m_routingLayoutChanged = true;
+}
+
+ChannelStripEngine::ChannelParameters RigMorph::getStripParameters(int strip) const noexcept
+{
+    ChannelStripEngine::ChannelParameters parameters;
+    if (!isPositiveAndBelow(strip, m_maxStrips))
+        return parameters;
+
+    parameters.highPassCutoff = m_stripValues[SV_HighPassCutoff * m_maxStrips + strip];
+    parameters.highPassGain = m_stripValues[SV_HighPassGain * m_maxStrips + strip];
+    parameters.lowPassCutoff = m_stripValues[SV_LowPassCutoff * m_maxStrips + strip];
+    parameters.lowPassGain = m_stripValues[SV_LowPassGain * m_maxStrips + strip];
+    parameters.gain = m_stripValues[SV_Gain * m_maxStrips + strip];
+    return parameters;
+}
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    RigMorph.h
+    Created: 18 Oct 2026 2:24:51am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "RigSnapshot.h"
+#include "../Routing/RoutingMatrixMixer.h"
+
+//==============================================================================
+/*
+    Moves the whole rig from one snapshot to another over a given time.
+
+    The message thread turns the two snapshots into an immutable Plan once, holding
+    the start values and the distance to the end values of every strip parameter and
+    routing crosspoint set in either of them, cutoffs as natural logs so they move
+    evenly across the octaves. The audio thread then computes the values reached at
+    the end of each block in one pass per parameter over all channels (value = from
+    + t * delta, with FloatVectorOperations) and hands them to the strips as their
+    targets and to the routing as a matrix it rewrites in place. Only crosspoints
+    that differ between the snapshots are rewritten, and as the matrix keeps its
+    active crosspoints the mixer ramps just those. The strips' own smoothing and
+    the routing's per block ramps take it from there down to the sample.
+*/
+class RigMorph
+{
+public:
+    enum StripValue
+    {
+        SV_HighPassCutoff,
+        SV_HighPassGain,
+        SV_LowPassCutoff,
+        SV_LowPassGain,
+        SV_Gain,
+        SV_NumValues
+    };
+
+    struct Plan
+    {
+        uint32              version{ 0 };
+        int                 numStrips{ 0 };
+        int                 numInputs{ 0 };
+        int                 numOutputs{ 0 };
+        int64               lengthSamples{ 1 };
+        std::vector<float>  stripFrom;      // [value * numStrips + strip], cutoffs as natural logs
+        std::vector<float>  stripDelta;
+        std::vector<int>    routingInputs;  // crosspoints set in either snapshot, ordered by output
+        std::vector<int>    routingOutputs;
+        std::vector<float>  routingFrom;
+        std::vector<float>  routingDelta;
+    };
+
+    /** Message thread. Strips and crosspoints missing in one of the snapshots morph from or to their defaults. */
+    static std::unique_ptr<Plan> createPlan(const RigSnapshot& from, const RigSnapshot& to, double seconds, double sampleRate, uint32 version);
+
+    //==============================================================================
+    RigMorph();
+    ~RigMorph();
+
+    /** Not to be called while the audio thread is using the morph. */
+    void prepare(int maxStrips, int maxInputs, int maxOutputs);
+
+    //==============================================================================
+    /** Audio thread only. Advances the plan by one block and computes the values reached at its end.
+        Returns false if the plan has already been completed with an earlier block. */
+    bool process(const Plan& plan, int numSamples) noexcept;
+    bool isFinished() const noexcept { return m_finished; };
+
+    ChannelStripEngine::ChannelParameters getStripParameters(int strip) const noexcept;
+    /** The matrix computed for the current block, valid until the next process(). */
+    const RoutingMatrix* getRoutingMatrix() const noexcept { return m_routing.get(); };
+
+private:
+    void adoptRoutingPlan(const Plan& plan) noexcept;
+
+    //==============================================================================
+    uint32  m_planVersion{ 0 };
+    int64   m_position{ 0 };
+    bool    m_finished{ true };
+
+    int                             m_maxStrips{ 0 };
+    HeapBlock<float>                m_stripValues;  // [value * m_maxStrips + strip]
+    std::unique_ptr<RoutingMatrix>  m_routing;
+    uint32                          m_routingVersion{ 0 };
+    HeapBlock<int>                  m_morphingCrosspoints;  // plan indices of the changing crosspoints, [i] is active crosspoint m_morphingActiveIndices[i]
+    HeapBlock<int>                  m_morphingActiveIndices;
+    int                             m_numMorphingCrosspoints{ 0 };
+    bool                            m_routingLayoutChanged{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RigMorph)
+};
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    RigSnapshot.cpp
+    Created: 18 Oct 2026 1:47:09am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "RigSnapshot.h"
+
+static constexpr int numStripValues = 5;
+
+// the ranges of the processors' parameters (hpff / lpff, hpfg / lpfg / gain)
+static bool readStripValue(InputStream& stream, float minValue, float maxValue, float& value)
+{
+    value = stream.readFloat();
+    if (!std::isfinite(value))
+        return false;
+
+    value = jlimit(minValue, maxValue, value);
+    return true;
+}
+
+static int getRoutingRowBytes(int numInputChannels) noexcept
+{
+    return (numInputChannels + 7) / 8;
+}
+
+void RigSnapshot::writeTo(OutputStream& stream) const
+{
+    stream.writeInt(static_cast<int>(magic));
+    stream.writeInt(formatVersion);
+    stream.writeShort(static_cast<short>(numInputChannels));
+    stream.writeShort(static_cast<short>(numOutputChannels));
+    stream.writeShort(static_cast<short>(strips.size()));
+
+    // one bit per crosspoint, a row of bytes per output
+    auto rowBytes = getRoutingRowBytes(numInputChannels);
+    HeapBlock<uint8> routingBits(static_cast<size_t>(rowBytes * numOutputChannels), true);
+    for (auto const& crosspoint : routing)
+        if (crosspoint.first < numInputChannels && crosspoint.second < numOutputChannels)
+            routingBits[crosspoint.second * rowBytes + crosspoint.first / 8] |= static_cast<uint8>(1 << (crosspoint.first % 8));
+    stream.write(routingBits.get(), static_cast<size_t>(rowBytes * numOutputChannels));
+
+    for (auto const& strip : strips)
+    {
+        stream.writeFloat(strip.highPassCutoff);
+        stream.writeFloat(strip.highPassGain);
+        stream.writeFloat(strip.lowPassCutoff);
+        stream.writeFloat(strip.lowPassGain);
+        stream.writeFloat(strip.gain);
+    }
+
+    stream.writeInt(analyser.holdTimeMs);
+    stream.writeFloat(analyser.minDB);
+    stream.writeFloat(analyser.maxDB);
+}
+
+bool RigSnapshot::readFrom(InputStream& stream)
+{
+    if (stream.getNumBytesRemaining() < 14 || static_cast<uint32>(stream.readInt()) != magic || stream.readInt() != formatVersion)
+        return false;
+
+    auto numInputs = static_cast<int>(stream.readShort());
+    auto numOutputs = static_cast<int>(stream.readShort());
+    auto numStrips = static_cast<int>(stream.readShort());
+    if (!isPositiveAndNotGreaterThan(numInputs, maxChannels) || !isPositiveAndNotGreaterThan(numOutputs, maxChannels) || !isPositiveAndNotGreaterThan(numStrips, maxChannels))
+        return false;
+
+    auto rowBytes = getRoutingRowBytes(numInputs);
+    auto expectedBytes = static_cast<int64>(rowBytes * numOutputs)
+        + static_cast<int64>(numStrips * numStripValues * sizeof(float))
+        + static_cast<int64>(sizeof(int32) + 2 * sizeof(float));
+    if (stream.getNumBytesRemaining() < expectedBytes)
+        return false;
+
+    HeapBlock<uint8> routingBits(static_cast<size_t>(rowBytes * numOutputs), true);
+    stream.read(routingBits.get(), rowBytes * numOutputs);
+
+    std::multimap<int, int> newRouting;
+    for (auto in = 0; in < numInputs; ++in)
+        for (auto out = 0; out < numOutputs; ++out)
+            if ((routingBits[out * rowBytes + in / 8] & (1 << (in % 8))) != 0)
+                newRouting.insert(std::make_pair(in, out));
+
+    // the values go to the filters as they are on recall, so anything out of range is clipped and anything not finite rejects the whole snapshot
+    std::vector<ChannelStripEngine::ChannelParameters> newStrips(static_cast<size_t>(numStrips));
+    for (auto& strip : newStrips)
+    {
+        if (!readStripValue(stream, 20.0f, 20000.0f, strip.highPassCutoff)
+            || !readStripValue(stream, 0.0f, 1.0f, strip.highPassGain)
+            || !readStripValue(stream, 20.0f, 20000.0f, strip.lowPassCutoff)
+            || !readStripValue(stream, 0.0f, 1.0f, strip.lowPassGain)
+            || !readStripValue(stream, 0.0f, 1.0f, strip.gain))
+            return false;
+    }
+
+    AnalyserComponent::Settings newAnalyser;
+    newAnalyser.holdTimeMs = jlimit(0, 60000, stream.readInt());
+    newAnalyser.minDB = stream.readFloat();
+    newAnalyser.maxDB = stream.readFloat();
+    if (!std::isfinite(newAnalyser.minDB) || !std::isfinite(newAnalyser.maxDB))
+        return false;
+    newAnalyser.maxDB = jlimit(-199.0f, 24.0f, newAnalyser.maxDB);
+    newAnalyser.minDB = jlimit(-200.0f, newAnalyser.maxDB - 1.0f, newAnalyser.minDB);
+
+    numInputChannels = numInputs;
+    numOutputChannels = numOutputs;
+    routing = std::move(newRouting);
+    strips = std::move(newStrips);
+    analyser = newAnalyser;
+
+    return true;
+}
+
+void RigSnapshot::toMemoryBlock(MemoryBlock& destData) const
+{
+    destData.reset();
+    MemoryOutputStream stream(destData, false);
+    writeTo(stream);
+}
+
+bool RigSnapshot::fromMemory(const void* data, size_t sizeInBytes)
+{
+    MemoryInputStream stream(data, sizeInBytes, false);
+    return readFrom(stream);
+}
@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    RigSnapshot.h
+    Created: 18 Oct 2026 1:47:09am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "../ChannelStrip/ChannelStripEngine.h"
+#include "../Analyser/AnalyserComponent.h"
+
+//==============================================================================
+/*
+    Everything that makes up a setup of the whole rig: the parameters of all
+    channel strips, the routing matrix and the analyser settings.
+
+    The binary format is a fixed header followed by the routing as one bitmask row
+    per output, the five parameter values of each strip and the analyser settings,
+    all little endian. A 64 x 64 rig takes well under 2 KB.
+*/
+struct RigSnapshot
+{
+    static constexpr uint32 magic = 0x50524731; // "PRG1"
+    static constexpr int formatVersion = 1;
+    static constexpr int maxChannels = 256;
+
+    int                                                 numInputChannels{ 0 };
+    int                                                 numOutputChannels{ 0 };
+    std::multimap<int, int>                             routing;    // input -> output crosspoints
+    std::vector<ChannelStripEngine::ChannelParameters>  strips;
+    AnalyserComponent::Settings                         analyser;
+
+    //==============================================================================
+    void writeTo(OutputStream& stream) const;
+    /** Returns false and leaves the snapshot unchanged if the data is not a valid snapshot. */
+    bool readFrom(InputStream& stream);
+
+    void toMemoryBlock(MemoryBlock& destData) const;
+    bool fromMemory(const void* data, size_t sizeInBytes);
+};
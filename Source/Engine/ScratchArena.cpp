@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    ScratchArena.cpp
+    Created: 17 Oct 2026 6:48:03pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "ScratchArena.h"
+
+ScratchArena::ScratchArena()
+{
+}
+
+ScratchArena::~ScratchArena()
+{
+}
+
+size_t ScratchArena::getFloatsSize(int numFloats) noexcept
+{
+    return getAlignedSize(sizeof(float) * static_cast<size_t>(jmax(0, numFloats)));
+}
+
+size_t ScratchArena::getChannelsSize(int numChannels, int numSamples) noexcept
+{
+    // the channel pointer array plus one separately aligned area per channel
+    return getAlignedSize(sizeof(float*) * static_cast<size_t>(jmax(0, numChannels)))
+        + static_cast<size_t>(jmax(0, numChannels)) * getFloatsSize(numSamples);
+}
+
+void ScratchArena::prepare(size_t capacityBytes)
+{
+    m_capacity = getAlignedSize(capacityBytes);
+
+    // over-allocate by one alignment unit to be able to align the base
+    m_storage.calloc(m_capacity + alignment);
+    m_base = m_storage.get() + (alignment - (reinterpret_cast<pointer_sized_uint>(m_storage.get()) & (alignment - 1))) % alignment;
+
+    m_used = 0;
+    m_peakUsage = 0;
+}
+
+void ScratchArena::prefault() noexcept
+{
+    zeromem(m_storage.get(), m_capacity + alignment);
+}
+
+void* ScratchArena::allocate(size_t numBytes) noexcept
+{
+    auto alignedBytes = getAlignedSize(numBytes);
+    if (m_used + alignedBytes > m_capacity)
+    {
+        jassertfalse;
+        return nullptr;
+    }
+
+    auto memory = m_base + m_used;
+    m_used += alignedBytes;
+
+    if (m_used > m_peakUsage.load())
+        m_peakUsage = m_used;
+
+    return memory;
+}
+
+float* ScratchArena::allocateFloats(int numFloats) noexcept
+{
+    return static_cast<float*>(allocate(sizeof(float) * static_cast<size_t>(jmax(0, numFloats))));
+}
+
+float** ScratchArena::allocateChannels(int numChannels, int numSamples) noexcept
+{
+    if (m_used + getChannelsSize(numChannels, numSamples) > m_capacity)
+    {
+        jassertfalse;
+        return nullptr;
+    }
+
+    auto channels = static_cast<float**>(allocate(sizeof(float*) * static_cast<size_t>(jmax(0, numChannels))));
+    for (int ch = 0; ch < numChannels; ++ch)
+        channels[ch] = allocateFloats(numSamples);
+
+    return channels;
+}
+
+void ScratchArena::release(size_t mark) noexcept
+{
+    // checkouts have to be released in reverse order
+    jassert(mark <= m_used);
+    m_used = jmin(mark, m_used);
+}
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    ScratchArena.h
+    Created: 17 Oct 2026 6:48:03pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Block scratch memory shared by the processing stages running on one thread.
+
+    The arena is sized once at prepare time from what the stages report to need and
+    hands out cache line aligned memory by bumping an offset. Stages check memory out
+    for the duration of their work and release it again in reverse order, either
+    through a ScopedCheckout or by explicitly releasing to a mark taken before.
+    Nothing is ever allocated after prepare().
+
+    The peak usage is tracked, so it can be reported per engine configuration.
+*/
+class ScratchArena
+{
+public:
+    static constexpr size_t alignment = 64;
+
+    //==============================================================================
+    class ScopedCheckout
+    {
+    public:
+        explicit ScopedCheckout(ScratchArena& arena) noexcept
+            : m_arena(arena), m_mark(arena.getMark())
+        {
+        }
+        ~ScopedCheckout() noexcept
+        {
+            m_arena.release(m_mark);
+        }
+
+    private:
+        ScratchArena&   m_arena;
+        const size_t    m_mark;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedCheckout)
+    };
+
+    //==============================================================================
+    ScratchArena();
+    ~ScratchArena();
+
+    static size_t getAlignedSize(size_t numBytes) noexcept { return (numBytes + alignment - 1) & ~(alignment - 1); };
+    static size_t getFloatsSize(int numFloats) noexcept;
+    static size_t getChannelsSize(int numChannels, int numSamples) noexcept;
+
+    /** Not to be called while a stage is working with the arena. */
+    void prepare(size_t capacityBytes);
+    /** Writes the whole storage once, so no page of it is faulted in on the audio thread. Not to be called while in use. */
+    void prefault() noexcept;
+
+    //==============================================================================
+    /** These return nullptr (and assert) if the arena was not prepared large enough. */
+    void* allocate(size_t numBytes) noexcept;
+    float* allocateFloats(int numFloats) noexcept;
+    float** allocateChannels(int numChannels, int numSamples) noexcept;
+
+    size_t getMark() const noexcept { return m_used; };
+    void release(size_t mark) noexcept;
+
+    //==============================================================================
+    size_t getCapacity() const noexcept { return m_capacity; };
+    size_t getPeakUsage() const noexcept { return m_peakUsage.load(); };
+    void resetPeakUsage() noexcept { m_peakUsage = m_used; };
+
+private:
+    //==============================================================================
+    HeapBlock<char>     m_storage;
+    char*               m_base{ nullptr };
+    size_t              m_capacity{ 0 };
+    size_t              m_used{ 0 };
+    std::atomic<size_t> m_peakUsage{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScratchArena)
+};
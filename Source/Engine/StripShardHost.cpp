@@ -0,0 +1,322 @@
+/*
+  ==============================================================================
+
+    StripShardHost.cpp
+    Created: 17 Oct 2026 11:48:20pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "StripShardHost.h"
+
+// crash and hang detection, and the coordinator's sign of life for the workers
+static constexpr int SUPERVISION_INTERVAL_MS = 100;
+static constexpr uint32 WORKER_TIMEOUT_MS = 2000;
+
+StripShardHost::StripShardHost()
+{
+}
+
+StripShardHost::~StripShardHost()
+{
+    stop();
+}
+
+bool StripShardHost::start(int numShards, int numChannels, int maxBlockSize, double sampleRate)
+{
+    stop();
+
+    numShards = jlimit(0, jmax(0, numChannels), numShards);
+    if (numShards == 0 || maxBlockSize <= 0 || sampleRate <= 0.0)
+        return false;
+
+    m_numChannels = numChannels;
+    m_maxBlockSize = maxBlockSize;
+
+    m_delayLine.setSize(numChannels, 2 * maxBlockSize, false, true, false);
+    m_delayReadPosition = 0;
+    m_delayWritePosition = maxBlockSize;
+    m_pendingSamples = 0;
+
+    auto anyStarted = false;
+    for (int i = 0; i < numShards; ++i)
+    {
+        auto shard = std::make_unique<Shard>();
+        shard->firstChannel = i * numChannels / numShards;
+        shard->numChannels = (i + 1) * numChannels / numShards - shard->firstChannel;
+
+        if (startShard(*shard, sampleRate))
+            anyStarted = true;
+        else
+            shard->failed = true;
+
+        m_shards.push_back(std::move(shard));
+    }
+
+    if (!anyStarted)
+    {
+        stop();
+        return false;
+    }
+
+    for (int i = 0; i < numShards; ++i)
+        if (m_shards[i]->failed.load())
+            failShard(i, "worker process could not be started");
+
+    startTimer(SUPERVISION_INTERVAL_MS);
+
+    return true;
+}
+
+bool StripShardHost::startShard(Shard& shard, double sampleRate)
+{
+    // RAM backed on Linux, so the mapping never gets written back to a disk
+    auto directory = File("/dev/shm");
+    if (!directory.isDirectory())
+        directory = File::getSpecialLocation(File::tempDirectory);
+
+    auto size = StripShardLayout::getTotalSize(shard.numChannels, m_maxBlockSize);
+    shard.file = directory.getNonexistentChildFile("placross-shard", ".shm", false);
+    MemoryBlock zeros(size, true);
+    if (!shard.file.replaceWithData(zeros.getData(), zeros.getSize()))
+        return false;
+
+    shard.mapping = std::make_unique<MemoryMappedFile>(shard.file, MemoryMappedFile::readWrite, false);
+    if (shard.mapping->getData() == nullptr || shard.mapping->getSize() < size)
+        return false;
+
+    auto header = static_cast<StripShardLayout::Header*>(shard.mapping->getData());
+    header->numChannels = shard.numChannels;
+    header->maxBlockSize = m_maxBlockSize;
+    header->firstChannel = shard.firstChannel;
+    header->sampleRate = sampleRate;
+    header->magic = StripShardLayout::magic;
+
+    if (!shard.view.attach(shard.mapping->getData(), shard.mapping->getSize()))
+        return false;
+
+    // touching the slots once here keeps the audio thread from faulting in the pages later on
+    for (int slot = 0; slot < StripShardLayout::numSlots; ++slot)
+        zeromem(shard.view.getSlot(slot), StripShardLayout::getSlotSize(shard.numChannels, m_maxBlockSize));
+
+    StringArray arguments{ File::getSpecialLocation(File::currentExecutableFile).getFullPathName(),
+                           StripShardLayout::workerCommandLineOption,
+                           shard.file.getFullPathName() };
+    if (!shard.process.start(arguments, 0))
+        return false;
+
+    shard.lastWorkerAliveTime = Time::getMillisecondCounter();
+
+    return true;
+}
+
+void StripShardHost::stop()
+{
+    stopTimer();
+
+    // workers shut down on their own once asked to, only those that do not are killed
+    for (auto& shard : m_shards)
+        if (shard->view.header != nullptr)
+            shard->view.header->shutdown.store(1, std::memory_order_release);
+
+    for (auto& shard : m_shards)
+        stopShard(*shard);
+
+    m_shards.clear();
+    m_numChannels = 0;
+}
+
+void StripShardHost::stopShard(Shard& shard)
+{
+    if (shard.process.isRunning() && !shard.process.waitForProcessToFinish(1000))
+        shard.process.kill();
+
+    shard.view = StripShardLayout::View();
+    shard.mapping.reset();
+    shard.file.deleteFile();
+}
+
+void StripShardHost::failShard(int shardIndex, const String& failure)
+{
+    auto& shard = *m_shards[static_cast<size_t>(shardIndex)];
+    shard.failed = true;
+    shard.failure = failure;
+
+    auto description = "Strip shard " + String(shardIndex + 1) + " (channels " + String(shard.firstChannel + 1) + "-" + String(shard.firstChannel + shard.numChannels) + ") "
+        + failure + ", its channels are muted";
+    DBG("StripShardHost: " + description);
+
+    if (onShardFailed)
+        onShardFailed(shardIndex, description);
+}
+
+void StripShardHost::timerCallback()
+{
+    auto now = Time::getMillisecondCounter();
+
+    for (int i = 0; i < static_cast<int>(m_shards.size()); ++i)
+    {
+        auto& shard = *m_shards[static_cast<size_t>(i)];
+        if (shard.failed.load())
+            continue;
+
+        auto header = shard.view.header;
+        header->coordinatorAlive.fetch_add(1, std::memory_order_relaxed);
+
+        if (!shard.process.isRunning())
+        {
+            failShard(i, "worker process terminated with exit code " + String(static_cast<int>(shard.process.getExitCode())));
+            continue;
+        }
+
+        auto workerAlive = header->workerAlive.load(std::memory_order_relaxed);
+        if (workerAlive != shard.lastWorkerAlive)
+        {
+            shard.lastWorkerAlive = workerAlive;
+            shard.lastWorkerAliveTime = now;
+        }
+        else if (now - shard.lastWorkerAliveTime > WORKER_TIMEOUT_MS)
+        {
+            // a hanging worker is taken down, so it does not hold on to its cores
+            shard.process.kill();
+            failShard(i, "worker process stopped responding");
+        }
+    }
+}
+
+//==============================================================================
+void StripShardHost::process(const float* const* inputs, float* const* outputs, const ChannelStripEngine::ChannelParameters* parameters, int numChannels, int numSamples) noexcept
+{
+    numChannels = jmin(numChannels, m_numChannels);
+    numSamples = jmin(numSamples, m_maxBlockSize);
+
+    // the output of the previous range goes into the delay line first, the workers had a whole block period for it ...
+    for (auto& shard : m_shards)
+        collect(*shard, m_pendingSamples);
+    m_delayWritePosition = (m_delayWritePosition + m_pendingSamples) % m_delayLine.getNumSamples();
+
+    // ... then this range is handed over, to be processed while the audio thread goes on ...
+    for (auto& shard : m_shards)
+        submit(*shard, inputs, parameters, numSamples);
+    m_pendingSamples = numSamples;
+
+    // ... and the range that much behind is read out of the delay line
+    auto delaySize = m_delayLine.getNumSamples();
+    auto firstPart = jmin(numSamples, delaySize - m_delayReadPosition);
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto delayed = m_delayLine.getReadPointer(ch);
+        FloatVectorOperations::copy(outputs[ch], delayed + m_delayReadPosition, firstPart);
+        FloatVectorOperations::copy(outputs[ch] + firstPart, delayed, numSamples - firstPart);
+    }
+    m_delayReadPosition = (m_delayReadPosition + numSamples) % delaySize;
+}
+
+void StripShardHost::collect(Shard& shard, int numSamples) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    auto slotHeader = shard.submitted && !shard.failed.load() ? shard.view.getSlotHeader(static_cast<int>(shard.submittedBlock % StripShardLayout::numSlots)) : nullptr;
+
+    // never waited for, a block not done by now is late and its range silent, the one block of latency is all the budget there is
+    auto ready = slotHeader != nullptr && slotHeader->outputBlock.load(std::memory_order_acquire) == shard.submittedBlock;
+    if (slotHeader != nullptr && !ready)
+        shard.lateBlocks.fetch_add(1, std::memory_order_relaxed);
+
+    auto delaySize = m_delayLine.getNumSamples();
+    auto firstPart = jmin(numSamples, delaySize - m_delayWritePosition);
+    for (int ch = 0; ch < shard.numChannels; ++ch)
+    {
+        auto delayed = m_delayLine.getWritePointer(shard.firstChannel + ch);
+        if (ready)
+        {
+            auto processed = shard.view.getChannel(static_cast<int>(shard.submittedBlock % StripShardLayout::numSlots), true, ch);
+            FloatVectorOperations::copy(delayed + m_delayWritePosition, processed, firstPart);
+            FloatVectorOperations::copy(delayed, processed + firstPart, numSamples - firstPart);
+        }
+        else
+        {
+            FloatVectorOperations::clear(delayed + m_delayWritePosition, firstPart);
+            FloatVectorOperations::clear(delayed, numSamples - firstPart);
+        }
+    }
+}
+
+void StripShardHost::submit(Shard& shard, const float* const* inputs, const ChannelStripEngine::ChannelParameters* parameters, int numSamples) noexcept
+{
+    auto block = shard.submittedBlock + 1;
+    shard.submittedBlock = block;
+    shard.submitted = false;
+
+    if (shard.failed.load())
+        return;
+
+    // the slot still belongs to the worker if it has not finished the block before the last one yet, this block is dropped then
+    auto header = shard.view.header;
+    if (header->completedBlock.load(std::memory_order_acquire) + StripShardLayout::numSlots < block)
+    {
+        shard.droppedBlocks.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto slot = static_cast<int>(block % StripShardLayout::numSlots);
+    auto slotHeader = shard.view.getSlotHeader(slot);
+    auto slotParameters = shard.view.getParameters(slot);
+    for (int ch = 0; ch < shard.numChannels; ++ch)
+    {
+        FloatVectorOperations::copy(shard.view.getChannel(slot, false, ch), inputs[shard.firstChannel + ch], numSamples);
+        slotParameters[ch] = parameters[shard.firstChannel + ch];
+    }
+    slotHeader->numSamples = numSamples;
+    slotHeader->inputBlock.store(block, std::memory_order_release);
+
+    header->requestedBlock.store(block, std::memory_order_release);
+    shard.submitted = true;
+}
+
+//==============================================================================
+String StripShardHost::getReport() const
+{
+    if (m_shards.empty())
+        return "Strip sharding disabled";
+
+    StringArray report;
+    report.add(String(m_numChannels) + " channels on " + String(getNumShards()) + " worker processes, " + String(getLatencySamples()) + " samples latency");
+
+    for (int i = 0; i < static_cast<int>(m_shards.size()); ++i)
+    {
+        auto& shard = *m_shards[static_cast<size_t>(i)];
+        auto line = "Shard " + String(i + 1) + " (channels " + String(shard.firstChannel + 1) + "-" + String(shard.firstChannel + shard.numChannels) + "): ";
+        line << (shard.failed.load() ? "FAILED, " + shard.failure : String("running"));
+        line << ", " << shard.lateBlocks.load() << " late / " << shard.droppedBlocks.load() << " dropped blocks";
+        report.add(line);
+    }
+
+    return report.joinIntoString("\n");
+}
+
+int StripShardHost::getNumLateBlocks() const noexcept
+{
+    auto lateBlocks = 0;
+    for (auto& shard : m_shards)
+        lateBlocks += shard->lateBlocks.load();
+    return lateBlocks;
+}
+
+int StripShardHost::getNumDroppedBlocks() const noexcept
+{
+    auto droppedBlocks = 0;
+    for (auto& shard : m_shards)
+        droppedBlocks += shard->droppedBlocks.load();
+    return droppedBlocks;
+}
+
+int StripShardHost::getNumFailedShards() const noexcept
+{
+    auto failedShards = 0;
+    for (auto& shard : m_shards)
+        failedShards += shard->failed.load() ? 1 : 0;
+    return failedShards;
+}
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    StripShardHost.h
+    Created: 17 Oct 2026 11:48:20pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "StripShardLayout.h"
+
+//==============================================================================
+/*
+    Coordinator side of processing the channel strips in separate worker processes,
+    for channel counts one process cannot handle anymore.
+
+    The channels are split evenly across the given number of shards, each being a
+    worker process (this same executable, started in worker mode) exchanging audio
+    with the coordinator through its own shared memory block ring. Every shard adds
+    the same fixed latency of one block, which the host evens out across varying
+    callback sizes with a delay line of that length, so all channels stay aligned.
+
+    A worker that crashed, hangs or misses its deadline only takes its own channels
+    down to silence. Crashes and hangs are detected on the message thread and
+    reported through onShardFailed, late blocks are counted for the report.
+*/
+class StripShardHost : private Timer
+{
+public:
+    StripShardHost();
+    ~StripShardHost() override;
+
+    /** Message thread, while the audio thread is not processing. Returns false if not a single worker could be started. */
+    bool start(int numShards, int numChannels, int maxBlockSize, double sampleRate);
+    void stop();
+
+    bool isStarted() const noexcept { return !m_shards.empty(); };
+    int getNumShards() const noexcept { return static_cast<int>(m_shards.size()); };
+    int getLatencySamples() const noexcept { return isStarted() ? m_maxBlockSize : 0; };
+
+    /** Called on the message thread with the shard index and a description, when a worker terminated or stopped responding. */
+    std::function<void(int, const String&)> onShardFailed;
+
+    //==============================================================================
+    /** Audio thread only. Hands this range to the workers and returns what they processed, delayed by getLatencySamples().
+        Outputs of shards that failed or are late are silent. */
+    void process(const float* const* inputs, float* const* outputs, const ChannelStripEngine::ChannelParameters* parameters, int numChannels, int numSamples) noexcept;
+
+    //==============================================================================
+    String getReport() const;
+    /** Any thread. Summed up over all shards. */
+    int getNumLateBlocks() const noexcept;
+    int getNumDroppedBlocks() const noexcept;
+    int getNumFailedShards() const noexcept;
+
+private:
+    struct Shard
+    {
+        int     firstChannel{ 0 };
+        int     numChannels{ 0 };
+
+        File                                file;
+        std::unique_ptr<MemoryMappedFile>   mapping;
+        StripShardLayout::View              view;
+        ChildProcess                        process;
+
+        // audio thread
+        uint32  submittedBlock{ 0 };
+        bool    submitted{ false };
+
+        // message thread
+        uint32  lastWorkerAlive{ 0 };
+        uint32  lastWorkerAliveTime{ 0 };
+        String  failure;
+
+        std::atomic<bool>   failed{ false };
+        std::atomic<int>    lateBlocks{ 0 };
+        std::atomic<int>    droppedBlocks{ 0 };
+    };
+
+    //==============================================================================
+    void timerCallback() override;
+
+    bool startShard(Shard& shard, double sampleRate);
+    void stopShard(Shard& shard);
+    void failShard(int shardIndex, const String& failure);
+
+    void collect(Shard& shard, int numSamples) noexcept;
+    void submit(Shard& shard, const float* const* inputs, const ChannelStripEngine::ChannelParameters* parameters, int numSamples) noexcept;
+
+    //==============================================================================
+    std::vector<std::unique_ptr<Shard>>     m_shards;
+    int                                     m_numChannels{ 0 };
+    int                                     m_maxBlockSize{ 0 };
+
+    // evens out the one block of latency across callbacks of different sizes
+    AudioBuffer<float>  m_delayLine;
+    int                 m_delayWritePosition{ 0 };
+    int                 m_delayReadPosition{ 0 };
+    int                 m_pendingSamples{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StripShardHost)
+};
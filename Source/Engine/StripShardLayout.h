@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    StripShardLayout.h
+    Created: 17 Oct 2026 11:48:20pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "../ChannelStrip/ChannelStripEngine.h"
+
+//==============================================================================
+/*
+    Layout of the memory a coordinator shares with one strip shard worker process.
+    It is a file mapped by both processes (on Linux placed in /dev/shm, so it never
+    touches a disk), holding a header and a ring of two block slots.
+
+    The coordinator writes the routed input and the strip parameters of block n into
+    slot n % 2 and publishes n as the latest request. The worker processes the latest
+    request into the output of the same slot and publishes it as completed. The
+    coordinator collects the output of block n - 1 while submitting block n, so a
+    worker has one full block period to deliver and the shard adds one fixed block
+    of latency. Only plain loads and stores of lock-free atomics cross the process
+    boundary, neither side ever waits for a lock the other one could hold.
+*/
+namespace StripShardLayout
+{
+    static constexpr uint32 magic = 0x50534831; // "PSH1"
+    static constexpr int numSlots = 2;
+    static constexpr size_t alignment = 64;
+
+    static_assert(sizeof(std::atomic<uint32>) == sizeof(uint32), "Shared atomics have to be plain words");
+
+    static constexpr const char* workerCommandLineOption = "--strip-shard-worker";
+
+    struct Header
+    {
+        uint32  magic;
+        int32   numChannels;
+        int32   maxBlockSize;
+        int32   firstChannel;       // of the coordinator's channels, for reports only
+        double  sampleRate;
+
+        std::atomic<uint32> requestedBlock;     // coordinator -> worker
+        std::atomic<uint32> completedBlock;     // worker -> coordinator
+        std::atomic<uint32> coordinatorAlive;   // bumped by the coordinator, a worker exits when it stops changing
+        std::atomic<uint32> workerAlive;        // bumped by the worker
+        std::atomic<uint32> shutdown;
+    };
+
+    struct SlotHeader
+    {
+        std::atomic<uint32> inputBlock;     // block the input of the slot belongs to
+        std::atomic<uint32> outputBlock;    // block the output of the slot belongs to
+        int32               numSamples;
+    };
+
+    inline size_t align(size_t size) noexcept
+    {
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+
+    inline size_t getSlotSize(int numChannels, int maxBlockSize) noexcept
+    {
+        auto channelSize = align(sizeof(float) * static_cast<size_t>(maxBlockSize));
+        return align(sizeof(SlotHeader))
+            + align(sizeof(ChannelStripEngine::ChannelParameters) * static_cast<size_t>(numChannels))
+            + 2 * channelSize * static_cast<size_t>(numChannels);
+    }
+
+    inline size_t getTotalSize(int numChannels, int maxBlockSize) noexcept
+    {
+        return align(sizeof(Header)) + numSlots * getSlotSize(numChannels, maxBlockSize);
+    }
+
+    //==============================================================================
+    /* Pointers into one mapping, the same for coordinator and worker. */
+    struct View
+    {
+        bool attach(void* data, size_t size) noexcept
+        {
+            base = static_cast<char*>(data);
+            header = reinterpret_cast<Header*>(base);
+
+            if (base == nullptr || size < align(sizeof(Header)) || header->magic != magic
+                || header->numChannels <= 0 || header->maxBlockSize <= 0
+                || size < getTotalSize(header->numChannels, header->maxBlockSize))
+                return false;
+
+            numChannels = header->numChannels;
+            maxBlockSize = header->maxBlockSize;
+            return true;
+        }
+
+        char* getSlot(int slot) const noexcept
+        {
+            return base + align(sizeof(Header)) + static_cast<size_t>(slot) * getSlotSize(numChannels, maxBlockSize);
+        }
+
+        SlotHeader* getSlotHeader(int slot) const noexcept
+        {
+            return reinterpret_cast<SlotHeader*>(getSlot(slot));
+        }
+
+        ChannelStripEngine::ChannelParameters* getParameters(int slot) const noexcept
+        {
+            return reinterpret_cast<ChannelStripEngine::ChannelParameters*>(getSlot(slot) + align(sizeof(SlotHeader)));
+        }
+
+        float* getChannel(int slot, bool output, int channel) const noexcept
+        {
+            auto channelSize = align(sizeof(float) * static_cast<size_t>(maxBlockSize));
+            auto channels = getSlot(slot) + align(sizeof(SlotHeader)) + align(sizeof(ChannelStripEngine::ChannelParameters) * static_cast<size_t>(numChannels));
+            return reinterpret_cast<float*>(channels + static_cast<size_t>((output ? numChannels : 0) + channel) * channelSize);
+        }
+
+        char*   base{ nullptr };
+        Header* header{ nullptr };
+        int     numChannels{ 0 };
+        int     maxBlockSize{ 0 };
+    };
+}
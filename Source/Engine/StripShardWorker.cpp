@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    StripShardWorker.cpp
+    Created: 17 Oct 2026 11:48:20pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "StripShardWorker.h"
+
+// a worker whose coordinator did not show any sign of life for this long assumes it has died
+static constexpr uint32 COORDINATOR_TIMEOUT_MS = 5000;
+static constexpr uint32 ALIVE_INTERVAL_MS = 100;
+
+StripShardWorker::StripShardWorker(const File& sharedMemoryFile)
+    : Thread("StripShardWorker"), m_sharedMemoryFile(sharedMemoryFile)
+{
+}
+
+StripShardWorker::~StripShardWorker()
+{
+    stopThread(1000);
+}
+
+bool StripShardWorker::isWorkerCommandLine(const String& commandLine)
+{
+    return StringArray::fromTokens(commandLine, true).contains(StripShardLayout::workerCommandLineOption);
+}
+
+File StripShardWorker::getSharedMemoryFile(const String& commandLine)
+{
+    auto arguments = StringArray::fromTokens(commandLine, true);
+    auto index = arguments.indexOf(StripShardLayout::workerCommandLineOption);
+    if (index < 0 || index + 1 >= arguments.size())
+        return {};
+
+    return File(arguments[index + 1].unquoted());
+}
+
+void StripShardWorker::start()
+{
+    startThread(Thread::realtimeAudioPriority);
+}
+
+bool StripShardWorker::attach()
+{
+    if (!m_sharedMemoryFile.existsAsFile())
+        return false;
+
+    m_mapping = std::make_unique<MemoryMappedFile>(m_sharedMemoryFile, MemoryMappedFile::readWrite, false);
+    if (!m_view.attach(m_mapping->getData(), m_mapping->getSize()))
+        return false;
+
+    m_engine.prepare(m_view.header->sampleRate, m_view.numChannels, m_view.maxBlockSize);
+    m_scratch.prepare(ChannelStripEngine::getScratchSize(m_view.maxBlockSize));
+    m_scratch.prefault();
+    m_inputs.calloc(static_cast<size_t>(m_view.numChannels));
+    m_outputs.calloc(static_cast<size_t>(m_view.numChannels));
+
+    return true;
+}
+
+void StripShardWorker::run()
+{
+    if (!attach())
+    {
+        DBG("StripShardWorker: could not attach to " + m_sharedMemoryFile.getFullPathName());
+        if (onFinished)
+            onFinished(1);
+        return;
+    }
+
+    ScopedNoDenormals noDenormals;
+
+    auto header = m_view.header;
+    auto blockDurationMs = 1000.0 * m_view.maxBlockSize / header->sampleRate;
+
+    auto lastBlock = header->completedBlock.load();
+    auto lastBlockTime = Time::getMillisecondCounterHiRes();
+    auto lastCoordinatorAlive = header->coordinatorAlive.load();
+    auto lastCoordinatorAliveTime = Time::getMillisecondCounter();
+    auto lastAliveTime = Time::getMillisecondCounter();
+
+    while (!threadShouldExit() && header->shutdown.load(std::memory_order_acquire) == 0)
+    {
+        auto requestedBlock = header->requestedBlock.load(std::memory_order_acquire);
+        if (requestedBlock != lastBlock)
+        {
+            // blocks requested while still busy with an older one are skipped, the coordinator already replaced them with silence
+            processBlock(requestedBlock);
+            lastBlock = requestedBlock;
+            lastBlockTime = Time::getMillisecondCounterHiRes();
+            continue;
+        }
+
+        auto now = Time::getMillisecondCounter();
+        if (now - lastAliveTime >= ALIVE_INTERVAL_MS)
+        {
+            header->workerAlive.fetch_add(1, std::memory_order_relaxed);
+            lastAliveTime = now;
+
+            auto coordinatorAlive = header->coordinatorAlive.load(std::memory_order_relaxed);
+            if (coordinatorAlive != lastCoordinatorAlive)
+            {
+                lastCoordinatorAlive = coordinatorAlive;
+                lastCoordinatorAliveTime = now;
+            }
+            else if (now - lastCoordinatorAliveTime > COORDINATOR_TIMEOUT_MS)
+            {
+                DBG("StripShardWorker: coordinator stopped responding, exiting");
+                break;
+            }
+        }
+
+        // spin while blocks are streaming, so the next one is picked up immediately, and sleep when the coordinator went idle
+        if (Time::getMillisecondCounterHiRes() - lastBlockTime < 4.0 * blockDurationMs)
+            Thread::yield();
+        else
+            Thread::sleep(1);
+    }
+
+    if (onFinished)
+        onFinished(0);
+}
+
+void StripShardWorker::processBlock(uint32 block) noexcept
+{
+    auto slot = static_cast<int>(block % StripShardLayout::numSlots);
+    auto slotHeader = m_view.getSlotHeader(slot);
+
+    if (slotHeader->inputBlock.load(std::memory_order_acquire) != block)
+        return;
+
+    auto numSamples = jlimit(0, m_view.maxBlockSize, static_cast<int>(slotHeader->numSamples));
+    auto parameters = m_view.getParameters(slot);
+    for (int ch = 0; ch < m_view.numChannels; ++ch)
+    {
+        m_engine.setChannelParameters(ch, parameters[ch]);
+        m_inputs[ch] = m_view.getChannel(slot, false, ch);
+        m_outputs[ch] = m_view.getChannel(slot, true, ch);
+    }
+
+    m_engine.process(m_inputs.get(), m_outputs.get(), m_view.numChannels, numSamples, m_scratch);
+
+    slotHeader->outputBlock.store(block, std::memory_order_release);
+    m_view.header->completedBlock.store(block, std::memory_order_release);
+}
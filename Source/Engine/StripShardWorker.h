@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    StripShardWorker.h
+    Created: 17 Oct 2026 11:48:20pm
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "StripShardLayout.h"
+#include "ScratchArena.h"
+
+//==============================================================================
+/*
+    What a strip shard worker process runs instead of the application window:
+    it attaches to the shared memory named on its command line and processes the
+    blocks its coordinator requests with a ChannelStripEngine of its own, driven
+    by the parameter values the coordinator passes along with every block.
+
+    The worker finishes when the coordinator shuts it down, or when the
+    coordinator stopped signalling it is alive, so no orphaned workers remain.
+*/
+class StripShardWorker : private Thread
+{
+public:
+    explicit StripShardWorker(const File& sharedMemoryFile);
+    ~StripShardWorker() override;
+
+    static bool isWorkerCommandLine(const String& commandLine);
+    static File getSharedMemoryFile(const String& commandLine);
+
+    /** Called on the worker thread when the worker finished, with the process exit code to use. */
+    std::function<void(int)> onFinished;
+
+    void start();
+
+private:
+    void run() override;
+
+    bool attach();
+    void processBlock(uint32 block) noexcept;
+
+    //==============================================================================
+    File                                m_sharedMemoryFile;
+    std::unique_ptr<MemoryMappedFile>   m_mapping;
+    StripShardLayout::View              m_view;
+
+    ChannelStripEngine          m_engine;
+    ScratchArena                m_scratch;
+    HeapBlock<const float*>     m_inputs;
+    HeapBlock<float*>           m_outputs;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StripShardWorker)
+};
@@ -1,114 +1,203 @@
-/*
-  ==============================================================================
-
-    Main.cpp
-    Created: 24 Jun 2020 11:52:17am
-    Author:  Christian Ahrens
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "MainPlacrossContentComponent.h"
-
-#include "../submodules/JUCE-AppBasics/Source/CustomLookAndFeel.h"
-
-//==============================================================================
-class PlacrossApplication  : public JUCEApplication
-{
-public:
-    //==============================================================================
-    PlacrossApplication() {}
-
-    const String getApplicationName() override       { return ProjectInfo::projectName; }
-    const String getApplicationVersion() override    { return ProjectInfo::versionString; }
-    bool moreThanOneInstanceAllowed() override       { return true; }
-
-    //==============================================================================
-    void initialise (const String& commandLine) override
-    {
-        ignoreUnused(commandLine);
-
-        mainWindow.reset (new MainWindow (getApplicationName()));
-    }
-
-    void shutdown() override
-    {
-        // Add your application's shutdown code here..
-
-        mainWindow = nullptr; // (deletes our window)
-    }
-
-    //==============================================================================
-    void systemRequestedQuit() override
-    {
-        // This is called when the app is being asked to quit: you can ignore this
-        // request and let the app carry on running, or call quit() to allow the app to close.
-        quit();
-    }
-
-    void anotherInstanceStarted (const String& commandLine) override
-    {
-        ignoreUnused(commandLine);
-    }
-
-    //==============================================================================
-    /*
-        This class implements the desktop window that contains an instance of
-        our MainComponent class.
-    */
-    class MainWindow    : public DocumentWindow
-    {
-    public:
-        MainWindow (String name)  : DocumentWindow (name,
-                                                    Desktop::getInstance().getDefaultLookAndFeel()
-                                                                          .findColour (ResizableWindow::backgroundColourId),
-                                                    DocumentWindow::allButtons)
-        {
-            m_customLookAndFeel = std::unique_ptr<LookAndFeel>(new JUCEAppBasics::CustomLookAndFeel);
-            Desktop::getInstance().setDefaultLookAndFeel(m_customLookAndFeel.get());
-
-            setUsingNativeTitleBar (true);
-            setContentOwned (new MainPlacrossContentComponent(), true);
-
-            // fix for unclear issue regarding black DrawableButton background in ON state
-            getLookAndFeel().setColour(DrawableButton::backgroundOnColourId, Colours::transparentWhite);
-
-           #if JUCE_IOS || JUCE_ANDROID
-            setFullScreen (true);
-           #else
-            setResizable (true, true);
-            centreWithSize (getWidth(), getHeight());
-           #endif
-
-            setVisible (true);
-        }
-
-        void closeButtonPressed() override
-        {
-            // This is called when the user tries to close this window. Here, we'll just
-            // ask the app to quit when this happens, but you can change this to do
-            // whatever you need.
-            JUCEApplication::getInstance()->systemRequestedQuit();
-        }
-
-        /* Note: Be careful if you override any DocumentWindow methods - the base
-           class uses a lot of them, so by overriding you might break its functionality.
-           It's best to do all your work in your content component instead, but if
-           you really have to override any DocumentWindow methods, make sure your
-           subclass also calls the superclass's method.
-        */
-
-    private:
-        std::unique_ptr<LookAndFeel>	m_customLookAndFeel; // our own look and feel implementation instance
-
-        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainWindow)
-    };
-
-private:
-    std::unique_ptr<MainWindow> mainWindow;
-};
-
-//==============================================================================
-// This macro generates the main() routine that launches the app.
-START_JUCE_APPLICATION (PlacrossApplication)
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 24 Jun 2020 11:52:17am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "MainPlacrossContentComponent.h"
+#include "Engine/StripShardWorker.h"
+#include "Diagnostics/EngineDiagnostics.h"
+
+#include "../submodules/JUCE-AppBasics/Source/CustomLookAndFeel.h"
+
+//==============================================================================
+class PlacrossApplication  : public JUCEApplication
+{
+public:
+    //==============================================================================
+    PlacrossApplication() {}
+
+    const String getApplicationName() override       { return ProjectInfo::projectName; }
+    const String getApplicationVersion() override    { return ProjectInfo::versionString; }
+    bool moreThanOneInstanceAllowed() override       { return true; }
+
+    //==============================================================================
+    void initialise (const String& commandLine) override
+    {
+        // started by a coordinator to process a shard of its channel strips, without any UI of its own
+        if (StripShardWorker::isWorkerCommandLine(commandLine))
+        {
+            shardWorker.reset (new StripShardWorker (StripShardWorker::getSharedMemoryFile (commandLine)));
+            shardWorker->onFinished = [] (int exitCode) {
+                MessageManager::callAsync ([exitCode] {
+                    JUCEApplicationBase::setApplicationReturnValue (exitCode);
+                    JUCEApplicationBase::quit();
+                });
+            };
+            shardWorker->start();
+            return;
+        }
+
+        // started to run the engine's benchmarks and verifications, reporting to stdout
+        if (EngineDiagnostics::isDiagnosticsCommandLine (commandLine))
+        {
+            diagnostics.reset (new EngineDiagnostics (EngineDiagnostics::getCheckNames (commandLine)));
+            diagnostics->onFinished = [] (int exitCode) {
+                MessageManager::callAsync ([exitCode] {
+                    JUCEApplicationBase::setApplicationReturnValue (exitCode);
+                    JUCEApplicationBase::quit();
+                });
+            };
+            diagnostics->start();
+            return;
+        }
+
+        mainWindow.reset (new MainWindow (getApplicationName()));
+
+        if (auto content = dynamic_cast<MainPlacrossContentComponent*> (mainWindow->getContentComponent()))
+            applyEngineOptions (*content, StringArray::fromTokens (commandLine, true));
+    }
+
+    void shutdown() override
+    {
+        // Add your application's shutdown code here..
+
+        shardWorker = nullptr;
+        diagnostics = nullptr;
+        mainWindow = nullptr; // (deletes our window)
+    }
+
+    //==============================================================================
+    void systemRequestedQuit() override
+    {
+        // This is called when the app is being asked to quit: you can ignore this
+        // request and let the app carry on running, or call quit() to allow the app to close.
+        quit();
+    }
+
+    void anotherInstanceStarted (const String& commandLine) override
+    {
+        ignoreUnused(commandLine);
+    }
+
+    //==============================================================================
+    /*
+        This class implements the desktop window that contains an instance of
+        our MainComponent class.
+    */
+    class MainWindow    : public DocumentWindow
+    {
+    public:
+        MainWindow (String name)  : DocumentWindow (name,
+                                                    Desktop::getInstance().getDefaultLookAndFeel()
+                                                                          .findColour (ResizableWindow::backgroundColourId),
+                                                    DocumentWindow::allButtons)
+        {
+            m_customLookAndFeel = std::unique_ptr<LookAndFeel>(new JUCEAppBasics::CustomLookAndFeel);
+            Desktop::getInstance().setDefaultLookAndFeel(m_customLookAndFeel.get());
+
+            setUsingNativeTitleBar (true);
+            setContentOwned (new MainPlacrossContentComponent(), true);
+
+            // fix for unclear issue regarding black DrawableButton background in ON state
+            getLookAndFeel().setColour(DrawableButton::backgroundOnColourId, Colours::transparentWhite);
+
+           #if JUCE_IOS || JUCE_ANDROID
+            setFullScreen (true);
+           #else
+            setResizable (true, true);
+            centreWithSize (getWidth(), getHeight());
+           #endif
+
+            setVisible (true);
+        }
+
+        void closeButtonPressed() override
+        {
+            // This is called when the user tries to close this window. Here, we'll just
+            // ask the app to quit when this happens, but you can change this to do
+            // whatever you need.
+            JUCEApplication::getInstance()->systemRequestedQuit();
+        }
+
+        /* Note: Be careful if you override any DocumentWindow methods - the base
+           class uses a lot of them, so by overriding you might break its functionality.
+           It's best to do all your work in your content component instead, but if
+           you really have to override any DocumentWindow methods, make sure your
+           subclass also calls the superclass's method.
+        */
+
+    private:
+        std::unique_ptr<LookAndFeel>	m_customLookAndFeel; // our own look and feel implementation instance
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainWindow)
+    };
+
+private:
+    //==============================================================================
+    /** The value following the option on the command line, empty if it is not given. */
+    static String getOptionValue (const StringArray& arguments, const String& option)
+    {
+        auto index = arguments.indexOf (option);
+        return index >= 0 ? arguments[index + 1] : String();
+    }
+
+    static void applyEngineOptions (MainPlacrossContentComponent& content, const StringArray& arguments)
+    {
+        // --max-outputs 64 opens the device (or the JACK client) with up to that many outputs, one strip each
+        if (arguments.contains ("--max-outputs"))
+            content.setMaxOutputChannelCount (getOptionValue (arguments, "--max-outputs").getIntValue());
+
+        // --performance-profile runs the device and DSP threads SCHED_FIFO with locked memory,
+        // --dsp-cores 2,3 pins them to those (isolated) cores
+        if (arguments.contains ("--performance-profile"))
+        {
+            PerformanceProfile::Settings settings;
+            settings.enabled = true;
+            for (auto const& core : StringArray::fromTokens (getOptionValue (arguments, "--dsp-cores"), ",", ""))
+                if (isPositiveAndBelow (core.getIntValue(), 64))
+                    settings.cpuAffinityMask |= uint64 (1) << core.getIntValue();
+            content.setPerformanceProfile (settings);
+        }
+
+        // --strip-shards 2 processes the strips in that many worker processes instead of in this one
+        if (arguments.contains ("--strip-shards"))
+            content.setStripShardCount (getOptionValue (arguments, "--strip-shards").getIntValue());
+
+        // --osc-port 9000 has the OSC remote control listen on that UDP port
+        if (arguments.contains ("--osc-port"))
+            if (!content.setOSCRemoteControlPort (getOptionValue (arguments, "--osc-port").getIntValue()))
+                DBG ("OSC remote control could not listen on port " + getOptionValue (arguments, "--osc-port"));
+
+        // --pipelined runs player and routing one block ahead on their own thread, at one block of latency
+        if (arguments.contains ("--pipelined"))
+            content.setPipelinedProcessingEnabled (true);
+
+        // --fused takes each block through routing, strips and metering in cache sized tiles
+        if (arguments.contains ("--fused"))
+            content.setFusedProcessingEnabled (true);
+
+        // --block-size 64 renders in blocks of that many samples, whatever the device calls back with
+        if (arguments.contains ("--block-size"))
+            content.setFixedInternalBlockSize (getOptionValue (arguments, "--block-size").getIntValue());
+
+        // --jack starts right away as a client of the running JACK server, e.g. one started with 'jackd -d dummy'
+        if (arguments.contains ("--jack"))
+            if (!content.setJackClientModeEnabled (true))
+                DBG ("JACK client mode could not be started");
+    }
+
+    //==============================================================================
+    std::unique_ptr<MainWindow> mainWindow;
+    std::unique_ptr<StripShardWorker> shardWorker;
+    std::unique_ptr<EngineDiagnostics> diagnostics;
+};
+
+//==============================================================================
+// This macro generates the main() routine that launches the app.
+START_JUCE_APPLICATION (PlacrossApplication)
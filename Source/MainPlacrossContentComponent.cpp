@@ -1,395 +1,1472 @@
-/*
-  ==============================================================================
-
-    MainPlacrossContentComponent.cpp
-    Created: 24 Jun 2020 11:52:17am
-    Author:  Christian Ahrens
-
-  ==============================================================================
-*/
-
-#include "MainPlacrossContentComponent.h"
-
-#include <iOS_utils.h>
-
-
-static constexpr int MAX_SUPPORTED_OUTPUTS = 10;
-
-//==============================================================================
-class CircleComponent : public Component
-{
-public:
-    CircleComponent()
-    {
-    };
-    CircleComponent(const Colour& colour)
-    {
-        setCircleColour(colour);
-    };
-    ~CircleComponent() override
-    {
-    };
-
-    //==========================================================================
-    void paint(Graphics& g) override
-    {
-        // (Our component is opaque, so we must completely fill the background with a solid colour)
-        g.fillAll(getLookAndFeel().findColour(ResizableWindow::backgroundColourId).darker());
-
-        auto h = static_cast<float>(getHeight());
-        auto w = static_cast<float>(getWidth());
-        Rectangle<float> smallestSquareRect;
-        if (w < h)
-        {
-            smallestSquareRect = Rectangle<float>(0, 0.5f * (h - w), w, w);
-        }
-        else
-        {
-            smallestSquareRect = Rectangle<float>(0.5f * (w - h), 0, h, h);
-        }
-
-        g.setColour(m_circleColour);
-        g.fillEllipse(smallestSquareRect);
-    };
-
-    void setCircleColour(const Colour& colour)
-    {
-        m_circleColour = colour;
-    };
-
-private:
-    //==========================================================================
-    Colour m_circleColour{ Colours::black };
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CircleComponent)
-};
-
-
-//==============================================================================
-MainPlacrossContentComponent::MainPlacrossContentComponent()
-{
-    deviceManager.initialiseWithDefaultDevices(0, MAX_SUPPORTED_OUTPUTS);
-    
-    m_playerComponent = std::make_unique<AudioPlayerComponent>();
-    m_playerComponent->addListener(this);
-    m_playerComponent->addOverlayParent(this);
-    m_playerComponent->parentResize = [this] { resized(); };
-    addAndMakeVisible(m_playerComponent.get());
-
-    m_routingComponent = std::make_unique<RoutingComponent>();
-    m_routingComponent->addOverlayParent(this);
-    m_routingComponent->parentResize = [this] { resized(); };
-    addAndMakeVisible(m_routingComponent.get());
-
-    m_analyserComponent = std::make_unique<AnalyserComponent>();
-    m_analyserComponent->addOverlayParent(this);
-    m_analyserComponent->parentResize = [this] { resized(); };
-    addAndMakeVisible(m_analyserComponent.get());
-
-    // Specify the number of output channels that we want to open
-    setChannelSetup(m_playerComponent->getCurrentChannelCount(), getCurrentDeviceChannelCount().second);
-
-    setSize(300, 550);
-}
-
-MainPlacrossContentComponent::~MainPlacrossContentComponent()
-{
-    // This shuts down the audio device and clears the audio source.
-    shutdownAudio();
-}
-
-void MainPlacrossContentComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
-{
-    m_playerComponent->prepareToPlay (samplesPerBlockExpected, sampleRate);
-
-    m_routingComponent->audioDeviceAboutToStart(deviceManager.getCurrentAudioDevice());
-
-    for (auto& stripComponentKV : m_stripComponents)
-        stripComponentKV.second->audioDeviceAboutToStart(deviceManager.getCurrentAudioDevice());
-
-    m_analyserComponent->audioDeviceAboutToStart(deviceManager.getCurrentAudioDevice());
-}
-
-void MainPlacrossContentComponent::getNextAudioBlock (const AudioSourceChannelInfo& info)
-{
-    // get the next chunk of audio from player ...
-    m_playerComponent->getNextAudioBlock (info);
-
-    // ... run it through routing
-    m_routingComponent->audioDeviceIOCallback(info.buffer->getArrayOfReadPointers(), info.buffer->getNumChannels(), info.buffer->getArrayOfWritePointers(), info.buffer->getNumChannels(), info.numSamples); // @TODO: info.startSample is not regarded here!!
-
-    // ... run it through the processorGraphs for each channel
-    for (auto i = 0; i < info.buffer->getNumChannels(); ++i)
-    {
-        if (m_stripComponents.count(i) != 0 && m_stripComponents.at(i))
-        {
-            auto ReadPointer = info.buffer->getReadPointer(i) + info.startSample;
-            auto WritePointer = info.buffer->getWritePointer(i) + info.startSample;
-            auto strip = m_stripComponents.at(i).get();
-            strip->audioDeviceIOCallback(&ReadPointer, 1, &WritePointer, 1, info.numSamples);
-        }
-    }
-
-    // ... and run it through routing
-    m_analyserComponent->audioDeviceIOCallback(info.buffer->getArrayOfReadPointers(), info.buffer->getNumChannels(), info.buffer->getArrayOfWritePointers(), info.buffer->getNumChannels(), info.numSamples); // @TODO: info.startSample is not regarded here!!
-}
-
-void MainPlacrossContentComponent::releaseResources()
-{
-    m_playerComponent->releaseResources();
-
-    for (auto& stripComponentKV : m_stripComponents)
-        stripComponentKV.second->audioDeviceStopped();
-}
-
-void MainPlacrossContentComponent::paint(Graphics &g)
-{
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll(getLookAndFeel().findColour(ResizableWindow::backgroundColourId).darker());
-}
-
-void MainPlacrossContentComponent::resized()
-{
-    auto isPortrait = getLocalBounds().getHeight() > getLocalBounds().getWidth();
-    auto safety = JUCEAppBasics::iOS_utils::getDeviceSafetyMargins();
-    auto safeBounds = getLocalBounds();
-    safeBounds.removeFromTop(safety._top);
-    safeBounds.removeFromBottom(safety._bottom);
-    safeBounds.removeFromLeft(safety._left);
-    safeBounds.removeFromRight(safety._right);
-
-    if (isOverlayActive())
-    {
-        m_activeOverlay->setBounds(safeBounds);
-    }
-    else
-    {
-        if (isPortrait)
-        {
-            FlexBox playerCirclesFb;
-            playerCirclesFb.flexDirection = FlexBox::Direction::row;
-            playerCirclesFb.items.add(FlexItem().withFlex(3));
-            for (auto& playerConCircleKV : m_playerConCircles)
-            {
-                playerCirclesFb.items.add(FlexItem(*playerConCircleKV.get()).withFlex(1));
-            }
-            playerCirclesFb.items.add(FlexItem().withFlex(3));
-
-            FlexBox routingCirclesFb;
-            routingCirclesFb.flexDirection = FlexBox::Direction::row;
-            for (auto& routingConCircleKV : m_routingConCircles)
-            {
-                routingCirclesFb.items.add(FlexItem().withFlex(2));
-                routingCirclesFb.items.add(FlexItem(*routingConCircleKV.get()).withFlex(1));
-                routingCirclesFb.items.add(FlexItem().withFlex(2));
-            }
-
-            FlexBox stripComponentsFb;
-            stripComponentsFb.flexDirection = FlexBox::Direction::row;
-            for (auto& stripComponentKV : m_stripComponents)
-            {
-                stripComponentsFb.items.add(FlexItem(*stripComponentKV.second.get()).withFlex(1).withMargin(FlexItem::Margin(0, 5, 0, 5)));
-            }
-
-            FlexBox stripCirclesFb;
-            stripCirclesFb.flexDirection = FlexBox::Direction::row;
-            for (auto& stripConCircleKV : m_stripConCircles)
-            {
-                stripCirclesFb.items.add(FlexItem().withFlex(2));
-                stripCirclesFb.items.add(FlexItem(*stripConCircleKV.get()).withFlex(1));
-                stripCirclesFb.items.add(FlexItem().withFlex(2));
-            }
-
-
-            FlexBox fb;
-            fb.flexDirection = FlexBox::Direction::column;
-            fb.items.addArray({
-                FlexItem(*m_playerComponent.get()).withMinHeight(90).withMargin(FlexItem::Margin(10,10,0,10)),
-                FlexItem(playerCirclesFb).withMinHeight(10),
-                FlexItem(*m_routingComponent.get()).withMinHeight(45).withMargin(FlexItem::Margin(0,10,0,10)),
-                FlexItem(routingCirclesFb).withMinHeight(10),
-                FlexItem(stripComponentsFb).withFlex(1).withMinHeight(150).withMargin(FlexItem::Margin(0,5,0,5)),
-                FlexItem(stripCirclesFb).withMinHeight(10),
-                FlexItem(*m_analyserComponent.get()).withMinHeight(150).withMargin(FlexItem::Margin(0,10,10,10))
-                });
-            fb.performLayout(safeBounds.toFloat());
-        }
-        else
-        {
-            FlexBox playerCirclesFb;
-            playerCirclesFb.flexDirection = FlexBox::Direction::column;
-            playerCirclesFb.items.add(FlexItem().withFlex(3));
-            for (auto& playerConCircleKV : m_playerConCircles)
-            {
-                playerCirclesFb.items.add(FlexItem(*playerConCircleKV.get()).withFlex(1));
-            }
-            playerCirclesFb.items.add(FlexItem().withFlex(3));
-
-            FlexBox routingCirclesFb;
-            routingCirclesFb.flexDirection = FlexBox::Direction::column;
-            for (auto& routingConCircleKV : m_routingConCircles)
-            {
-                routingCirclesFb.items.add(FlexItem().withFlex(2));
-                routingCirclesFb.items.add(FlexItem(*routingConCircleKV.get()).withFlex(1));
-                routingCirclesFb.items.add(FlexItem().withFlex(2));
-            }
-
-            FlexBox stripComponentsFb;
-            stripComponentsFb.flexDirection = FlexBox::Direction::column;
-            stripComponentsFb.justifyContent = FlexBox::JustifyContent::center;
-            for (auto& stripComponentKV : m_stripComponents)
-            {
-                stripComponentsFb.items.add(FlexItem(*stripComponentKV.second.get()).withFlex(1).withMargin(FlexItem::Margin(5, 0, 5, 0)));
-            }
-
-            FlexBox stripCirclesFb;
-            stripCirclesFb.flexDirection = FlexBox::Direction::column;
-            for (auto& stripConCircleKV : m_stripConCircles)
-            {
-                stripCirclesFb.items.add(FlexItem().withFlex(2));
-                stripCirclesFb.items.add(FlexItem(*stripConCircleKV.get()).withFlex(1));
-                stripCirclesFb.items.add(FlexItem().withFlex(2));
-            }
-
-
-            FlexBox fb;
-            fb.flexDirection = FlexBox::Direction::row;
-            fb.items.addArray({
-                FlexItem(*m_playerComponent.get()).withMinWidth(90).withMargin(FlexItem::Margin(10,0,10,10)),
-                FlexItem(playerCirclesFb).withMinWidth(10),
-                FlexItem(*m_routingComponent.get()).withMinWidth(45).withMargin(FlexItem::Margin(10,0,10,0)),
-                FlexItem(routingCirclesFb).withMinWidth(10),
-                FlexItem(stripComponentsFb).withFlex(1).withMinWidth(150).withMargin(FlexItem::Margin(5,0,5,0)),
-                FlexItem(stripCirclesFb).withMinWidth(10),
-                FlexItem(*m_analyserComponent.get()).withMinWidth(150).withMargin(FlexItem::Margin(10,10,10,0))
-                });
-            fb.performLayout(safeBounds.toFloat());
-        }
-    }
-}
-
-void MainPlacrossContentComponent::onNewAudiofileLoaded()
-{
-    setChannelSetup(m_playerComponent->getCurrentChannelCount(), getCurrentDeviceChannelCount().second);
-}
-
-void MainPlacrossContentComponent::setChannelSetup(int numInputChannels, int numOutputChannels, const XmlElement* const storedSettings)
-{
-    // add or remove connection indication circle components
-    // for player block depending on new input channel count
-    while (m_playerConCircles.size() > numInputChannels)
-    {
-        removeChildComponent(m_playerConCircles.back().get());
-        m_playerConCircles.pop_back();
-    }
-    while (m_playerConCircles.size() < numInputChannels)
-    {
-        auto circle = std::make_unique<CircleComponent>();
-        addAndMakeVisible(circle.get());
-        m_playerConCircles.push_back(std::move(circle));
-    }
-    
-    // add or remove channel strip components
-    // for player block depending on new output channel count
-    std::vector<int> stripsToRemove;
-    for(auto const& stripComponentKV : m_stripComponents)
-    {
-        auto stripChNum = stripComponentKV.first + 1;
-        if(stripChNum > numOutputChannels)
-            stripsToRemove.push_back(stripComponentKV.first);
-    }
-    for(auto ch : stripsToRemove)
-    {
-        removeChildComponent(m_stripComponents.at(ch).get());
-        m_stripComponents.erase(ch);
-    }
-    for (auto i = 0; i < numOutputChannels; ++i)
-    {
-        if (m_stripComponents.count(i) == 0)
-        {
-            m_stripComponents[i] = std::make_unique<ChannelStripComponent>();
-            m_stripComponents.at(i)->addOverlayParent(this);
-            m_stripComponents.at(i)->parentResize = [this] { resized(); };
-            addAndMakeVisible(m_stripComponents.at(i).get());
-        }
-    }
-    
-    // add or remove connection indication circle components
-    // for channelstrip block depending on new output channel count
-    while (m_stripConCircles.size() > numOutputChannels)
-    {
-        removeChildComponent(m_stripConCircles.back().get());
-        m_stripConCircles.pop_back();
-    }
-    while (m_stripConCircles.size() < numOutputChannels)
-    {
-        auto circle = std::make_unique<CircleComponent>();
-        addAndMakeVisible(circle.get());
-        m_stripConCircles.push_back(std::move(circle));
-    }
-
-    // update the rounting components io count accordingly
-    m_routingComponent->setIOCount(numInputChannels, numOutputChannels);
-
-    // add or remove connection indication circle components
-    // for routing block depending on new output channel count
-    while (m_routingConCircles.size() > numOutputChannels)
-    {
-        removeChildComponent(m_routingConCircles.back().get());
-        m_routingConCircles.pop_back();
-    }
-    while (m_routingConCircles.size() < numOutputChannels)
-    {
-        auto circle = std::make_unique<CircleComponent>();
-        addAndMakeVisible(circle.get());
-        m_routingConCircles.push_back(std::move(circle));
-    }
-
-    // for our baseclass, the audio device in/out count is relevant. Since we only use playback, inputs are always 0 here!
-    setAudioChannels(0, numOutputChannels, storedSettings);
-
-    // handle channel colouring
-    while (m_channelColours.size() < numInputChannels || m_channelColours.size() < numOutputChannels)
-    {
-        // dont use full 8-bits per channel, but only values from 40-216, to avoid sharp colours
-        auto r = uint8(50 + Random::getSystemRandom().nextInt(206));
-        auto g = uint8(50 + Random::getSystemRandom().nextInt(206));
-        auto b = uint8(50 + Random::getSystemRandom().nextInt(206));
-
-        m_channelColours.push_back(Colour(r, g, b));
-    }
-
-    for (int i = 0; i < numInputChannels; i++)
-    {
-        m_playerConCircles.at(i)->setCircleColour(m_channelColours.at(i));
-    }
-    for (int i = 0; i < numOutputChannels; i++)
-    {
-        m_routingConCircles.at(i)->setCircleColour(m_channelColours.at(i));
-        m_stripConCircles.at(i)->setCircleColour(m_channelColours.at(i));
-
-        if (m_stripComponents.count(i) > 0)
-            m_stripComponents.at(i)->setChannelColour(m_channelColours.at(i));
-    }
-    m_analyserComponent->setChannelColours(m_channelColours);
-    
-    // trigger one resize to update the UI arrangement if neccessary
-    resized();
-}
-
-std::pair<int, int> MainPlacrossContentComponent::getCurrentDeviceChannelCount()
-{
-    if(deviceManager.getCurrentAudioDevice())
-    {
-        auto activeInputChannels = deviceManager.getCurrentAudioDevice()->getActiveInputChannels();
-        auto activeOutputChannels = deviceManager.getCurrentAudioDevice()->getActiveOutputChannels();
-        auto maxInputChannels = activeInputChannels.getHighestBit() + 1;
-        auto maxOutputChannels = activeOutputChannels.getHighestBit() + 1;
-
-        return std::make_pair(maxInputChannels, maxOutputChannels);
-    }
-    else
-    {
-        return std::make_pair(2, 2);
-    }
-}
+/*
+  ==============================================================================
+
+    MainPlacrossContentComponent.cpp
+    Created: 24 Jun 2020 11:52:17am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "MainPlacrossContentComponent.h"
+
+#include <iOS_utils.h>
+
+
+static constexpr int DEFAULT_MAX_OUTPUTS = 10;
+static constexpr int MIN_PREPARED_INPUTS = 16;
+static constexpr int FUSED_TILE_SIZE = 64;
+
+//==============================================================================
+class CircleComponent : public Component
+{
+public:
+    CircleComponent()
+    {
+    };
+    CircleComponent(const Colour& colour)
+    {
+        setCircleColour(colour);
+    };
+    ~CircleComponent() override
+    {
+    };
+
+    //==========================================================================
+    void paint(Graphics& g) override
+    {
+        // (Our component is opaque, so we must completely fill the background with a solid colour)
+        g.fillAll(getLookAndFeel().findColour(ResizableWindow::backgroundColourId).darker());
+
+        auto h = static_cast<float>(getHeight());
+        auto w = static_cast<float>(getWidth());
+        Rectangle<float> smallestSquareRect;
+        if (w < h)
+        {
+            smallestSquareRect = Rectangle<float>(0, 0.5f * (h - w), w, w);
+        }
+        else
+        {
+            smallestSquareRect = Rectangle<float>(0.5f * (w - h), 0, h, h);
+        }
+
+        g.setColour(m_circleColour);
+        g.fillEllipse(smallestSquareRect);
+    };
+
+    void setCircleColour(const Colour& colour)
+    {
+        m_circleColour = colour;
+    };
+
+private:
+    //==========================================================================
+    Colour m_circleColour{ Colours::black };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CircleComponent)
+};
+
+
+//==============================================================================
+MainPlacrossContentComponent::MainPlacrossContentComponent()
+{
+    m_maxOutputChannels = DEFAULT_MAX_OUTPUTS;
+    deviceManager.initialiseWithDefaultDevices(0, m_maxOutputChannels);
+    
+    m_playerComponent = std::make_unique<AudioPlayerComponent>();
+    m_playerComponent->addListener(this);
+    m_playerComponent->addOverlayParent(this);
+    m_playerComponent->parentResize = [this] { resized(); };
+    addAndMakeVisible(m_playerComponent.get());
+
+    m_routingComponent = std::make_unique<RoutingComponent>();
+    m_routingComponent->addOverlayParent(this);
+    m_routingComponent->parentResize = [this] { resized(); };
+    addAndMakeVisible(m_routingComponent.get());
+
+    m_analyserComponent = std::make_unique<AnalyserComponent>();
+    m_analyserComponent->addOverlayParent(this);
+    m_analyserComponent->parentResize = [this] { resized(); };
+    addAndMakeVisible(m_analyserComponent.get());
+
+    // strips are processed in parallel on all but one core, the device thread being the remaining one
+    m_stripWorkerPool.setOptions(RealtimeWorkerPool::getDefaultOptions());
+
+    m_stripShardHost.onShardFailed = [](int, const String& description) {
+        AlertWindow::showMessageBoxAsync(AlertWindow::WarningIcon, "Strip processing", description);
+    };
+
+    m_oscRemoteControl.onStripParameterChanged = [this](int channel, OSCRemoteControl::StripParameter parameter, float value) { handleRemoteStripParameter(channel, parameter, value); };
+    m_oscRemoteControl.onRoutingChanged = [this](const std::vector<OSCRemoteControl::RoutingChange>& changes) { handleRemoteRoutingChanges(changes); };
+    m_oscRemoteControl.onTransportCommand = [this](OSCRemoteControl::TransportCommand command) { handleRemoteTransportCommand(command); };
+    m_midiRemoteControl.onControllerChanged = [this](const MidiRemoteControl::Mapping& mapping, float normalisedValue) { handleMidiController(mapping, normalisedValue); };
+
+    // Specify the number of output channels that we want to open
+    setChannelSetup(m_playerComponent->getCurrentChannelCount(), getCurrentDeviceChannelCount().second);
+
+    setSize(300, 550);
+}
+
+MainPlacrossContentComponent::~MainPlacrossContentComponent()
+{
+    stopTimer();
+    m_oscRemoteControl.setPort(0);
+    m_midiRemoteControl.setEnabled(false);
+
+    // This shuts down the audio device and clears the audio source.
+    m_jackClientDevice.reset();
+    shutdownAudio();
+}
+
+void MainPlacrossContentComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    // inputs are prepared with some headroom, so files with a different channel count can be loaded without reopening the device
+    auto numInputChannels = jmax(m_playerComponent->getCurrentChannelCount(), MIN_PREPARED_INPUTS);
+    auto numOutputChannels = getCurrentDeviceChannelCount().second;
+    m_preparedInputChannels = numInputChannels;
+
+    // everything the audio callback needs is sized here, larger device blocks are split into chunks of this size.
+    // With a fixed internal block size, that is what all stages get to see instead.
+    m_preparedFixedBlockSize = m_fixedInternalBlockSize.load();
+    m_maxBlockSize = m_preparedFixedBlockSize > 0 ? m_preparedFixedBlockSize : samplesPerBlockExpected;
+    if (m_preparedFixedBlockSize > 0)
+        m_fixedBlockAdapter.prepare(numOutputChannels, m_preparedFixedBlockSize, samplesPerBlockExpected);
+
+    // the pipeline thread might still be producing for the previous setup
+    m_sourceStagePipeline.prepare(sampleRate, numOutputChannels, m_maxBlockSize);
+
+    m_playerBuffer.setSize(numInputChannels, m_maxBlockSize, false, true, false);
+    m_analyserChannels.resize(static_cast<size_t>(numOutputChannels), nullptr);
+    m_stripInputChannels.resize(static_cast<size_t>(numOutputChannels), nullptr);
+    m_stripOutputChannels.resize(static_cast<size_t>(numOutputChannels), nullptr);
+    m_stripEngineChannels.allocate(static_cast<size_t>(numOutputChannels), true);
+    m_stripsOnChain.allocate(static_cast<size_t>(numOutputChannels), true);
+    m_stripHandoverSamplesRemaining.allocate(static_cast<size_t>(numOutputChannels), true);
+    m_stripHandoverBuffer.allocate(static_cast<size_t>(m_maxBlockSize), true);
+    m_stripHandoverSamples = jmax(1, roundToInt(sampleRate * ChannelStripComponent::getCrossfadeSeconds()));
+    m_outputLevelMeter.prepare(numOutputChannels);
+    m_outputActivityGate.prepare(numOutputChannels);
+
+    // the buffer rendered into the JACK ports gets its channel array here, the callback only points it at the ports it is handed.
+    // Until then, and for outputs without a port, it refers to a port nobody listens to.
+    if (m_jackClientDevice)
+    {
+        m_jackUnusedPort.allocate(static_cast<size_t>(samplesPerBlockExpected), true);
+        HeapBlock<float*> unusedPorts(numOutputChannels);
+        for (auto i = 0; i < numOutputChannels; ++i)
+            unusedPorts[i] = m_jackUnusedPort.get();
+        m_jackPortBuffer.setDataToReferTo(unusedPorts.get(), numOutputChannels, samplesPerBlockExpected);
+    }
+
+    m_playerComponent->prepareToPlay (m_maxBlockSize, sampleRate);
+    m_midiRemoteControl.prepare(sampleRate);
+
+    m_routingComponent->prepareRouting(numInputChannels, numOutputChannels, m_maxBlockSize);
+    m_rigMorph.prepare(numOutputChannels, numInputChannels, numOutputChannels);
+    m_sourceStageRigMorph.prepare(numOutputChannels, numInputChannels, numOutputChannels);
+
+    // block scratch of all stages is sized once here from what they report to need at most
+    m_sourceStageScratch.prepare(RoutingComponent::getRoutingScratchSize(numOutputChannels, m_maxBlockSize));
+    m_stripStageScratch.prepare(ChannelStripEngine::getScratchSize(m_maxBlockSize));
+
+    for (auto& stripComponent : m_stripComponents)
+    {
+        stripComponent->setMaximumBlockSize(m_maxBlockSize);
+        stripComponent->audioDeviceAboutToStart(getActiveAudioDevice());
+    }
+    for (auto& stripComponent : m_stripPool)
+    {
+        stripComponent->setMaximumBlockSize(m_maxBlockSize);
+        stripComponent->audioDeviceAboutToStart(getActiveAudioDevice());
+    }
+
+    // the flat strip engine gets bound to the strips of the current configuration with the first block
+    m_stripEngine.prepare(sampleRate, numOutputChannels, m_maxBlockSize);
+    m_appliedConfigurationVersion = 0;
+
+    // worker processes are (re)started for the new setup, strips stay in this process if none of them comes up
+    m_stripShardParameters.resize(static_cast<size_t>(numOutputChannels));
+    m_stripShardHost.stop();
+    if (m_stripShardCount.load() > 0 && !m_stripShardHost.start(m_stripShardCount.load(), numOutputChannels, m_maxBlockSize, sampleRate))
+        DBG("Strip shard workers could not be started, processing strips in process");
+
+    m_analyserComponent->audioDeviceAboutToStart(getActiveAudioDevice());
+
+    applyPerformanceProfile(true);
+}
+
+void MainPlacrossContentComponent::getNextAudioBlock (const AudioSourceChannelInfo& info)
+{
+    // filter states decaying towards silence must not turn into denormals anywhere in the chain
+    ScopedNoDenormals noDenormals;
+
+    // the device thread can only set up realtime scheduling for itself
+    if (m_deviceThreadSetupPending.exchange(false))
+        m_performanceProfile.applyToDeviceThread();
+
+    // the configuration is held for the whole callback, a newly published one takes effect with the next
+    RealtimeSnapshotPublisher<EngineConfiguration>::ScopedReader configuration(m_configurationPublisher);
+    if (m_maxBlockSize <= 0 || !configuration)
+    {
+        info.clearActiveBufferRegion();
+        return;
+    }
+
+    applyConfiguration(*configuration.get());
+
+    // once the transport is stopped and all strip tails have died away there is nothing to compute anymore.
+    // Starting the transport again takes effect with the very next callback.
+    auto idle = m_playerComponent->isTransportStopped() && !m_outputActivityGate.hasRunningTails();
+    m_idle = idle;
+
+    // switching between direct and pipelined processing is done here, where none of the stages is running.
+    // Activating is retried with the next callback while the pipeline thread still finishes a dropped block,
+    // which renderChunks outputs silence for instead of running the source stage alongside it.
+    auto pipelined = m_pipelinedProcessingEnabled.load() && !idle;
+    if (pipelined && !m_sourceStagePipeline.isActive())
+        m_sourceStagePipeline.activate();
+    else if (!pipelined && m_sourceStagePipeline.isActive())
+        m_sourceStagePipeline.deactivate();
+
+    if (idle)
+    {
+        info.clearActiveBufferRegion();
+        return;
+    }
+
+    if (m_preparedFixedBlockSize > 0)
+    {
+        m_internalBlockConfiguration = configuration.get();
+        m_fixedBlockAdapter.process(*info.buffer, info.startSample, info.numSamples);
+        m_internalBlockConfiguration = nullptr;
+    }
+    else
+    {
+        renderChunks(*configuration.get(), *info.buffer, info.startSample, info.numSamples);
+    }
+}
+
+void MainPlacrossContentComponent::renderInternalBlock(void* context, AudioBuffer<float>& buffer, int numSamples)
+{
+    auto owner = static_cast<MainPlacrossContentComponent*>(context);
+
+    owner->renderChunks(*owner->m_internalBlockConfiguration, buffer, 0, numSamples);
+}
+
+void MainPlacrossContentComponent::renderChunks(const EngineConfiguration& configuration, AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    for (auto offset = 0; offset < numSamples; offset += m_maxBlockSize)
+    {
+        if (m_sourceStagePipeline.isActive())
+            renderPipelinedBlock(configuration, outputBuffer, startSample + offset, jmin(m_maxBlockSize, numSamples - offset));
+        else if (m_sourceStagePipeline.isProducing())
+            outputBuffer.clear(startSample + offset, jmin(m_maxBlockSize, numSamples - offset));
+        else if (m_fusedProcessingEnabled.load() && m_stripEngineEnabled.load() && !m_stripShardHost.isStarted())
+            renderFusedBlock(configuration, outputBuffer, startSample + offset, jmin(m_maxBlockSize, numSamples - offset));
+        else
+            renderBlock(configuration, outputBuffer, startSample + offset, jmin(m_maxBlockSize, numSamples - offset));
+    }
+}
+
+void MainPlacrossContentComponent::applyConfiguration(const EngineConfiguration& configuration)
+{
+    if (configuration.version == m_appliedConfigurationVersion)
+        return;
+
+    for (auto i = 0; i < m_stripEngine.getMaxChannels(); ++i)
+        m_stripEngine.setChannelProcessors(i, i < static_cast<int>(configuration.stripProcessors.size()) ? configuration.stripProcessors[i] : ChannelStripEngine::ChannelProcessors());
+
+    m_appliedConfigurationVersion = configuration.version;
+
+    // scratch peak usage is tracked per configuration
+    m_sourceStageScratch.resetPeakUsage();
+    m_stripStageScratch.resetPeakUsage();
+    m_scratchUsageConfigurationVersion = configuration.version;
+}
+
+void MainPlacrossContentComponent::applyRigRecall(const EngineConfiguration& configuration, uint32 blockRoutingVersion)
+{
+    RealtimeSnapshotPublisher<RigRecall>::ScopedReader recall(m_rigRecallPublisher);
+    if (!recall || recall->version == m_appliedRigRecallVersion.load() || blockRoutingVersion < recall->routingVersion)
+        return;
+
+    // the targets of all strips are set before any of them processes the block, so the whole scene starts changing in the same sample
+    auto numStrips = jmin(recall->strips.size(), configuration.stripProcessors.size());
+    for (size_t i = 0; i < numStrips; ++i)
+        ChannelStripEngine::setChannelTargets(configuration.stripProcessors[i], recall->strips[i]);
+
+    m_appliedRigRecallVersion = recall->version;
+}
+
+const RoutingMatrix* MainPlacrossContentComponent::applyRigMorph(const EngineConfiguration& configuration, int numSamples)
+{
+    RealtimeSnapshotPublisher<RigMorph::Plan>::ScopedReader plan(m_rigMorphPublisher);
+    if (!plan || !m_rigMorph.process(*plan.get(), numSamples))
+        return nullptr;
+
+    auto numStrips = jmin(static_cast<size_t>(plan->numStrips), configuration.stripProcessors.size());
+    for (size_t i = 0; i < numStrips; ++i)
+        ChannelStripEngine::setChannelTargets(configuration.stripProcessors[i], m_rigMorph.getStripParameters(static_cast<int>(i)));
+
+    if (m_rigMorph.isFinished())
+        m_finishedRigMorphVersion = plan->version;
+
+    return m_rigMorph.getRoutingMatrix();
+}
+
+const RoutingMatrix* MainPlacrossContentComponent::applySourceStageRigMorph(int numSamples)
+{
+    // pipeline thread only, the strips are moved by applyRigMorph on the audio thread
+    RealtimeSnapshotPublisher<RigMorph::Plan>::ScopedReader plan(m_sourceStageRigMorphPublisher);
+    if (!plan || !m_sourceStageRigMorph.process(*plan.get(), numSamples))
+        return nullptr;
+
+    return m_sourceStageRigMorph.getRoutingMatrix();
+}
+
+void MainPlacrossContentComponent::renderBlock(const EngineConfiguration& configuration, AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    auto numOutputChannels = jmin(outputBuffer.getNumChannels(), static_cast<int>(m_analyserChannels.size()));
+
+    auto morphRouting = applyRigMorph(configuration, numSamples);
+    auto routedChannels = renderSourceStage(numOutputChannels, numSamples, morphRouting);
+    applyRigRecall(configuration, m_routingComponent->getBlockRoutingVersion());
+    m_oscRemoteControl.applyParameters(configuration.stripProcessors, *m_playerComponent);
+    m_midiRemoteControl.applyControllers(configuration.stripProcessors, numSamples);
+    renderStripStage(configuration, routedChannels, outputBuffer, startSample, numSamples);
+
+    m_routingComponent->endRoutingBlock();
+}
+
+void MainPlacrossContentComponent::renderFusedBlock(const EngineConfiguration& configuration, AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    auto numOutputChannels = jmin(outputBuffer.getNumChannels(), static_cast<int>(m_analyserChannels.size()), configuration.numOutputChannels);
+
+    // the player still renders the whole block, its output is what all tiles read from ...
+    AudioSourceChannelInfo playerInfo(&m_playerBuffer, 0, numSamples);
+    m_playerComponent->getNextAudioBlock (playerInfo);
+    auto playerChannels = m_playerBuffer.getArrayOfReadPointers();
+
+    // ... everything downstream picks up its parameters once per block, so splitting into tiles does not change the result ...
+    auto morphRouting = applyRigMorph(configuration, numSamples);
+    m_routingComponent->beginRoutingBlock(m_sourceStageScratch, m_playerBuffer.getNumChannels(), numOutputChannels, numSamples, morphRouting);
+    applyRigRecall(configuration, m_routingComponent->getBlockRoutingVersion());
+    m_oscRemoteControl.applyParameters(configuration.stripProcessors, *m_playerComponent);
+    m_midiRemoteControl.applyControllers(configuration.stripProcessors, numSamples);
+    updateStripHandovers(configuration, numOutputChannels);
+    m_stripEngine.beginBlock(numOutputChannels, numSamples);
+    m_outputLevelMeter.beginBlock(numOutputChannels);
+
+    // ... and each tile is taken through routing, strips, metering and the analyser feed while it is still in cache
+    for (auto tileStart = 0; tileStart < numSamples; tileStart += FUSED_TILE_SIZE)
+    {
+        auto tileSamples = jmin(FUSED_TILE_SIZE, numSamples - tileStart);
+
+        auto routedChannels = m_routingComponent->processRoutingRange(playerChannels, tileStart, tileSamples);
+        for (auto i = 0; i < numOutputChannels; ++i)
+        {
+            m_stripInputChannels[i] = routedChannels[i] + tileStart;
+            m_stripOutputChannels[i] = outputBuffer.getWritePointer(i, startSample + tileStart);
+            m_analyserChannels[i] = m_stripOutputChannels[i];
+        }
+
+        auto activeChannels = m_outputActivityGate.beginRange(m_stripInputChannels.data(), numOutputChannels, tileSamples);
+        m_stripEngine.processRange(m_stripInputChannels.data(), m_stripOutputChannels.data(), numOutputChannels, tileSamples, m_stripStageScratch, getStripEngineChannels(activeChannels, numOutputChannels));
+        processCustomTopologyStrips(configuration, m_stripInputChannels.data(), m_stripOutputChannels.data(), numOutputChannels, tileSamples);
+        m_outputActivityGate.endRange(m_analyserChannels.data(), numOutputChannels, tileSamples);
+        m_outputLevelMeter.accumulate(m_analyserChannels.data(), tileSamples);
+        m_analyserComponent->audioDeviceIOCallback(m_analyserChannels.data(), numOutputChannels, nullptr, 0, tileSamples);
+    }
+
+    m_outputLevelMeter.endBlock();
+    m_routingComponent->endRoutingBlock();
+
+    for (auto i = numOutputChannels; i < outputBuffer.getNumChannels(); ++i)
+        outputBuffer.clear(i, startSample, numSamples);
+}
+
+void MainPlacrossContentComponent::renderPipelinedBlock(const EngineConfiguration& configuration, AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    // player and routing run one block ahead on the pipeline thread, the strips work on what it produced before
+    // which routing the delivered block was mixed with is not known here, so a recall does not wait for it.
+    // A morph moves the strips from here, its routing is morphed along on the pipeline thread, one block ahead as well.
+    applyRigRecall(configuration, std::numeric_limits<uint32>::max());
+    applyRigMorph(configuration, numSamples);
+    m_oscRemoteControl.applyParameters(configuration.stripProcessors, *m_playerComponent);
+    m_midiRemoteControl.applyControllers(configuration.stripProcessors, numSamples);
+
+    while (numSamples > 0)
+    {
+        auto numSamplesAvailable = 0;
+        auto routedChannels = m_sourceStagePipeline.getReadPointers(numSamplesAvailable);
+        auto numSamplesToRender = jmin(numSamples, numSamplesAvailable);
+
+        renderStripStage(configuration, routedChannels, outputBuffer, startSample, numSamplesToRender);
+
+        m_sourceStagePipeline.advance(numSamplesToRender);
+        startSample += numSamplesToRender;
+        numSamples -= numSamplesToRender;
+    }
+}
+
+void MainPlacrossContentComponent::produceSourceStage(void* context, AudioBuffer<float>& buffer, int numSamples)
+{
+    auto owner = static_cast<MainPlacrossContentComponent*>(context);
+
+    auto morphRouting = owner->applySourceStageRigMorph(numSamples);
+    auto routedChannels = owner->renderSourceStage(buffer.getNumChannels(), numSamples, morphRouting);
+    for (auto i = 0; i < buffer.getNumChannels(); ++i)
+        buffer.copyFrom(i, 0, routedChannels[i], numSamples);
+
+    owner->m_routingComponent->endRoutingBlock();
+}
+
+const float* const* MainPlacrossContentComponent::renderSourceStage(int numOutputChannels, int numSamples, const RoutingMatrix* routingOverride)
+{
+    // get the next chunk of audio from player into our own buffer ...
+    AudioSourceChannelInfo playerInfo(&m_playerBuffer, 0, numSamples);
+    m_playerComponent->getNextAudioBlock (playerInfo);
+
+    // ... and run it through routing, which hands out the player channels themselves where nothing has to be mixed.
+    // The returned channels stay valid until endRoutingBlock.
+    m_routingComponent->beginRoutingBlock(m_sourceStageScratch, m_playerBuffer.getNumChannels(), numOutputChannels, numSamples, routingOverride);
+    return m_routingComponent->processRoutingRange(m_playerBuffer.getArrayOfReadPointers(), 0, numSamples);
+}
+
+void MainPlacrossContentComponent::renderStripStage(const EngineConfiguration& configuration, const float* const* routedChannels, AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    auto numOutputChannels = jmin(outputBuffer.getNumChannels(), static_cast<int>(m_analyserChannels.size()), configuration.numOutputChannels);
+
+    // muted channels and those that went silent with their tail decayed are skipped entirely
+    auto activeChannels = m_outputActivityGate.beginRange(routedChannels, numOutputChannels, numSamples);
+
+    // run the routed channels through the channel strips, writing to the device buffer ...
+    if (m_stripShardHost.isStarted())
+    {
+        // ... either handed to the worker processes, getting back what they processed from the previous range ...
+        for (auto i = 0; i < numOutputChannels; ++i)
+        {
+            m_stripOutputChannels[i] = outputBuffer.getWritePointer(i, startSample);
+            if (i < static_cast<int>(configuration.stripProcessors.size()))
+            {
+                ChannelStripEngine::applyParameterEvents(configuration.stripProcessors[i], numSamples);
+                m_stripShardParameters[i] = ChannelStripEngine::getChannelParameters(configuration.stripProcessors[i]);
+            }
+            else
+            {
+                // a highpass at 0 Hz passes the channel through unchanged, as if there was no strip
+                m_stripShardParameters[i] = ChannelStripEngine::ChannelParameters();
+                m_stripShardParameters[i].highPassGain = 1.0f;
+            }
+        }
+        m_stripShardHost.process(routedChannels, m_stripOutputChannels.data(), m_stripShardParameters.data(), numOutputChannels, numSamples);
+
+        // the workers process all of their channels, skipped ones are silenced on the way back
+        for (auto i = 0; i < numOutputChannels; ++i)
+            if (!activeChannels[i])
+                FloatVectorOperations::clear(m_stripOutputChannels[i], numSamples);
+    }
+    else if (m_stripEngineEnabled.load())
+    {
+        // ... or all channels in one go through the flat strip engine ...
+        for (auto i = 0; i < numOutputChannels; ++i)
+            m_stripOutputChannels[i] = outputBuffer.getWritePointer(i, startSample);
+        updateStripHandovers(configuration, numOutputChannels);
+        m_stripEngine.process(routedChannels, m_stripOutputChannels.data(), numOutputChannels, numSamples, m_stripStageScratch, getStripEngineChannels(activeChannels, numOutputChannels));
+        processCustomTopologyStrips(configuration, routedChannels, m_stripOutputChannels.data(), numOutputChannels, numSamples);
+    }
+    else
+    {
+        // ... or through the compiled chains / processorGraphs for each channel (fanned out across cores) ...
+        StripTaskContext stripTaskContext{ this, &configuration, routedChannels, outputBuffer.getArrayOfWritePointers(), startSample, numSamples };
+        m_stripWorkerPool.run(&MainPlacrossContentComponent::processStripTask, &stripTaskContext, numOutputChannels);
+    }
+
+    for (auto i = numOutputChannels; i < outputBuffer.getNumChannels(); ++i)
+        outputBuffer.clear(i, startSample, numSamples);
+
+    // ... and run it through metering and the analyser
+    for (auto i = 0; i < numOutputChannels; ++i)
+        m_analyserChannels[i] = outputBuffer.getReadPointer(i, startSample);
+    m_outputActivityGate.endRange(m_analyserChannels.data(), numOutputChannels, numSamples);
+    m_outputLevelMeter.beginBlock(numOutputChannels);
+    m_outputLevelMeter.accumulate(m_analyserChannels.data(), numSamples);
+    m_outputLevelMeter.endBlock();
+    m_analyserComponent->audioDeviceIOCallback(m_analyserChannels.data(), numOutputChannels, nullptr, 0, numSamples);
+}
+
+void MainPlacrossContentComponent::processStripTask(void* context, int channel)
+{
+    auto stripTaskContext = static_cast<StripTaskContext*>(context);
+    stripTaskContext->owner->processStrip(*stripTaskContext->configuration, channel, stripTaskContext->routedChannels, stripTaskContext->outputChannels, stripTaskContext->startSample, stripTaskContext->numSamples);
+}
+
+void MainPlacrossContentComponent::processStrip(const EngineConfiguration& configuration, int channel, const float* const* routedChannels, float* const* outputChannels, int startSample, int numSamples)
+{
+    auto ReadPointer = routedChannels[channel];
+    auto WritePointer = outputChannels[channel] + startSample;
+
+    auto strip = channel < static_cast<int>(configuration.strips.size()) ? configuration.strips[channel] : nullptr;
+    if (!m_outputActivityGate.isChannelActive(channel))
+    {
+        if (strip && m_outputActivityGate.hasChannelBecomeInactive(channel))
+            strip->resetProcessingState();
+
+        // the timeline goes on while the strip is skipped, as it does on the engine path, so posted events do not pile up
+        if (channel < static_cast<int>(configuration.stripProcessors.size()))
+            ChannelStripEngine::applyParameterEvents(configuration.stripProcessors[static_cast<size_t>(channel)], numSamples);
+
+        FloatVectorOperations::clear(WritePointer, numSamples);
+    }
+    else if (strip)
+    {
+        strip->audioDeviceIOCallback(&ReadPointer, 1, &WritePointer, 1, numSamples);
+    }
+    else
+    {
+        FloatVectorOperations::copy(WritePointer, ReadPointer, numSamples);
+    }
+}
+
+void MainPlacrossContentComponent::updateStripHandovers(const EngineConfiguration& configuration, int numChannels) noexcept
+{
+    for (auto i = 0; i < numChannels; ++i)
+    {
+        auto strip = i < static_cast<int>(configuration.strips.size()) ? configuration.strips[i] : nullptr;
+        auto wantsChain = strip != nullptr && i < static_cast<int>(configuration.stripsWithCustomTopology.size()) && configuration.stripsWithCustomTopology[i];
+        if (wantsChain == m_stripsOnChain[i])
+            continue;
+
+        // a strip edited to a topology the engine cannot run stays on the engine until the chain for it is compiled
+        if (wantsChain && !strip->isReadyForTopology())
+            continue;
+
+        if (m_stripHandoverSamplesRemaining[i] > 0)
+        {
+            // both paths are still running, the crossfade just turns around
+            m_stripHandoverSamplesRemaining[i] = m_stripHandoverSamples - m_stripHandoverSamplesRemaining[i];
+        }
+        else
+        {
+            // the path taking over starts from clean state and is faded in, as with a recompiled chain
+            if (wantsChain)
+                strip->resetProcessingState();
+            else
+                m_stripEngine.resetChannel(i);
+
+            m_stripHandoverSamplesRemaining[i] = m_stripHandoverSamples;
+        }
+
+        m_stripsOnChain[i] = wantsChain;
+    }
+}
+
+const bool* MainPlacrossContentComponent::getStripEngineChannels(const bool* activeChannels, int numChannels) noexcept
+{
+    // strips running their own chain are left to it, unless they are just being handed over
+    for (auto i = 0; i < numChannels; ++i)
+        m_stripEngineChannels[i] = activeChannels[i] && (!m_stripsOnChain[i] || m_stripHandoverSamplesRemaining[i] > 0);
+
+    return m_stripEngineChannels.get();
+}
+
+void MainPlacrossContentComponent::processCustomTopologyStrips(const EngineConfiguration& configuration, const float* const* routedChannels, float* const* outputChannels, int numChannels, int numSamples)
+{
+    for (auto i = 0; i < numChannels; ++i)
+    {
+        auto handoverSamplesRemaining = m_stripHandoverSamplesRemaining[i];
+        if (handoverSamplesRemaining == 0)
+        {
+            if (m_stripsOnChain[i])
+                processStrip(configuration, i, routedChannels, outputChannels, 0, numSamples);
+            continue;
+        }
+
+        // a silent channel has nothing to fade, the path taking over just goes on with the next block
+        auto strip = i < static_cast<int>(configuration.strips.size()) ? configuration.strips[i] : nullptr;
+        if (strip == nullptr || !m_outputActivityGate.isChannelActive(i))
+        {
+            if (m_stripsOnChain[i])
+                processStrip(configuration, i, routedChannels, outputChannels, 0, numSamples);
+            m_stripHandoverSamplesRemaining[i] = 0;
+            continue;
+        }
+
+        // the engine's output is already in place, the chain's is mixed in (or out) over it
+        auto input = routedChannels[i];
+        auto chainOutput = m_stripHandoverBuffer.get();
+        strip->audioDeviceIOCallback(&input, 1, &chainOutput, 1, numSamples);
+
+        auto output = outputChannels[i];
+        auto fadeStep = 1.0f / static_cast<float>(m_stripHandoverSamples);
+        for (auto sample = 0; sample < numSamples; ++sample)
+        {
+            auto chainGain = static_cast<float>(m_stripHandoverSamples - handoverSamplesRemaining) * fadeStep;
+            if (!m_stripsOnChain[i])
+                chainGain = 1.0f - chainGain;
+            output[sample] += chainGain * (chainOutput[sample] - output[sample]);
+
+            if (handoverSamplesRemaining > 0)
+                --handoverSamplesRemaining;
+        }
+        m_stripHandoverSamplesRemaining[i] = handoverSamplesRemaining;
+    }
+}
+
+void MainPlacrossContentComponent::audioDeviceIOCallback(const float** inputChannelData, int numInputChannels, float** outputChannelData, int numOutputChannels, int numSamples)
+{
+    ignoreUnused(inputChannelData, numInputChannels);
+
+    // JACK may hand out other port buffers with each cycle. Rebuilding the buffer to refer to them allocates with more than 32 channels,
+    // so its channel array prepared in prepareToPlay is pointed at them instead (which also marks the buffer as not clear).
+    if (numSamples > m_jackPortBuffer.getNumSamples())
+    {
+        jassertfalse;
+        for (auto i = 0; i < numOutputChannels; ++i)
+            FloatVectorOperations::clear(outputChannelData[i], numSamples);
+        return;
+    }
+
+    auto portChannels = m_jackPortBuffer.getArrayOfWritePointers();
+    for (auto i = 0; i < m_jackPortBuffer.getNumChannels(); ++i)
+        portChannels[i] = i < numOutputChannels ? outputChannelData[i] : m_jackUnusedPort.get();
+    for (auto i = m_jackPortBuffer.getNumChannels(); i < numOutputChannels; ++i)
+        FloatVectorOperations::clear(outputChannelData[i], numSamples);
+
+    getNextAudioBlock(AudioSourceChannelInfo(&m_jackPortBuffer, 0, numSamples));
+}
+
+void MainPlacrossContentComponent::audioDeviceAboutToStart(AudioIODevice* device)
+{
+    // JACK buffer size and sample rate changes arrive here as well
+    prepareToPlay(device->getCurrentBufferSizeSamples(), device->getCurrentSampleRate());
+}
+
+void MainPlacrossContentComponent::audioDeviceStopped()
+{
+    releaseResources();
+}
+
+void MainPlacrossContentComponent::releaseResources()
+{
+    m_sourceStagePipeline.stop();
+    m_stripShardHost.stop();
+
+    m_playerComponent->releaseResources();
+
+    for (auto& stripComponent : m_stripComponents)
+        stripComponent->audioDeviceStopped();
+}
+
+void MainPlacrossContentComponent::paint(Graphics &g)
+{
+    // (Our component is opaque, so we must completely fill the background with a solid colour)
+    g.fillAll(getLookAndFeel().findColour(ResizableWindow::backgroundColourId).darker());
+}
+
+void MainPlacrossContentComponent::resized()
+{
+    auto isPortrait = getLocalBounds().getHeight() > getLocalBounds().getWidth();
+    auto safety = JUCEAppBasics::iOS_utils::getDeviceSafetyMargins();
+    auto safeBounds = getLocalBounds();
+    safeBounds.removeFromTop(safety._top);
+    safeBounds.removeFromBottom(safety._bottom);
+    safeBounds.removeFromLeft(safety._left);
+    safeBounds.removeFromRight(safety._right);
+
+    if (isOverlayActive())
+    {
+        m_activeOverlay->setBounds(safeBounds);
+    }
+    else
+    {
+        if (isPortrait)
+        {
+            FlexBox playerCirclesFb;
+            playerCirclesFb.flexDirection = FlexBox::Direction::row;
+            playerCirclesFb.items.add(FlexItem().withFlex(3));
+            for (auto& playerConCircleKV : m_playerConCircles)
+            {
+                playerCirclesFb.items.add(FlexItem(*playerConCircleKV.get()).withFlex(1));
+            }
+            playerCirclesFb.items.add(FlexItem().withFlex(3));
+
+            FlexBox routingCirclesFb;
+            routingCirclesFb.flexDirection = FlexBox::Direction::row;
+            for (auto& routingConCircleKV : m_routingConCircles)
+            {
+                routingCirclesFb.items.add(FlexItem().withFlex(2));
+                routingCirclesFb.items.add(FlexItem(*routingConCircleKV.get()).withFlex(1));
+                routingCirclesFb.items.add(FlexItem().withFlex(2));
+            }
+
+            FlexBox stripComponentsFb;
+            stripComponentsFb.flexDirection = FlexBox::Direction::row;
+            for (auto& stripComponent : m_stripComponents)
+            {
+                stripComponentsFb.items.add(FlexItem(*stripComponent.get()).withFlex(1).withMargin(FlexItem::Margin(0, 5, 0, 5)));
+            }
+
+            FlexBox stripCirclesFb;
+            stripCirclesFb.flexDirection = FlexBox::Direction::row;
+            for (auto& stripConCircleKV : m_stripConCircles)
+            {
+                stripCirclesFb.items.add(FlexItem().withFlex(2));
+                stripCirclesFb.items.add(FlexItem(*stripConCircleKV.get()).withFlex(1));
+                stripCirclesFb.items.add(FlexItem().withFlex(2));
+            }
+
+
+            FlexBox fb;
+            fb.flexDirection = FlexBox::Direction::column;
+            fb.items.addArray({
+                FlexItem(*m_playerComponent.get()).withMinHeight(90).withMargin(FlexItem::Margin(10,10,0,10)),
+                FlexItem(playerCirclesFb).withMinHeight(10),
+                FlexItem(*m_routingComponent.get()).withMinHeight(45).withMargin(FlexItem::Margin(0,10,0,10)),
+                FlexItem(routingCirclesFb).withMinHeight(10),
+                FlexItem(stripComponentsFb).withFlex(1).withMinHeight(150).withMargin(FlexItem::Margin(0,5,0,5)),
+                FlexItem(stripCirclesFb).withMinHeight(10),
+                FlexItem(*m_analyserComponent.get()).withMinHeight(150).withMargin(FlexItem::Margin(0,10,10,10))
+                });
+            fb.performLayout(safeBounds.toFloat());
+        }
+        else
+        {
+            FlexBox playerCirclesFb;
+            playerCirclesFb.flexDirection = FlexBox::Direction::column;
+            playerCirclesFb.items.add(FlexItem().withFlex(3));
+            for (auto& playerConCircleKV : m_playerConCircles)
+            {
+                playerCirclesFb.items.add(FlexItem(*playerConCircleKV.get()).withFlex(1));
+            }
+            playerCirclesFb.items.add(FlexItem().withFlex(3));
+
+            FlexBox routingCirclesFb;
+            routingCirclesFb.flexDirection = FlexBox::Direction::column;
+            for (auto& routingConCircleKV : m_routingConCircles)
+            {
+                routingCirclesFb.items.add(FlexItem().withFlex(2));
+                routingCirclesFb.items.add(FlexItem(*routingConCircleKV.get()).withFlex(1));
+                routingCirclesFb.items.add(FlexItem().withFlex(2));
+            }
+
+            FlexBox stripComponentsFb;
+            stripComponentsFb.flexDirection = FlexBox::Direction::column;
+            stripComponentsFb.justifyContent = FlexBox::JustifyContent::center;
+            for (auto& stripComponent : m_stripComponents)
+            {
+                stripComponentsFb.items.add(FlexItem(*stripComponent.get()).withFlex(1).withMargin(FlexItem::Margin(5, 0, 5, 0)));
+            }
+
+            FlexBox stripCirclesFb;
+            stripCirclesFb.flexDirection = FlexBox::Direction::column;
+            for (auto& stripConCircleKV : m_stripConCircles)
+            {
+                stripCirclesFb.items.add(FlexItem().withFlex(2));
+                stripCirclesFb.items.add(FlexItem(*stripConCircleKV.get()).withFlex(1));
+                stripCirclesFb.items.add(FlexItem().withFlex(2));
+            }
+
+
+            FlexBox fb;
+            fb.flexDirection = FlexBox::Direction::row;
+            fb.items.addArray({
+                FlexItem(*m_playerComponent.get()).withMinWidth(90).withMargin(FlexItem::Margin(10,0,10,10)),
+                FlexItem(playerCirclesFb).withMinWidth(10),
+                FlexItem(*m_routingComponent.get()).withMinWidth(45).withMargin(FlexItem::Margin(10,0,10,0)),
+                FlexItem(routingCirclesFb).withMinWidth(10),
+                FlexItem(stripComponentsFb).withFlex(1).withMinWidth(150).withMargin(FlexItem::Margin(5,0,5,0)),
+                FlexItem(stripCirclesFb).withMinWidth(10),
+                FlexItem(*m_analyserComponent.get()).withMinWidth(150).withMargin(FlexItem::Margin(10,10,10,0))
+                });
+            fb.performLayout(safeBounds.toFloat());
+        }
+    }
+}
+
+void MainPlacrossContentComponent::onNewAudiofileLoaded()
+{
+    setChannelSetup(m_playerComponent->getCurrentChannelCount(), getCurrentDeviceChannelCount().second);
+}
+
+void MainPlacrossContentComponent::setChannelSetup(int numInputChannels, int numOutputChannels, const XmlElement* const storedSettings)
+{
+    // add or remove connection indication circle components
+    // for player block depending on new input channel count
+    while (m_playerConCircles.size() > numInputChannels)
+    {
+        removeChildComponent(m_playerConCircles.back().get());
+        m_playerConCircles.pop_back();
+    }
+    while (m_playerConCircles.size() < numInputChannels)
+    {
+        auto circle = std::make_unique<CircleComponent>();
+        addAndMakeVisible(circle.get());
+        m_playerConCircles.push_back(std::move(circle));
+    }
+    
+    // add or remove channel strip components
+    // for player block depending on new output channel count.
+    // Removed strips go to the pool instead of being destroyed, since the configuration
+    // the audio thread currently works with might still reference them.
+    while (m_stripComponents.size() > numOutputChannels)
+    {
+        removeChildComponent(m_stripComponents.back().get());
+        m_stripPool.push_back(std::move(m_stripComponents.back()));
+        m_stripComponents.pop_back();
+    }
+    while (m_stripComponents.size() < numOutputChannels)
+    {
+        std::unique_ptr<ChannelStripComponent> stripComponent;
+        if (!m_stripPool.empty())
+        {
+            stripComponent = std::move(m_stripPool.back());
+            m_stripPool.pop_back();
+        }
+        else
+        {
+            stripComponent = std::make_unique<ChannelStripComponent>();
+            stripComponent->addOverlayParent(this);
+            stripComponent->parentResize = [this] { resized(); };
+            stripComponent->onTopologyChanged = [this] { publishConfiguration(m_routingComponent->getInputChannelCount(), m_routingComponent->getOutputChannelCount()); };
+            stripComponent->onMidiLearn = [this, strip = stripComponent.get()](ChannelStripProcessorBase::ChannelStripProcessorType type, ParameterEvent::Target target) {
+                MidiRemoteControl::Mapping mapping;
+                mapping.strip = getStripIndex(strip);
+                mapping.type = type;
+                mapping.target = target;
+                setMidiRemoteControlEnabled(true);
+                m_midiRemoteControl.startLearning(mapping);
+            };
+            stripComponent->onMidiForget = [this, strip = stripComponent.get()](ChannelStripProcessorBase::ChannelStripProcessorType type) { m_midiRemoteControl.removeMappings(getStripIndex(strip), type); };
+            stripComponent->setCompiledChainEnabled(m_compiledStripChainsEnabled);
+            stripComponent->setMaximumBlockSize(m_maxBlockSize);
+            if (getActiveAudioDevice())
+                stripComponent->audioDeviceAboutToStart(getActiveAudioDevice());
+        }
+        addAndMakeVisible(stripComponent.get());
+        m_stripComponents.push_back(std::move(stripComponent));
+    }
+    
+    // add or remove connection indication circle components
+    // for channelstrip block depending on new output channel count
+    while (m_stripConCircles.size() > numOutputChannels)
+    {
+        removeChildComponent(m_stripConCircles.back().get());
+        m_stripConCircles.pop_back();
+    }
+    while (m_stripConCircles.size() < numOutputChannels)
+    {
+        auto circle = std::make_unique<CircleComponent>();
+        addAndMakeVisible(circle.get());
+        m_stripConCircles.push_back(std::move(circle));
+    }
+
+    // update the rounting components io count accordingly
+    m_routingComponent->setIOCount(numInputChannels, numOutputChannels);
+
+    // add or remove connection indication circle components
+    // for routing block depending on new output channel count
+    while (m_routingConCircles.size() > numOutputChannels)
+    {
+        removeChildComponent(m_routingConCircles.back().get());
+        m_routingConCircles.pop_back();
+    }
+    while (m_routingConCircles.size() < numOutputChannels)
+    {
+        auto circle = std::make_unique<CircleComponent>();
+        addAndMakeVisible(circle.get());
+        m_routingConCircles.push_back(std::move(circle));
+    }
+
+    // hand the new setup to the audio thread as a whole
+    publishConfiguration(numInputChannels, numOutputChannels);
+
+    // for our baseclass, the audio device in/out count is relevant. Since we only use playback, inputs are always 0 here!
+    // The device is only reopened if that count changes or the buffers prepared for it cannot take the new input count.
+    auto reopenDevice = !m_audioChannelsSet
+        || storedSettings != nullptr
+        || getCurrentDeviceChannelCount().second != numOutputChannels
+        || numInputChannels > m_preparedInputChannels;
+    if (reopenDevice)
+    {
+        openAudioDevice(numOutputChannels, storedSettings);
+        m_audioChannelsSet = true;
+    }
+
+    // handle channel colouring
+    while (m_channelColours.size() < numInputChannels || m_channelColours.size() < numOutputChannels)
+    {
+        // dont use full 8-bits per channel, but only values from 40-216, to avoid sharp colours
+        auto r = uint8(50 + Random::getSystemRandom().nextInt(206));
+        auto g = uint8(50 + Random::getSystemRandom().nextInt(206));
+        auto b = uint8(50 + Random::getSystemRandom().nextInt(206));
+
+        m_channelColours.push_back(Colour(r, g, b));
+    }
+
+    for (int i = 0; i < numInputChannels; i++)
+    {
+        m_playerConCircles.at(i)->setCircleColour(m_channelColours.at(i));
+    }
+    for (int i = 0; i < numOutputChannels; i++)
+    {
+        m_routingConCircles.at(i)->setCircleColour(m_channelColours.at(i));
+        m_stripConCircles.at(i)->setCircleColour(m_channelColours.at(i));
+
+        m_stripComponents.at(i)->setChannelColour(m_channelColours.at(i));
+    }
+    m_analyserComponent->setChannelColours(m_channelColours);
+    
+    // trigger one resize to update the UI arrangement if neccessary
+    resized();
+}
+
+void MainPlacrossContentComponent::publishConfiguration(int numInputChannels, int numOutputChannels)
+{
+    auto configuration = std::make_unique<EngineConfiguration>(++m_configurationVersion, numInputChannels, numOutputChannels);
+
+    for (auto& stripComponent : m_stripComponents)
+    {
+        // processors taken out of a strip are left out, so the engine and the shards skip them as well
+        auto const& topology = stripComponent->getTopology();
+        auto getContainedProcessor = [&stripComponent, &topology](ChannelStripProcessorBase::ChannelStripProcessorType type) {
+            return topology.contains(type) ? stripComponent->getProcessor(type) : nullptr;
+        };
+
+        configuration->strips.push_back(stripComponent.get());
+        configuration->stripProcessors.push_back({ getContainedProcessor(ChannelStripProcessorBase::CSPT_HighPass),
+                                                   getContainedProcessor(ChannelStripProcessorBase::CSPT_LowPass),
+                                                   getContainedProcessor(ChannelStripProcessorBase::CSPT_Gain) });
+        configuration->stripsWithCustomTopology.push_back(!topology.isEngineCompatible());
+    }
+
+    m_configurationPublisher.publish(std::move(configuration));
+}
+
+void MainPlacrossContentComponent::setStripProcessingOptions(const RealtimeWorkerPool::Options& options)
+{
+    m_stripWorkerPool.setOptions(getProfiledWorkerOptions(options));
+}
+
+void MainPlacrossContentComponent::setStripEngineEnabled(bool enabled)
+{
+    m_stripEngineEnabled = enabled;
+}
+
+void MainPlacrossContentComponent::setCompiledStripChainsEnabled(bool enabled)
+{
+    m_compiledStripChainsEnabled = enabled;
+
+    for (auto& stripComponent : m_stripComponents)
+        stripComponent->setCompiledChainEnabled(enabled);
+    for (auto& stripComponent : m_stripPool)
+        stripComponent->setCompiledChainEnabled(enabled);
+}
+
+void MainPlacrossContentComponent::setPipelinedProcessingEnabled(bool enabled)
+{
+    m_pipelinedProcessingEnabled = enabled;
+}
+
+void MainPlacrossContentComponent::setFusedProcessingEnabled(bool enabled)
+{
+    m_fusedProcessingEnabled = enabled;
+}
+
+void MainPlacrossContentComponent::setFixedInternalBlockSize(int numSamples)
+{
+    if (numSamples == m_fixedInternalBlockSize.load())
+        return;
+
+    m_fixedInternalBlockSize = jmax(0, numSamples);
+
+    // everything is sized for the block size in prepareToPlay, so the device is restarted to get there
+    restartAudioDevice();
+}
+
+void MainPlacrossContentComponent::setStripShardCount(int numShards)
+{
+    numShards = jlimit(0, MAX_SUPPORTED_OUTPUTS, numShards);
+    if (numShards == m_stripShardCount.load())
+        return;
+
+    m_stripShardCount = numShards;
+
+    // the workers are started for the channel count and block size of the device, which is restarted to get there
+    restartAudioDevice();
+}
+
+String MainPlacrossContentComponent::getStripShardReport() const
+{
+    return m_stripShardHost.getReport();
+}
+
+bool MainPlacrossContentComponent::setJackClientModeEnabled(bool enabled)
+{
+    if (enabled == isJackClientModeEnabled())
+        return true;
+
+    if (enabled)
+    {
+        if (!JackClientDevice::isAvailable())
+            return false;
+
+        // the regular device is closed entirely, JACK drives the callbacks from now on
+        shutdownAudio();
+
+        m_jackClientDevice = std::make_unique<JackClientDevice>(JUCEApplication::getInstance()->getApplicationName(), MAX_SUPPORTED_OUTPUTS);
+        m_jackClientDevice->onServerFormatChanged = [this] {
+            // the server changed buffer size or sample rate, everything is prepared anew as for any other reconfiguration
+            restartAudioDevice();
+            setChannelSetup(m_playerComponent->getCurrentChannelCount(), getCurrentDeviceChannelCount().second);
+        };
+        BigInteger outputChannels;
+        outputChannels.setRange(0, m_maxOutputChannels, true);
+        auto error = m_jackClientDevice->open({}, outputChannels, 0.0, 0);
+        if (error.isNotEmpty())
+        {
+            DBG("JACK client mode not available: " + error);
+            m_jackClientDevice.reset();
+            m_audioChannelsSet = false;
+            setChannelSetup(m_playerComponent->getCurrentChannelCount(), m_maxOutputChannels);
+            return false;
+        }
+        m_jackClientDevice->start(this);
+    }
+    else
+    {
+        m_jackClientDevice.reset();
+        m_audioChannelsSet = false;
+    }
+
+    setChannelSetup(m_playerComponent->getCurrentChannelCount(), m_jackClientDevice ? getCurrentDeviceChannelCount().second : m_maxOutputChannels);
+
+    return true;
+}
+
+AudioIODevice* MainPlacrossContentComponent::getActiveAudioDevice()
+{
+    if (m_jackClientDevice)
+        return m_jackClientDevice->isOpen() ? m_jackClientDevice.get() : nullptr;
+
+    return deviceManager.getCurrentAudioDevice();
+}
+
+void MainPlacrossContentComponent::openAudioDevice(int numOutputChannels, const XmlElement* const storedSettings)
+{
+    if (m_jackClientDevice)
+    {
+        // the ports are registered anew, so this only happens when the number of strips changed
+        BigInteger outputChannels;
+        outputChannels.setRange(0, numOutputChannels, true);
+        auto error = m_jackClientDevice->open({}, outputChannels, 0.0, 0);
+        if (error.isEmpty())
+            m_jackClientDevice->start(this);
+        else
+            DBG("JACK client could not be reopened: " + error);
+    }
+    else
+    {
+        setAudioChannels(0, numOutputChannels, storedSettings);
+    }
+}
+
+void MainPlacrossContentComponent::restartAudioDevice()
+{
+    if (m_jackClientDevice)
+    {
+        if (m_jackClientDevice->isOpen())
+            m_jackClientDevice->start(this);
+    }
+    else if (deviceManager.getCurrentAudioDevice())
+    {
+        deviceManager.closeAudioDevice();
+        deviceManager.restartLastAudioDevice();
+    }
+}
+
+void MainPlacrossContentComponent::setOutputMuted(int channel, bool muted)
+{
+    m_outputActivityGate.setChannelMuted(channel, muted);
+}
+
+void MainPlacrossContentComponent::setOutputSoloed(int channel, bool soloed)
+{
+    m_outputActivityGate.setChannelSoloed(channel, soloed);
+}
+
+void MainPlacrossContentComponent::getStateInformation(MemoryBlock& destData)
+{
+    createRigSnapshot().toMemoryBlock(destData);
+}
+
+bool MainPlacrossContentComponent::setStateInformation(const void* data, int sizeInBytes)
+{
+    RigSnapshot snapshot;
+    if (!snapshot.fromMemory(data, static_cast<size_t>(jmax(0, sizeInBytes))))
+        return false;
+
+    recallRigSnapshot(snapshot);
+    return true;
+}
+
+RigSnapshot MainPlacrossContentComponent::createRigSnapshot()
+{
+    RigSnapshot snapshot;
+    snapshot.numInputChannels = m_routingComponent->getInputChannelCount();
+    snapshot.numOutputChannels = m_routingComponent->getOutputChannelCount();
+    snapshot.routing = m_routingComponent->getRoutingMap();
+    snapshot.analyser = m_analyserComponent->getSettings();
+
+    for (auto const& stripComponent : m_stripComponents)
+    {
+        ChannelStripEngine::ChannelProcessors processors;
+        if (stripComponent)
+        {
+            processors.highPass = stripComponent->getProcessor(ChannelStripProcessorBase::CSPT_HighPass);
+            processors.lowPass = stripComponent->getProcessor(ChannelStripProcessorBase::CSPT_LowPass);
+            processors.gain = stripComponent->getProcessor(ChannelStripProcessorBase::CSPT_Gain);
+        }
+        snapshot.strips.push_back(ChannelStripEngine::getChannelParameters(processors));
+    }
+
+    return snapshot;
+}
+
+void MainPlacrossContentComponent::recallRigSnapshot(const RigSnapshot& snapshot)
+{
+    // a recall ends any morph that is still running
+    if (m_rigMorphPending)
+        publishRigMorphPlan(nullptr);
+    m_rigMorphPending = false;
+
+    // the strip values are published first, waiting for the routing version that is published right after
+    auto recall = std::make_unique<RigRecall>();
+    recall->version = ++m_rigRecallVersion;
+    recall->routingVersion = m_routingComponent->getNextRoutingVersion();
+    recall->strips = snapshot.strips;
+    m_rigRecallPublisher.publish(std::move(recall));
+
+    m_routingComponent->setRoutingMap(snapshot.routing);
+    m_analyserComponent->setSettings(snapshot.analyser);
+
+    startRigParameterSync(snapshot.strips, 0.0);
+}
+
+void MainPlacrossContentComponent::startRigMorph(const RigSnapshot& from, const RigSnapshot& to, double seconds)
+{
+    auto device = getActiveAudioDevice();
+    auto sampleRate = device != nullptr ? device->getCurrentSampleRate() : 48000.0;
+
+    publishRigMorphPlan(RigMorph::createPlan(from, to, seconds, sampleRate, ++m_rigMorphVersion));
+    m_rigMorphPending = true;
+
+    // the routing component already holds the target routing, it is only overridden while the morph runs
+    m_routingComponent->setRoutingMap(to.routing);
+    m_analyserComponent->setSettings(to.analyser);
+
+    startRigParameterSync(to.strips, seconds);
+}
+
+void MainPlacrossContentComponent::publishRigMorphPlan(std::unique_ptr<RigMorph::Plan> plan)
+{
+    // each reader gets its own copy, the publishers only serve one thread each
+    m_sourceStageRigMorphPublisher.publish(plan != nullptr ? std::make_unique<RigMorph::Plan>(*plan) : nullptr);
+    m_rigMorphPublisher.publish(std::move(plan));
+}
+
+void MainPlacrossContentComponent::startRigParameterSync(const std::vector<ChannelStripEngine::ChannelParameters>& strips, double seconds)
+{
+    // the parameters the editors show are only brought in line once the audio thread is done with the strips
+    m_rigParametersToSync = strips;
+    m_rigParameterSyncDeadline = Time::getMillisecondCounter() + static_cast<uint32>(seconds * 1000.0) + 500;
+    startTimer(20);
+}
+
+void MainPlacrossContentComponent::timerCallback()
+{
+    // without audio running (or while idle) nothing is going to pick up recall or morph, the parameters take over directly then
+    auto recallApplied = m_appliedRigRecallVersion.load() == m_rigRecallVersion;
+    auto morphFinished = !m_rigMorphPending || m_finishedRigMorphVersion.load() == m_rigMorphVersion;
+    if ((!recallApplied || !morphFinished) && !isIdle() && Time::getMillisecondCounter() < m_rigParameterSyncDeadline)
+        return;
+
+    stopTimer();
+
+    // a morph cut short by the deadline must not keep moving the strips away from the synced parameters
+    if (!morphFinished)
+        publishRigMorphPlan(nullptr);
+    m_rigMorphPending = false;
+
+    auto numStrips = jmin(m_rigParametersToSync.size(), m_stripComponents.size());
+    for (size_t i = 0; i < numStrips; ++i)
+    {
+        auto const& parameters = m_rigParametersToSync[i];
+        if (auto const& stripComponent = m_stripComponents[i])
+        {
+            setProcessorParameter(stripComponent->getProcessor(ChannelStripProcessorBase::CSPT_HighPass), 0, parameters.highPassCutoff);
+            setProcessorParameter(stripComponent->getProcessor(ChannelStripProcessorBase::CSPT_HighPass), 1, parameters.highPassGain);
+            setProcessorParameter(stripComponent->getProcessor(ChannelStripProcessorBase::CSPT_LowPass), 0, parameters.lowPassCutoff);
+            setProcessorParameter(stripComponent->getProcessor(ChannelStripProcessorBase::CSPT_LowPass), 1, parameters.lowPassGain);
+            setProcessorParameter(stripComponent->getProcessor(ChannelStripProcessorBase::CSPT_Gain), 0, parameters.gain);
+        }
+    }
+    m_rigParametersToSync.clear();
+}
+
+void MainPlacrossContentComponent::setProcessorParameter(ChannelStripProcessorBase* processor, int parameterIndex, float value)
+{
+    if (processor == nullptr || parameterIndex >= processor->getParameters().size())
+        return;
+
+    if (auto fParam = dynamic_cast<AudioParameterFloat*>(processor->getParameters().getUnchecked(parameterIndex)))
+        fParam->setValueNotifyingHost(fParam->convertTo0to1(fParam->getNormalisableRange().getRange().clipValue(value)));
+}
+
+bool MainPlacrossContentComponent::setOSCRemoteControlPort(int port)
+{
+    return m_oscRemoteControl.setPort(port);
+}
+
+void MainPlacrossContentComponent::handleRemoteStripParameter(int channel, OSCRemoteControl::StripParameter parameter, float value)
+{
+    // the audio thread already runs with the value, this only brings the editor in line
+    if (channel < 0 || channel >= static_cast<int>(m_stripComponents.size()) || m_stripComponents.at(channel) == nullptr)
+        return;
+
+    auto const& stripComponent = m_stripComponents.at(channel);
+    switch (parameter)
+    {
+    case OSCRemoteControl::SP_HighPassFrequency:
+        setProcessorParameter(stripComponent->getProcessor(ChannelStripProcessorBase::CSPT_HighPass), 0, value);
+        break;
+    case OSCRemoteControl::SP_HighPassGain:
+        setProcessorParameter(stripComponent->getProcessor(ChannelStripProcessorBase::CSPT_HighPass), 1, value);
+        break;
+    case OSCRemoteControl::SP_LowPassFrequency:
+        setProcessorParameter(stripComponent->getProcessor(ChannelStripProcessorBase::CSPT_LowPass), 0, value);
+        break;
+    case OSCRemoteControl::SP_LowPassGain:
+        setProcessorParameter(stripComponent->getProcessor(ChannelStripProcessorBase::CSPT_LowPass), 1, value);
+        break;
+    case OSCRemoteControl::SP_Gain:
+        setProcessorParameter(stripComponent->getProcessor(ChannelStripProcessorBase::CSPT_Gain), 0, value);
+        break;
+    case OSCRemoteControl::SP_NumParameters:
+    default:
+        break;
+    }
+}
+
+void MainPlacrossContentComponent::setMidiRemoteControlEnabled(bool enabled)
+{
+    m_midiRemoteControl.setEnabled(enabled);
+}
+
+void MainPlacrossContentComponent::handleMidiController(const MidiRemoteControl::Mapping& mapping, float normalisedValue)
+{
+    // the audio thread already runs with the value, this only brings the editor in line
+    if (!isPositiveAndBelow(mapping.strip, static_cast<int>(m_stripComponents.size())) || m_stripComponents.at(static_cast<size_t>(mapping.strip)) == nullptr)
+        return;
+
+    auto processor = m_stripComponents.at(static_cast<size_t>(mapping.strip))->getProcessor(mapping.type);
+    if (auto parameter = processor ? processor->getTargetParameter(mapping.target) : nullptr)
+        parameter->setValueNotifyingHost(normalisedValue);
+}
+
+int MainPlacrossContentComponent::getStripIndex(const ChannelStripComponent* stripComponent) const
+{
+    for (size_t i = 0; i < m_stripComponents.size(); ++i)
+        if (m_stripComponents[i].get() == stripComponent)
+            return static_cast<int>(i);
+
+    return -1;
+}
+
+void MainPlacrossContentComponent::handleRemoteRoutingChanges(const std::vector<OSCRemoteControl::RoutingChange>& changes)
+{
+    // all crosspoints received since the last call are published as one routing
+    auto routing = m_routingComponent->getRoutingMap();
+    for (auto const& change : changes)
+    {
+        auto crosspoints = routing.equal_range(change.input);
+        auto crosspoint = std::find_if(crosspoints.first, crosspoints.second, [&change](const std::pair<const int, int>& c) { return c.second == change.output; });
+        if (change.connected && crosspoint == crosspoints.second)
+            routing.insert(std::make_pair(change.input, change.output));
+        else if (!change.connected && crosspoint != crosspoints.second)
+            routing.erase(crosspoint);
+    }
+
+    m_routingComponent->setRoutingMap(routing);
+}
+
+void MainPlacrossContentComponent::handleRemoteTransportCommand(OSCRemoteControl::TransportCommand command)
+{
+    switch (command)
+    {
+    case OSCRemoteControl::TC_Play:
+        m_playerComponent->play();
+        break;
+    case OSCRemoteControl::TC_Stop:
+        m_playerComponent->stop();
+        break;
+    case OSCRemoteControl::TC_Next:
+        m_playerComponent->playNext();
+        break;
+    case OSCRemoteControl::TC_Previous:
+        m_playerComponent->playPrevious();
+        break;
+    case OSCRemoteControl::TC_NumCommands:
+    default:
+        break;
+    }
+}
+
+bool MainPlacrossContentComponent::postStripParameterEvent(int channel, ChannelStripProcessorBase::ChannelStripProcessorType type, const ParameterEvent& event)
+{
+    if (channel < 0 || channel >= static_cast<int>(m_stripComponents.size()) || m_stripComponents.at(channel) == nullptr)
+        return false;
+
+    auto processor = m_stripComponents.at(channel)->getProcessor(type);
+    return processor != nullptr && processor->postParameterEvent(event);
+}
+
+int64 MainPlacrossContentComponent::getStripSamplePosition(int channel, ChannelStripProcessorBase::ChannelStripProcessorType type)
+{
+    if (channel < 0 || channel >= static_cast<int>(m_stripComponents.size()) || m_stripComponents.at(channel) == nullptr)
+        return 0;
+
+    auto processor = m_stripComponents.at(channel)->getProcessor(type);
+    return processor != nullptr ? processor->getSamplePosition() : 0;
+}
+
+void MainPlacrossContentComponent::setPerformanceProfile(const PerformanceProfile::Settings& settings)
+{
+    m_performanceProfile.setSettings(settings);
+
+    // buffers in use by the running device are not touched again, memory locking faults them in anyway
+    if (getActiveAudioDevice())
+        applyPerformanceProfile(false);
+}
+
+String MainPlacrossContentComponent::getPerformanceReport() const
+{
+    return m_performanceProfile.getReport(m_stripWorkerPool.getNumThreadSetupFailures() + m_sourceStagePipeline.getNumThreadSetupFailures());
+}
+
+RealtimeWorkerPool::Options MainPlacrossContentComponent::getProfiledWorkerOptions(const RealtimeWorkerPool::Options& options) const
+{
+    auto profiledOptions = options;
+    auto& settings = m_performanceProfile.getSettings();
+    profiledOptions.realtimePriority = settings.enabled ? settings.workerThreadPriority : 0;
+    profiledOptions.cpuAffinityMask = settings.enabled ? settings.cpuAffinityMask : 0;
+
+    return profiledOptions;
+}
+
+void MainPlacrossContentComponent::applyPerformanceProfile(bool prefaultBuffers)
+{
+    // memory locking and the checks for the report are done here, the threads set up scheduling and pinning themselves
+    m_performanceProfile.applyProcessSettings();
+
+    // the workers are restarted only if their setup actually changes
+    auto workerOptions = getProfiledWorkerOptions(m_stripWorkerPool.getOptions());
+    if (workerOptions.realtimePriority != m_stripWorkerPool.getOptions().realtimePriority || workerOptions.cpuAffinityMask != m_stripWorkerPool.getOptions().cpuAffinityMask)
+        m_stripWorkerPool.setOptions(workerOptions);
+
+    auto& settings = m_performanceProfile.getSettings();
+    if (!settings.enabled)
+        return;
+
+    m_sourceStagePipeline.setThreadSettings(settings.workerThreadPriority, settings.cpuAffinityMask);
+
+    if (prefaultBuffers)
+    {
+        m_sourceStageScratch.prefault();
+        m_stripStageScratch.prefault();
+    }
+
+    m_deviceThreadSetupPending = true;
+
+    // the device thread sets itself up with its first callback, the report is logged once it had the chance to
+    Timer::callAfterDelay(1000, [safeThis = Component::SafePointer<MainPlacrossContentComponent>(this)] {
+        if (safeThis != nullptr)
+            Logger::writeToLog("Performance profile applied:\n" + safeThis->getPerformanceReport());
+    });
+}
+
+void MainPlacrossContentComponent::setMaxOutputChannelCount(int numOutputChannels)
+{
+    numOutputChannels = jlimit(1, MAX_SUPPORTED_OUTPUTS, numOutputChannels);
+    if (numOutputChannels == m_maxOutputChannels)
+        return;
+
+    m_maxOutputChannels = numOutputChannels;
+
+    // as a JACK client, there is one port per strip up to that count
+    if (m_jackClientDevice)
+    {
+        setChannelSetup(m_playerComponent->getCurrentChannelCount(), m_maxOutputChannels);
+        return;
+    }
+
+    // reopen the current device with up to that many outputs, everything downstream is sized from the result in prepareToPlay
+    if (auto device = deviceManager.getCurrentAudioDevice())
+    {
+        AudioDeviceManager::AudioDeviceSetup setup;
+        deviceManager.getAudioDeviceSetup(setup);
+        setup.useDefaultOutputChannels = false;
+        setup.outputChannels.clear();
+        setup.outputChannels.setRange(0, jmin(m_maxOutputChannels, device->getOutputChannelNames().size()), true);
+        deviceManager.setAudioDeviceSetup(setup, true);
+    }
+
+    setChannelSetup(m_playerComponent->getCurrentChannelCount(), getCurrentDeviceChannelCount().second);
+}
+
+int MainPlacrossContentComponent::getMaxOutputChannelCount() const
+{
+    return m_maxOutputChannels;
+}
+
+int MainPlacrossContentComponent::getProcessingLatencySamples() const
+{
+    auto latencySamples = 0;
+
+    // player decode and routing run one block ahead of the strips when pipelined
+    if (m_sourceStagePipeline.isActive())
+        latencySamples += m_sourceStagePipeline.getLatencySamples();
+
+    // re-chunking into fixed internal blocks delays by what the adapter had to buffer
+    if (m_preparedFixedBlockSize > 0)
+        latencySamples += m_fixedBlockAdapter.getLatencySamples();
+
+    // strips running in worker processes deliver one block later
+    latencySamples += m_stripShardHost.getLatencySamples();
+
+    return latencySamples;
+}
+
+String MainPlacrossContentComponent::getScratchUsageReport() const
+{
+    return "Configuration " + String(m_scratchUsageConfigurationVersion.load())
+        + ": source stage scratch peak " + String(static_cast<int64>(m_sourceStageScratch.getPeakUsage())) + " of " + String(static_cast<int64>(m_sourceStageScratch.getCapacity())) + " bytes"
+        + ", strip stage scratch peak " + String(static_cast<int64>(m_stripStageScratch.getPeakUsage())) + " of " + String(static_cast<int64>(m_stripStageScratch.getCapacity())) + " bytes";
+}
+
+std::pair<int, int> MainPlacrossContentComponent::getCurrentDeviceChannelCount()
+{
+    if(auto device = getActiveAudioDevice())
+    {
+        auto activeInputChannels = device->getActiveInputChannels();
+        auto activeOutputChannels = device->getActiveOutputChannels();
+        auto maxInputChannels = activeInputChannels.getHighestBit() + 1;
+        auto maxOutputChannels = activeOutputChannels.getHighestBit() + 1;
+
+        return std::make_pair(maxInputChannels, maxOutputChannels);
+    }
+    else
+    {
+        return std::make_pair(2, 2);
+    }
+}
@@ -1,66 +1,271 @@
-/*
-  ==============================================================================
-
-    MainPlacrossContentComponent.h
-    Created: 24 Jun 2020 11:52:17am
-    Author:  Christian Ahrens
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-#include "AudioPlayer/AudioPlayerComponent.h"
-#include "Routing/RoutingComponent.h"
-#include "ChannelStrip/ChannelStripComponent.h"
-#include "Analyser/AnalyserComponent.h"
-
-#include "../submodules/JUCE-AppBasics/Source/OverlayToggleComponentBase.h"
-
-class CircleComponent;
-
-//==============================================================================
-/*
-    This component lives inside our window, and this is where you should put all
-    your controls and content.
-*/
-class MainPlacrossContentComponent   :  public AudioAppComponent,
-                                        public AudioPlayerComponent::Listener,
-                                        public JUCEAppBasics::OverlayToggleComponentBase::OverlayParent
-{
-public:
-    MainPlacrossContentComponent();
-    ~MainPlacrossContentComponent() override;
-
-    void setChannelSetup(int numInputChannels, int numOutputChannels, const XmlElement* const storedSettings = nullptr);
-
-    std::pair<int, int> getCurrentDeviceChannelCount();
-
-    //==========================================================================
-    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
-    void getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill) override;
-    void releaseResources() override;
-    
-    //==========================================================================
-    void paint(Graphics&) override;
-    void resized() override;
-
-    //==========================================================================
-    void onNewAudiofileLoaded() override;
-
-private:
-    //==========================================================================
-    std::unique_ptr<AudioPlayerComponent>                   m_playerComponent;
-    std::vector<std::unique_ptr<CircleComponent>>           m_playerConCircles;
-    std::unique_ptr<RoutingComponent>                       m_routingComponent;
-    std::vector<std::unique_ptr<CircleComponent>>           m_routingConCircles;
-    std::map<int, std::unique_ptr<ChannelStripComponent>>   m_stripComponents;
-    std::vector<std::unique_ptr<CircleComponent>>           m_stripConCircles;
-    std::unique_ptr<AnalyserComponent>                      m_analyserComponent;
-
-    std::vector<Colour> m_channelColours;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainPlacrossContentComponent)
-};
+/*
+  ==============================================================================
+
+    MainPlacrossContentComponent.h
+    Created: 24 Jun 2020 11:52:17am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "AudioPlayer/AudioPlayerComponent.h"
+#include "Routing/RoutingComponent.h"
+#include "ChannelStrip/ChannelStripComponent.h"
+#include "ChannelStrip/ChannelStripEngine.h"
+#include "Analyser/AnalyserComponent.h"
+#include "Engine/RealtimeWorkerPool.h"
+#include "Engine/RealtimeBlockPipeline.h"
+#include "Engine/RealtimeSnapshotPublisher.h"
+#include "Engine/EngineConfiguration.h"
+#include "Engine/ScratchArena.h"
+#include "Engine/ChannelLevelMeter.h"
+#include "Engine/FixedBlockAdapter.h"
+#include "Engine/ChannelActivityGate.h"
+#include "Engine/PerformanceProfile.h"
+#include "Engine/StripShardHost.h"
+#include "Engine/JackClientDevice.h"
+#include "Engine/RigSnapshot.h"
+#include "Engine/RigMorph.h"
+#include "Remote/MidiRemoteControl.h"
+#include "Remote/OSCRemoteControl.h"
+
+#include "../submodules/JUCE-AppBasics/Source/OverlayToggleComponentBase.h"
+
+class CircleComponent;
+
+//==============================================================================
+/*
+    This component lives inside our window, and this is where you should put all
+    your controls and content.
+*/
+class MainPlacrossContentComponent   :  public AudioAppComponent,
+                                        private AudioIODeviceCallback,
+                                        private Timer,
+                                        public AudioPlayerComponent::Listener,
+                                        public JUCEAppBasics::OverlayToggleComponentBase::OverlayParent
+{
+public:
+    MainPlacrossContentComponent();
+    ~MainPlacrossContentComponent() override;
+
+    void setChannelSetup(int numInputChannels, int numOutputChannels, const XmlElement* const storedSettings = nullptr);
+
+    std::pair<int, int> getCurrentDeviceChannelCount();
+
+    /** Upper limit for the number of device outputs opened (and strips created), up to 256. */
+    void setMaxOutputChannelCount(int numOutputChannels);
+    int getMaxOutputChannelCount() const;
+
+    void setStripProcessingOptions(const RealtimeWorkerPool::Options& options);
+    void setStripEngineEnabled(bool enabled);
+    void setCompiledStripChainsEnabled(bool enabled);
+    void setPipelinedProcessingEnabled(bool enabled);
+    void setFusedProcessingEnabled(bool enabled);
+    void setFixedInternalBlockSize(int numSamples);
+    /** Runs the strips in that many worker processes (0 processes them in this one), at one block of latency. */
+    void setStripShardCount(int numShards);
+    String getStripShardReport() const;
+    void setOutputMuted(int channel, bool muted);
+    void setOutputSoloed(int channel, bool soloed);
+    /** Message thread. Schedules a cutoff or gain change of a strip at the exact sample of its timeline, see getStripSamplePosition(). */
+    bool postStripParameterEvent(int channel, ChannelStripProcessorBase::ChannelStripProcessorType type, const ParameterEvent& event);
+    int64 getStripSamplePosition(int channel, ChannelStripProcessorBase::ChannelStripProcessorType type);
+    /** Runs as a native JACK client with one output port per strip instead of on the selected device.
+        Returns false if JACK support is not available or no JACK server could be reached. */
+    bool setJackClientModeEnabled(bool enabled);
+    bool isJackClientModeEnabled() const { return m_jackClientDevice != nullptr; };
+    void setPerformanceProfile(const PerformanceProfile::Settings& settings);
+    String getPerformanceReport() const;
+    int getProcessingLatencySamples() const;
+    bool isIdle() const { return m_idle.load(); };
+    String getScratchUsageReport() const;
+    const ChannelLevelMeter& getOutputLevelMeter() const { return m_outputLevelMeter; };
+
+    //==========================================================================
+    /** Binary state of all strips, the routing and the analyser, see RigSnapshot. */
+    void getStateInformation(MemoryBlock& destData);
+    bool setStateInformation(const void* data, int sizeInBytes);
+    RigSnapshot createRigSnapshot();
+    /** Applies the snapshot as a whole with the next block, all strips in the same block the new routing takes effect in. */
+    void recallRigSnapshot(const RigSnapshot& snapshot);
+    /** Moves strips and routing from one snapshot to the other over the given time, cutoffs on a log scale.
+        The rig ends up as if the second one had been recalled. */
+    void startRigMorph(const RigSnapshot& from, const RigSnapshot& to, double seconds);
+    bool isRigMorphRunning() const { return m_rigMorphPending; };
+
+    //==========================================================================
+    /** Listens for OSC remote control on the UDP port (0 stops it), see OSCRemoteControl for the addresses. */
+    bool setOSCRemoteControlPort(int port);
+    const OSCRemoteControl& getOSCRemoteControl() const { return m_oscRemoteControl; };
+    /** Listens to all MIDI inputs for the controllers learned from the strips' menus. */
+    void setMidiRemoteControlEnabled(bool enabled);
+    MidiRemoteControl& getMidiRemoteControl() { return m_midiRemoteControl; };
+
+    //==========================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill) override;
+    void releaseResources() override;
+    
+    //==========================================================================
+    void paint(Graphics&) override;
+    void resized() override;
+
+    //==========================================================================
+    void onNewAudiofileLoaded() override;
+
+private:
+    //==========================================================================
+    void audioDeviceIOCallback(const float** inputChannelData, int numInputChannels, float** outputChannelData, int numOutputChannels, int numSamples) override;
+    void audioDeviceAboutToStart(AudioIODevice* device) override;
+    void audioDeviceStopped() override;
+
+    //==========================================================================
+    void timerCallback() override;
+
+    //==========================================================================
+    AudioIODevice* getActiveAudioDevice();
+    void openAudioDevice(int numOutputChannels, const XmlElement* const storedSettings);
+    void restartAudioDevice();
+    void publishConfiguration(int numInputChannels, int numOutputChannels);
+    void applyConfiguration(const EngineConfiguration& configuration);
+    void applyRigRecall(const EngineConfiguration& configuration, uint32 blockRoutingVersion);
+    const RoutingMatrix* applyRigMorph(const EngineConfiguration& configuration, int numSamples);
+    const RoutingMatrix* applySourceStageRigMorph(int numSamples);
+    void publishRigMorphPlan(std::unique_ptr<RigMorph::Plan> plan);
+    void startRigParameterSync(const std::vector<ChannelStripEngine::ChannelParameters>& strips, double seconds);
+    static void setProcessorParameter(ChannelStripProcessorBase* processor, int parameterIndex, float value);
+    void handleRemoteStripParameter(int channel, OSCRemoteControl::StripParameter parameter, float value);
+    void handleRemoteRoutingChanges(const std::vector<OSCRemoteControl::RoutingChange>& changes);
+    void handleRemoteTransportCommand(OSCRemoteControl::TransportCommand command);
+    void handleMidiController(const MidiRemoteControl::Mapping& mapping, float normalisedValue);
+    int getStripIndex(const ChannelStripComponent* stripComponent) const;
+    void applyPerformanceProfile(bool prefaultBuffers);
+    RealtimeWorkerPool::Options getProfiledWorkerOptions(const RealtimeWorkerPool::Options& options) const;
+
+    //==========================================================================
+    void renderChunks(const EngineConfiguration& configuration, AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+    void renderBlock(const EngineConfiguration& configuration, AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+    void renderFusedBlock(const EngineConfiguration& configuration, AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+    void renderPipelinedBlock(const EngineConfiguration& configuration, AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+    const float* const* renderSourceStage(int numOutputChannels, int numSamples, const RoutingMatrix* routingOverride = nullptr);
+    void renderStripStage(const EngineConfiguration& configuration, const float* const* routedChannels, AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+    void processStrip(const EngineConfiguration& configuration, int channel, const float* const* routedChannels, float* const* outputChannels, int startSample, int numSamples);
+    void updateStripHandovers(const EngineConfiguration& configuration, int numChannels) noexcept;
+    const bool* getStripEngineChannels(const bool* activeChannels, int numChannels) noexcept;
+    void processCustomTopologyStrips(const EngineConfiguration& configuration, const float* const* routedChannels, float* const* outputChannels, int numChannels, int numSamples);
+
+    //==========================================================================
+    struct StripTaskContext
+    {
+        MainPlacrossContentComponent*   owner{ nullptr };
+        const EngineConfiguration*      configuration{ nullptr };
+        const float* const*             routedChannels{ nullptr };
+        float* const*                   outputChannels{ nullptr };
+        int                             startSample{ 0 };
+        int                             numSamples{ 0 };
+    };
+    static void processStripTask(void* context, int channel);
+    static void produceSourceStage(void* context, AudioBuffer<float>& buffer, int numSamples);
+    static void renderInternalBlock(void* context, AudioBuffer<float>& buffer, int numSamples);
+
+    //==========================================================================
+    std::unique_ptr<AudioPlayerComponent>                   m_playerComponent;
+    std::vector<std::unique_ptr<CircleComponent>>           m_playerConCircles;
+    std::unique_ptr<RoutingComponent>                       m_routingComponent;
+    std::vector<std::unique_ptr<CircleComponent>>           m_routingConCircles;
+    std::vector<std::unique_ptr<ChannelStripComponent>>     m_stripComponents;
+    std::vector<std::unique_ptr<ChannelStripComponent>>     m_stripPool;
+    std::vector<std::unique_ptr<CircleComponent>>           m_stripConCircles;
+    std::unique_ptr<AnalyserComponent>                      m_analyserComponent;
+
+    std::vector<Colour> m_channelColours;
+
+    //==========================================================================
+    RealtimeSnapshotPublisher<EngineConfiguration>  m_configurationPublisher;
+    uint32                                          m_configurationVersion{ 0 };
+    uint32                                          m_appliedConfigurationVersion{ 0 };
+    bool                                            m_audioChannelsSet{ false };
+    int                                             m_preparedInputChannels{ 0 };
+    int                                             m_maxOutputChannels{ 0 };
+
+    //==========================================================================
+    int                         m_maxBlockSize{ 0 };
+    AudioBuffer<float>          m_playerBuffer;
+    std::vector<const float*>   m_analyserChannels;
+    RealtimeWorkerPool          m_stripWorkerPool;
+    ChannelStripEngine          m_stripEngine;
+    std::atomic<bool>           m_stripEngineEnabled{ true };
+    bool                        m_compiledStripChainsEnabled{ true };
+    std::vector<const float*>   m_stripInputChannels;
+    std::vector<float*>         m_stripOutputChannels;
+    HeapBlock<bool>             m_stripEngineChannels;
+    // strips switching between the engine and their own chain run on both while one is crossfaded to the other
+    HeapBlock<bool>             m_stripsOnChain;
+    HeapBlock<int>              m_stripHandoverSamplesRemaining;
+    HeapBlock<float>            m_stripHandoverBuffer;
+    int                         m_stripHandoverSamples{ 0 };
+    std::atomic<bool>           m_fusedProcessingEnabled{ false };
+    ChannelLevelMeter           m_outputLevelMeter;
+    ChannelActivityGate         m_outputActivityGate;
+    std::atomic<bool>           m_idle{ false };
+    RealtimeBlockPipeline       m_sourceStagePipeline{ &MainPlacrossContentComponent::produceSourceStage, this };
+    std::atomic<bool>           m_pipelinedProcessingEnabled{ false };
+
+    // device callbacks are re-chunked into blocks of a fixed size if one is set (0 follows the device)
+    FixedBlockAdapter           m_fixedBlockAdapter{ &MainPlacrossContentComponent::renderInternalBlock, this };
+    std::atomic<int>            m_fixedInternalBlockSize{ 0 };
+    int                         m_preparedFixedBlockSize{ 0 };
+    const EngineConfiguration*  m_internalBlockConfiguration{ nullptr };
+
+    // one scratch arena per pipeline stage, since the stages run on different threads when pipelined
+    ScratchArena                m_sourceStageScratch;
+    ScratchArena                m_stripStageScratch;
+    std::atomic<uint32>         m_scratchUsageConfigurationVersion{ 0 };
+
+    // strips processed by worker processes, the coordinator (this one) only keeps player and routing
+    StripShardHost                                      m_stripShardHost;
+    std::atomic<int>                                    m_stripShardCount{ 0 };
+    std::vector<ChannelStripEngine::ChannelParameters>  m_stripShardParameters;
+
+    // a recalled rig waits for the routing published with it, the strips are switched in the block it is first mixed with
+    struct RigRecall
+    {
+        uint32                                              version{ 0 };
+        uint32                                              routingVersion{ 0 };
+        std::vector<ChannelStripEngine::ChannelParameters>  strips;
+    };
+    RealtimeSnapshotPublisher<RigRecall>                m_rigRecallPublisher;
+    uint32                                              m_rigRecallVersion{ 0 };
+    std::atomic<uint32>                                 m_appliedRigRecallVersion{ 0 };
+    std::vector<ChannelStripEngine::ChannelParameters>  m_rigParametersToSync;
+    uint32                                              m_rigParameterSyncDeadline{ 0 };
+
+    // a morph is computed on the audio thread block by block, the plan it follows is published from here
+    RigMorph                                            m_rigMorph;
+    RealtimeSnapshotPublisher<RigMorph::Plan>           m_rigMorphPublisher;
+    // with the pipeline, the routing runs a block ahead on its own thread, which follows the same plan with a morph of its own
+    RigMorph                                            m_sourceStageRigMorph;
+    RealtimeSnapshotPublisher<RigMorph::Plan>           m_sourceStageRigMorphPublisher;
+    uint32                                              m_rigMorphVersion{ 0 };
+    std::atomic<uint32>                                 m_finishedRigMorphVersion{ 0 };
+    bool                                                m_rigMorphPending{ false };
+
+    // remote strip values reach the audio thread without passing the message thread, see OSCRemoteControl
+    OSCRemoteControl                                    m_oscRemoteControl;
+    // learned MIDI controllers are posted as parameter events at their offset in the block, see MidiRemoteControl
+    MidiRemoteControl                                   m_midiRemoteControl{ deviceManager };
+
+    // JACK client mode renders into the port buffers directly, bypassing the device manager
+    std::unique_ptr<JackClientDevice>   m_jackClientDevice;
+    AudioBuffer<float>                  m_jackPortBuffer;
+    HeapBlock<float>                    m_jackUnusedPort;
+
+    PerformanceProfile          m_performanceProfile;
+    std::atomic<bool>           m_deviceThreadSetupPending{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainPlacrossContentComponent)
+};
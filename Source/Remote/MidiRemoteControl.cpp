@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+
+    MidiRemoteControl.cpp
+    Created: 18 Oct 2026 5:36:44am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "MidiRemoteControl.h"
+
+MidiRemoteControl::MidiRemoteControl(AudioDeviceManager& deviceManager)
+    : m_deviceManager(deviceManager)
+{
+    for (auto& mapping : m_mappings)
+        mapping.store(-1);
+    for (auto& value : m_editorValues)
+        value.store(-1);
+}
+
+MidiRemoteControl::~MidiRemoteControl()
+{
+    setEnabled(false);
+}
+
+void MidiRemoteControl::setEnabled(bool enabled)
+{
+    if (enabled == m_enabled)
+        return;
+
+    m_enabled = enabled;
+    if (enabled)
+    {
+        for (auto const& device : MidiInput::getAvailableDevices())
+            m_deviceManager.setMidiInputDeviceEnabled(device.identifier, true);
+        m_deviceManager.addMidiInputDeviceCallback({}, this);
+        startTimerHz(20);
+    }
+    else
+    {
+        m_deviceManager.removeMidiInputDeviceCallback({}, this);
+        stopTimer();
+    }
+}
+
+//==============================================================================
+int32 MidiRemoteControl::pack(const Mapping& mapping) noexcept
+{
+    if (!mapping.isValid() || mapping.type >= ChannelStripProcessorBase::CSPT_Invalid)
+        return -1;
+
+    return (static_cast<int32>(mapping.strip & 0xffff) << 16) | (static_cast<int32>(mapping.type) << 8) | static_cast<int32>(mapping.target);
+}
+
+MidiRemoteControl::Mapping MidiRemoteControl::unpack(int32 packedMapping) noexcept
+{
+    Mapping mapping;
+    if (packedMapping < 0)
+        return mapping;
+
+    mapping.strip = (packedMapping >> 16) & 0xffff;
+    mapping.type = static_cast<ChannelStripProcessorBase::ChannelStripProcessorType>((packedMapping >> 8) & 0xff);
+    mapping.target = static_cast<ParameterEvent::Target>(packedMapping & 0xff);
+    return mapping;
+}
+
+int MidiRemoteControl::getControllerIndex(int midiChannel, int controllerNumber) noexcept
+{
+    if (!isPositiveAndBelow(midiChannel - 1, numMidiChannels) || !isPositiveAndBelow(controllerNumber, numControllerNumbers))
+        return -1;
+
+    return (midiChannel - 1) * numControllerNumbers + controllerNumber;
+}
+
+void MidiRemoteControl::startLearning(const Mapping& mapping) noexcept
+{
+    m_learnMapping = pack(mapping);
+}
+
+void MidiRemoteControl::stopLearning() noexcept
+{
+    m_learnMapping = -1;
+}
+
+void MidiRemoteControl::setMapping(int midiChannel, int controllerNumber, const Mapping& mapping) noexcept
+{
+    auto controller = getControllerIndex(midiChannel, controllerNumber);
+    if (controller >= 0)
+        m_mappings[static_cast<size_t>(controller)] = pack(mapping);
+}
+
+MidiRemoteControl::Mapping MidiRemoteControl::getMapping(int midiChannel, int controllerNumber) const noexcept
+{
+    auto controller = getControllerIndex(midiChannel, controllerNumber);
+    return controller >= 0 ? unpack(m_mappings[static_cast<size_t>(controller)].load()) : Mapping();
+}
+
+void MidiRemoteControl::removeMappings(int strip, ChannelStripProcessorBase::ChannelStripProcessorType type) noexcept
+{
+    for (auto& packedMapping : m_mappings)
+    {
+        auto mapping = unpack(packedMapping.load());
+        if (mapping.strip == strip && mapping.type == type)
+            packedMapping = -1;
+    }
+}
+
+//==============================================================================
+void MidiRemoteControl::handleIncomingMidiMessage(MidiInput* source, const MidiMessage& message)
+{
+    ignoreUnused(source);
+
+    handleMessage(message);
+}
+
+void MidiRemoteControl::handleMessage(const MidiMessage& message) noexcept
+{
+    if (!message.isController())
+        return;
+
+    auto controller = getControllerIndex(message.getChannel(), message.getControllerNumber());
+    if (controller < 0)
+        return;
+
+    // learning takes the first controller moved, which then only drives that parameter
+    auto learnMapping = m_learnMapping.exchange(-1);
+    if (learnMapping >= 0)
+    {
+        for (auto& packedMapping : m_mappings)
+            if (packedMapping.load() == learnMapping)
+                packedMapping = -1;
+        m_mappings[static_cast<size_t>(controller)] = learnMapping;
+    }
+
+    if (m_mappings[static_cast<size_t>(controller)].load() < 0)
+        return;
+
+    int start1, size1, start2, size2;
+    m_fifo.prepareToWrite(1, start1, size1, start2, size2);
+    if (size1 + size2 < 1)
+    {
+        m_numDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto& change = m_changes[static_cast<size_t>(size1 > 0 ? start1 : start2)];
+    change.timeStamp = message.getTimeStamp() > 0.0 ? message.getTimeStamp() : Time::getMillisecondCounterHiRes() * 0.001;
+    change.controller = controller;
+    change.value = message.getControllerValue();
+    m_fifo.finishedWrite(1);
+
+    m_editorValues[static_cast<size_t>(controller)] = change.value;
+}
+
+void MidiRemoteControl::timerCallback()
+{
+    if (!onControllerChanged)
+        return;
+
+    for (size_t controller = 0; controller < m_editorValues.size(); ++controller)
+    {
+        auto value = m_editorValues[controller].exchange(-1);
+        if (value < 0)
+            continue;
+
+        auto mapping = unpack(m_mappings[controller].load());
+        if (mapping.isValid())
+            onControllerChanged(mapping, static_cast<float>(value) / 127.0f);
+    }
+}
+
+//==============================================================================
+void MidiRemoteControl::prepare(double sampleRate)
+{
+    m_sampleRate = sampleRate;
+}
+
+void MidiRemoteControl::applyControllers(const std::vector<ChannelStripEngine::ChannelProcessors>& stripProcessors, int numSamples) noexcept
+{
+    auto numReady = m_fifo.getNumReady();
+    if (numReady == 0 || numSamples <= 0)
+        return;
+
+    // the changes arrived during the last block period, they are spread over this block with the same relative timing
+    auto now = Time::getMillisecondCounterHiRes() * 0.001;
+
+    auto apply = [&](const ControllerChange& change)
+    {
+        auto mapping = unpack(m_mappings[static_cast<size_t>(change.controller)].load());
+        if (!isPositiveAndBelow(mapping.strip, static_cast<int>(stripProcessors.size())))
+            return;
+
+        auto const& processors = stripProcessors[static_cast<size_t>(mapping.strip)];
+        auto processor = mapping.type == ChannelStripProcessorBase::CSPT_HighPass ? processors.highPass
+            : mapping.type == ChannelStripProcessorBase::CSPT_LowPass ? processors.lowPass
+            : processors.gain;
+        auto parameter = processor ? processor->getTargetParameter(mapping.target) : nullptr;
+        if (parameter == nullptr)
+            return;
+
+        auto offset = jlimit(0, numSamples - 1, numSamples - roundToInt((now - change.timeStamp) * m_sampleRate));
+
+        ParameterEvent event;
+        event.samplePosition = processor->getSamplePosition() + offset;
+        event.target = mapping.target;
+        event.value = parameter->getNormalisableRange().convertFrom0to1(static_cast<float>(change.value) / 127.0f);
+        if (!processor->postParameterEventFromAudioThread(event))
+            m_numDropped.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    int start1, size1, start2, size2;
+    m_fifo.prepareToRead(numReady, start1, size1, start2, size2);
+    for (auto i = 0; i < size1; ++i)
+        apply(m_changes[static_cast<size_t>(start1 + i)]);
+    for (auto i = 0; i < size2; ++i)
+        apply(m_changes[static_cast<size_t>(start2 + i)]);
+    m_fifo.finishedRead(size1 + size2);
+}
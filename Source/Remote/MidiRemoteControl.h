@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    MidiRemoteControl.h
+    Created: 18 Oct 2026 5:36:44am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "../ChannelStrip/ChannelStripEngine.h"
+
+//==============================================================================
+/*
+    MIDI controller input with CC learn for the strip parameters.
+
+    Controllers are mapped in a fixed table with one entry per MIDI channel and
+    controller number, each a single atomic word, so mapping, learning and lookup
+    never allocate or lock and any number of mapped controls costs the same.
+
+    Controller changes are timestamped on the MIDI thread and handed to the audio
+    thread through a fixed-size fifo. The audio thread places each one at the sample
+    offset it arrived at within the last block period (as MidiMessageCollector does)
+    and posts it as a parameter event of the mapped processor, so it takes effect at
+    that sample wherever the strip is processed, without the message thread involved.
+    The editors are brought in line afterwards, with the latest value per controller.
+*/
+class MidiRemoteControl  : private MidiInputCallback,
+                           private Timer
+{
+public:
+    static constexpr int numMidiChannels = 16;
+    static constexpr int numControllerNumbers = 128;
+    static constexpr int numControllers = numMidiChannels * numControllerNumbers;
+    static constexpr int fifoCapacity = 1024;
+
+    struct Mapping
+    {
+        int                                                 strip{ -1 };
+        ChannelStripProcessorBase::ChannelStripProcessorType type{ ChannelStripProcessorBase::CSPT_Invalid };
+        ParameterEvent::Target                              target{ ParameterEvent::PET_Gain };
+
+        bool isValid() const noexcept { return strip >= 0; };
+    };
+
+    //==============================================================================
+    explicit MidiRemoteControl(AudioDeviceManager& deviceManager);
+    ~MidiRemoteControl() override;
+
+    /** Message thread. Enables all MIDI inputs currently available and listens to them. */
+    void setEnabled(bool enabled);
+    bool isEnabled() const noexcept { return m_enabled; };
+
+    //==============================================================================
+    /** Any thread. The next controller received is mapped to the strip parameter, replacing any other controller mapped to it. */
+    void startLearning(const Mapping& mapping) noexcept;
+    void stopLearning() noexcept;
+    bool isLearning() const noexcept { return m_learnMapping.load() >= 0; };
+
+    /** Any thread. midiChannel counts from 1, as MidiMessage does. */
+    void setMapping(int midiChannel, int controllerNumber, const Mapping& mapping) noexcept;
+    Mapping getMapping(int midiChannel, int controllerNumber) const noexcept;
+    /** Any thread. Removes the mappings of all parameters of the strip's processor of the type. */
+    void removeMappings(int strip, ChannelStripProcessorBase::ChannelStripProcessorType type) noexcept;
+
+    /** MIDI thread, or any single thread while no input is enabled. Handles the message as one received from an input. */
+    void handleMessage(const MidiMessage& message) noexcept;
+
+    //==============================================================================
+    void prepare(double sampleRate);
+    /** Audio thread, once per block before the strips are processed. Posts the controller changes received
+        since the last block as parameter events of the processors, at their offset within the block. */
+    void applyControllers(const std::vector<ChannelStripEngine::ChannelProcessors>& stripProcessors, int numSamples) noexcept;
+
+    /** Any thread. Controller changes lost while the fifo or a processor's event queue was full. */
+    uint32 getNumDropped() const noexcept { return m_numDropped.load(std::memory_order_relaxed); };
+
+    /** Called on the message thread with the latest value (0..1) of mapped controllers, after the audio thread got it. */
+    std::function<void(const Mapping& mapping, float normalisedValue)>  onControllerChanged;
+
+private:
+    struct ControllerChange
+    {
+        double  timeStamp{ 0.0 };   // seconds, on the Time::getMillisecondCounterHiRes() scale
+        int     controller{ 0 };    // index into the mapping table
+        int     value{ 0 };
+    };
+
+    //==============================================================================
+    void handleIncomingMidiMessage(MidiInput* source, const MidiMessage& message) override;
+    void timerCallback() override;
+
+    static int32 pack(const Mapping& mapping) noexcept;
+    static Mapping unpack(int32 packedMapping) noexcept;
+    static int getControllerIndex(int midiChannel, int controllerNumber) noexcept;
+
+    //==============================================================================
+    AudioDeviceManager&     m_deviceManager;
+    bool                    m_enabled{ false };
+
+    std::array<std::atomic<int32>, numControllers>  m_mappings;     // packed mappings, -1 where unmapped
+    std::atomic<int32>                              m_learnMapping{ -1 };
+    std::array<std::atomic<int32>, numControllers>  m_editorValues; // latest value per controller, -1 once synced
+
+    // MIDI thread -> audio thread, the device manager serialises all input callbacks
+    AbstractFifo                                    m_fifo{ fifoCapacity };
+    std::array<ControllerChange, fifoCapacity>      m_changes;
+    double                                          m_sampleRate{ 48000.0 };
+    std::atomic<uint32>                             m_numDropped{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiRemoteControl)
+};
@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+    OSCRemoteControl.cpp
+    Created: 18 Oct 2026 4:48:02am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "OSCRemoteControl.h"
+
+#include "../AudioPlayer/AudioPlayerComponent.h"
+
+OSCRemoteControl::OSCRemoteControl()
+{
+    m_routingChanges.reserve(static_cast<size_t>(routingParameters));
+    m_receiver.addListener(this);
+}
+
+OSCRemoteControl::~OSCRemoteControl()
+{
+    stopTimer();
+    m_receiver.removeListener(this);
+    m_receiver.disconnect();
+}
+
+bool OSCRemoteControl::setPort(int port)
+{
+    m_receiver.disconnect();
+    m_port = 0;
+    stopTimer();
+
+    if (port <= 0)
+        return true;
+
+    if (!m_receiver.connect(port))
+        return false;
+
+    m_port = port;
+    startTimerHz(20);
+    return true;
+}
+
+//==============================================================================
+void OSCRemoteControl::applyParameters(const std::vector<ChannelStripEngine::ChannelProcessors>& stripProcessors, AudioPlayerComponent& player) noexcept
+{
+    m_audioParameters.drain([&stripProcessors, &player](int parameter, float value) {
+        if (parameter == playerGainParameter)
+        {
+            player.setGain(value);
+            return;
+        }
+
+        auto channel = parameter / SP_NumParameters;
+        if (channel >= static_cast<int>(stripProcessors.size()))
+            return;
+
+        // processors taken out of the strip's topology are not in the configuration, their value is only synced to the editor
+        auto const& processors = stripProcessors[static_cast<size_t>(channel)];
+        switch (parameter % SP_NumParameters)
+        {
+        case SP_HighPassFrequency:
+            if (processors.highPass)
+                processors.highPass->setParameterTarget(ParameterEvent::PET_Frequency, value);
+            break;
+        case SP_HighPassGain:
+            if (processors.highPass)
+                processors.highPass->setParameterTarget(ParameterEvent::PET_Gain, value);
+            break;
+        case SP_LowPassFrequency:
+            if (processors.lowPass)
+                processors.lowPass->setParameterTarget(ParameterEvent::PET_Frequency, value);
+            break;
+        case SP_LowPassGain:
+            if (processors.lowPass)
+                processors.lowPass->setParameterTarget(ParameterEvent::PET_Gain, value);
+            break;
+        case SP_Gain:
+            if (processors.gain)
+                processors.gain->setParameterTarget(ParameterEvent::PET_Gain, value);
+            break;
+        default:
+            break;
+        }
+    });
+}
+
+//==============================================================================
+void OSCRemoteControl::oscMessageReceived(const OSCMessage& message)
+{
+    m_numReceived.fetch_add(1, std::memory_order_relaxed);
+
+    if (!handleMessage(message))
+        m_numRejected.fetch_add(1, std::memory_order_relaxed);
+}
+
+void OSCRemoteControl::oscBundleReceived(const OSCBundle& bundle)
+{
+    // bundle time tags are not honoured, everything takes effect with the next block
+    for (auto const& element : bundle)
+    {
+        if (element.isMessage())
+            oscMessageReceived(element.getMessage());
+        else if (element.isBundle())
+            oscBundleReceived(element.getBundle());
+    }
+}
+
+bool OSCRemoteControl::handleMessage(const OSCMessage& message)
+{
+    auto address = StringArray::fromTokens(message.getAddressPattern().toString(), "/", "");
+    address.removeEmptyStrings();
+    if (address.size() < 2 || address[0] != "placross")
+        return false;
+
+    float value = 0.0f;
+
+    if (address[1] == "strip" && address.size() >= 4)
+    {
+        auto channel = address[2].getIntValue() - 1;
+        if (!isPositiveAndBelow(channel, maxChannels) || !getValue(message, value))
+            return false;
+
+        auto parameter = SP_NumParameters;
+        if (address.size() == 4 && address[3] == "gain")
+            parameter = SP_Gain;
+        else if (address.size() == 5 && address[3] == "highpass")
+            parameter = address[4] == "frequency" ? SP_HighPassFrequency : address[4] == "gain" ? SP_HighPassGain : SP_NumParameters;
+        else if (address.size() == 5 && address[3] == "lowpass")
+            parameter = address[4] == "frequency" ? SP_LowPassFrequency : address[4] == "gain" ? SP_LowPassGain : SP_NumParameters;
+        if (parameter == SP_NumParameters)
+            return false;
+
+        value = clipStripValue(parameter, value);
+        m_audioParameters.push(channel * SP_NumParameters + parameter, value);
+        m_editorParameters.push(channel * SP_NumParameters + parameter, value);
+        return true;
+    }
+    else if (address[1] == "routing" && address.size() == 4)
+    {
+        auto input = address[2].getIntValue() - 1;
+        auto output = address[3].getIntValue() - 1;
+        if (!isPositiveAndBelow(input, maxChannels) || !isPositiveAndBelow(output, maxChannels) || !getValue(message, value))
+            return false;
+
+        m_messageThreadParameters.push(input * maxChannels + output, value != 0.0f ? 1.0f : 0.0f);
+        return true;
+    }
+    else if (address[1] == "player" && address.size() == 3)
+    {
+        if (address[2] == "gain")
+        {
+            if (!getValue(message, value))
+                return false;
+
+            m_audioParameters.push(playerGainParameter, jlimit(0.0f, 1.0f, value));
+            return true;
+        }
+
+        auto command = address[2] == "play" ? TC_Play : address[2] == "stop" ? TC_Stop : address[2] == "next" ? TC_Next : address[2] == "previous" ? TC_Previous : TC_NumCommands;
+        if (command == TC_NumCommands)
+            return false;
+
+        int start1, size1, start2, size2;
+        m_transportFifo.prepareToWrite(1, start1, size1, start2, size2);
+        if (size1 + size2 < 1)
+            return false;
+
+        m_transportCommands[static_cast<size_t>(size1 > 0 ? start1 : start2)] = command;
+        m_transportFifo.finishedWrite(1);
+        return true;
+    }
+
+    return false;
+}
+
+bool OSCRemoteControl::getValue(const OSCMessage& message, float& value)
+{
+    if (message.isEmpty())
+        return false;
+
+    auto const& argument = message[0];
+    if (argument.isFloat32())
+        value = argument.getFloat32();
+    else if (argument.isInt32())
+        value = static_cast<float>(argument.getInt32());
+    else
+        return false;
+
+    return std::isfinite(value);
+}
+
+float OSCRemoteControl::clipStripValue(StripParameter parameter, float value)
+{
+    // the ranges of the processors' parameters (hpff / lpff, hpfg / lpfg / gain)
+    if (parameter == SP_HighPassFrequency || parameter == SP_LowPassFrequency)
+        return jlimit(20.0f, 20000.0f, value);
+
+    return jlimit(0.0f, 1.0f, value);
+}
+
+//==============================================================================
+void OSCRemoteControl::timerCallback()
+{
+    m_routingChanges.clear();
+    m_messageThreadParameters.drain([this](int parameter, float value) {
+        m_routingChanges.push_back({ parameter / maxChannels, parameter % maxChannels, value != 0.0f });
+    });
+    if (!m_routingChanges.empty() && onRoutingChanged)
+        onRoutingChanged(m_routingChanges);
+
+    // every command is run, play, stop, play ends up playing
+    int start1, size1, start2, size2;
+    m_transportFifo.prepareToRead(m_transportFifo.getNumReady(), start1, size1, start2, size2);
+    for (auto i = 0; i < size1 + size2; ++i)
+    {
+        auto command = m_transportCommands[static_cast<size_t>(i < size1 ? start1 + i : start2 + i - size1)];
+        if (onTransportCommand)
+            onTransportCommand(command);
+    }
+    m_transportFifo.finishedRead(size1 + size2);
+
+    m_editorParameters.drain([this](int parameter, float value) {
+        if (onStripParameterChanged)
+            onStripParameterChanged(parameter / SP_NumParameters, static_cast<StripParameter>(parameter % SP_NumParameters), value);
+    });
+}
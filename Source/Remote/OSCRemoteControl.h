@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    OSCRemoteControl.h
+    Created: 18 Oct 2026 4:48:02am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "../ChannelStrip/ChannelStripEngine.h"
+#include "../Engine/CoalescingParameterQueue.h"
+#include "../Engine/EngineConfiguration.h"
+
+class AudioPlayerComponent;
+
+//==============================================================================
+/*
+    OSC receiver for driving a rig from control software. Channels count from 1,
+    values are plain (Hz, linear gain):
+
+        /placross/strip/<channel>/highpass/frequency    f
+        /placross/strip/<channel>/highpass/gain         f
+        /placross/strip/<channel>/lowpass/frequency     f
+        /placross/strip/<channel>/lowpass/gain          f
+        /placross/strip/<channel>/gain                  f
+        /placross/routing/<input>/<output>              i or f, non-zero connects
+        /placross/player/gain                           f
+        /placross/player/play | stop | next | previous
+
+    Messages are parsed on the receiver thread and never go through the message
+    thread on their way to the audio thread. Strip and player values are coalesced
+    per parameter and picked up by the audio thread once per block, however many
+    messages arrived for them meanwhile. Routing and transport change structure the
+    audio thread does not own. Routing is coalesced as well and applied on the message
+    thread, as are the editors brought in line with remote strip values. Transport
+    commands are events rather than values, they are queued in the order received.
+*/
+class OSCRemoteControl  : private OSCReceiver::Listener<OSCReceiver::RealtimeCallback>,
+                          private Timer
+{
+public:
+    static constexpr int maxChannels = MAX_SUPPORTED_OUTPUTS;
+    static constexpr int transportQueueSize = 64;
+
+    enum StripParameter
+    {
+        SP_HighPassFrequency,
+        SP_HighPassGain,
+        SP_LowPassFrequency,
+        SP_LowPassGain,
+        SP_Gain,
+        SP_NumParameters
+    };
+
+    enum TransportCommand
+    {
+        TC_Play,
+        TC_Stop,
+        TC_Next,
+        TC_Previous,
+        TC_NumCommands
+    };
+
+    struct RoutingChange
+    {
+        int     input{ 0 };
+        int     output{ 0 };
+        bool    connected{ false };
+    };
+
+    //==============================================================================
+    OSCRemoteControl();
+    ~OSCRemoteControl() override;
+
+    /** Message thread. Listens on the UDP port, 0 stops listening. */
+    bool setPort(int port);
+    int getPort() const noexcept { return m_port; };
+
+    /** Audio thread, once per block. Hands the latest strip and player values received since the last block to the processors and the player. */
+    void applyParameters(const std::vector<ChannelStripEngine::ChannelProcessors>& stripProcessors, AudioPlayerComponent& player) noexcept;
+
+    /** Message thread. Called with the editor parameters of remote controlled strip values, at a lower rate than they are processed. */
+    std::function<void(int channel, StripParameter parameter, float value)>     onStripParameterChanged;
+    std::function<void(const std::vector<RoutingChange>& changes)>              onRoutingChanged;
+    std::function<void(TransportCommand command)>                               onTransportCommand;
+
+    //==============================================================================
+    /** Any thread. Messages received, updates that only overwrote a value still queued, and messages not understood or not queued. */
+    uint32 getNumReceived() const noexcept { return m_numReceived.load(std::memory_order_relaxed); };
+    uint32 getNumCoalesced() const noexcept { return m_audioParameters.getNumCoalesced() + m_messageThreadParameters.getNumCoalesced(); };
+    uint32 getNumRejected() const noexcept { return m_numRejected.load(std::memory_order_relaxed); };
+
+private:
+    //==============================================================================
+    void oscMessageReceived(const OSCMessage& message) override;
+    void oscBundleReceived(const OSCBundle& bundle) override;
+
+    void timerCallback() override;
+
+    bool handleMessage(const OSCMessage& message);
+    static bool getValue(const OSCMessage& message, float& value);
+    static float clipStripValue(StripParameter parameter, float value);
+
+    //==============================================================================
+    // audio thread queue: strip values, then the player gain
+    static constexpr int playerGainParameter = maxChannels * SP_NumParameters;
+    // message thread queue: routing crosspoints
+    static constexpr int routingParameters = maxChannels * maxChannels;
+
+    OSCReceiver                 m_receiver{ "OSCRemoteControl" };
+    int                         m_port{ 0 };
+
+    CoalescingParameterQueue    m_audioParameters{ playerGainParameter + 1 };
+    CoalescingParameterQueue    m_editorParameters{ playerGainParameter };
+    CoalescingParameterQueue    m_messageThreadParameters{ routingParameters };
+    std::vector<RoutingChange>  m_routingChanges;
+
+    // receiver thread -> message thread, in order
+    AbstractFifo                                        m_transportFifo{ transportQueueSize };
+    std::array<TransportCommand, transportQueueSize>    m_transportCommands;
+
+    std::atomic<uint32>         m_numReceived{ 0 };
+    std::atomic<uint32>         m_numRejected{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OSCRemoteControl)
+};
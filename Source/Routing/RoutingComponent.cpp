@@ -237,54 +237,108 @@ void RoutingComponent::setRouting(std::multimap<int, int> const& routingMap)
         jassertfalse;
 }
 
-void RoutingComponent::audioDeviceIOCallback(const float** inputChannelData, int numInputChannels, float** outputChannelData, int numOutputChannels, int numSamples)
+uint32 RoutingComponent::setRoutingMap(const std::multimap<int, int>& routingMap)
 {
-    const ScopedLock sl(m_routingLock);
+    // crosspoints outside of the current matrix are dropped
+    auto clippedMap = std::multimap<int, int>{};
+    for (auto const& crosspoint : routingMap)
+        if (crosspoint.first >= 0 && crosspoint.first < m_inputChannelCount && crosspoint.second >= 0 && crosspoint.second < m_outputChannelCount)
+            clippedMap.insert(crosspoint);
 
-    m_routingOutputBuffer.setSize(numOutputChannels, numSamples, false, true, true);
-    m_routingOutputBuffer.clear();
+    setRouting(clippedMap);
 
-    for (int in = 0; in < numInputChannels; ++in)
-    {
-        if(m_routingMap.count(in) == 0)
-            continue;
+    return m_routingVersion;
+}
 
-        auto range = m_routingMap.equal_range(in);
-        for (auto rit = range.first; rit != range.second; rit++)
-        {
-            for (int out = 0; out < numOutputChannels; ++out)
-            {
-                if (rit->second == out)
-                {
-                    m_routingOutputBuffer.addFrom(out, 0, inputChannelData[in], numSamples);
-                }
-            }
-        }
-    }
+size_t RoutingComponent::getRoutingScratchSize(int maxOutputChannels, int maxBlockSize) noexcept
+{
+    return ScratchArena::getChannelsSize(jmax(1, maxOutputChannels), jmax(1, maxBlockSize));
+}
+
+void RoutingComponent::prepareRouting(int maxInputChannels, int maxOutputChannels, int maxBlockSize)
+{
+    jassert(m_blockRouting == nullptr);
+
+    m_maxOutputChannelCount = jmax(1, maxOutputChannels);
+    m_maxBlockSize = jmax(1, maxBlockSize);
 
-    for (int out = 0; out < numOutputChannels; ++out)
-        memcpy(outputChannelData[out], m_routingOutputBuffer.getReadPointer(out), numSamples * sizeof(float));
+    m_routingMixer.prepare(maxInputChannels, maxOutputChannels, maxBlockSize);
+    m_routedChannels.calloc(static_cast<size_t>(m_maxOutputChannelCount));
+    m_silentChannel.calloc(static_cast<size_t>(m_maxBlockSize));
 }
 
-void RoutingComponent::audioDeviceAboutToStart(AudioIODevice* device)
+void RoutingComponent::beginRoutingBlock(ScratchArena& scratch, int numInputChannels, int numOutputChannels, int numSamples, const RoutingMatrix* routingOverride) noexcept
 {
-    ignoreUnused(device);
+    jassert(numOutputChannels <= m_maxOutputChannelCount);
+    jassert(numSamples <= m_maxBlockSize);
+
+    m_blockOutputChannelCount = jmin(numOutputChannels, m_maxOutputChannelCount);
+
+    // the mix buffer is checked out of the stage's scratch until endRoutingBlock
+    m_blockScratch = &scratch;
+    m_blockScratchMark = scratch.getMark();
+    m_blockMixChannels = scratch.allocateChannels(m_blockOutputChannelCount, jmin(numSamples, m_maxBlockSize));
+
+    // the snapshot is held until endRoutingBlock, so a block may be split into several ranges
+    m_blockRouting = m_routingPublisher.beginRead();
+    if (routingOverride != nullptr)
+        m_blockRouting = routingOverride;
+    if (m_blockRouting && m_blockMixChannels)
+        m_routingMixer.beginBlock(*m_blockRouting, numInputChannels, m_blockOutputChannelCount, numSamples);
 }
 
-void RoutingComponent::audioDeviceStopped()
+const float* const* RoutingComponent::processRoutingRange(const float* const* inputChannelData, int startSample, int numSamples) noexcept
 {
+    // without scratch to mix into, all outputs are silent
+    if (!m_blockMixChannels)
+    {
+        for (int out = 0; out < m_blockOutputChannelCount; ++out)
+            m_routedChannels[out] = m_silentChannel.get();
+
+        return m_routedChannels.get();
+    }
+
+    if (m_blockRouting)
+        m_routingMixer.processRange(inputChannelData, m_blockMixChannels, startSample, numSamples);
+    else
+        for (int out = 0; out < m_blockOutputChannelCount; ++out)
+            FloatVectorOperations::clear(m_blockMixChannels[out] + startSample, numSamples);
+
+    // identity and permutation crosspoints are handed out as pointers into the input instead of copying them
+    for (int out = 0; out < m_blockOutputChannelCount; ++out)
+    {
+        auto in = m_blockRouting ? m_routingMixer.getPassthroughInput(out) : -1;
+        m_routedChannels[out] = in >= 0 ? inputChannelData[in] : m_blockMixChannels[out];
+    }
+
+    return m_routedChannels.get();
 }
 
-void RoutingComponent::audioDeviceError(const juce::String &errorMessage)
+void RoutingComponent::endRoutingBlock() noexcept
 {
-    ignoreUnused(errorMessage);
+    if (m_blockRouting && m_blockMixChannels)
+        m_routingMixer.endBlock();
+
+    m_blockRouting = nullptr;
+    m_routingPublisher.endRead();
+
+    if (m_blockScratch)
+        m_blockScratch->release(m_blockScratchMark);
+    m_blockScratch = nullptr;
+    m_blockMixChannels = nullptr;
 }
 
 void RoutingComponent::onRoutingEditingFinished(std::multimap<int, int> const& newRouting)
 {
-    const ScopedLock sl(m_routingLock);
-
     m_routingMap = newRouting;
+
+    // the audio thread only ever sees immutable snapshots of the routing
+    auto matrix = std::make_unique<RoutingMatrix>(m_inputChannelCount, m_outputChannelCount, ++m_routingVersion);
+    for (auto const& crosspoint : newRouting)
+        matrix->setGain(crosspoint.first, crosspoint.second, 1.0f);
+    matrix->updateActiveCrosspoints();
+
+    m_routingPublisher.publish(std::move(matrix));
 }
 
 void RoutingComponent::changeOverlayState()
@@ -12,11 +12,15 @@
 
 #include <JuceHeader.h>
 
+#include "RoutingMatrixMixer.h"
+
+#include "../Engine/RealtimeSnapshotPublisher.h"
+#include "../Engine/ScratchArena.h"
+
 #include "../submodules/JUCE-AppBasics/Source/OverlayToggleComponentBase.h"
 
 //==============================================================================
 class RoutingComponent  :   public JUCEAppBasics::OverlayToggleComponentBase,
-                            public AudioIODeviceCallback,
                             public DrawableButton::Listener
 {
 public:
@@ -25,22 +29,30 @@ public:
     ~RoutingComponent() override;
 
     void setIOCount(int inputChannelCount, int outputChannelCount);
+    int getInputChannelCount() const { return m_inputChannelCount; };
+    int getOutputChannelCount() const { return m_outputChannelCount; };
+
+    /** Message thread. Crosspoints as pairs of input and output. Setting them returns the version
+        of the routing published for them, see getBlockRoutingVersion(). */
+    const std::multimap<int, int>& getRoutingMap() const { return m_routingMap; };
+    uint32 setRoutingMap(const std::multimap<int, int>& routingMap);
+    uint32 getNextRoutingVersion() const { return m_routingVersion + 1; };
 
     //==============================================================================
-    void resized() override;
+    static size_t getRoutingScratchSize(int maxOutputChannels, int maxBlockSize) noexcept;
+    void prepareRouting(int maxInputChannels, int maxOutputChannels, int maxBlockSize);
+    /** The block is mixed with the routing published last, unless a matrix is given to use instead for this block. */
+    void beginRoutingBlock(ScratchArena& scratch, int numInputChannels, int numOutputChannels, int numSamples, const RoutingMatrix* routingOverride = nullptr) noexcept;
+    const float* const* processRoutingRange(const float* const* inputChannelData, int startSample, int numSamples) noexcept;
+    void endRoutingBlock() noexcept;
+    /** Version of the routing the current block is mixed with, 0 if there is none. Valid between begin- and endRoutingBlock. */
+    uint32 getBlockRoutingVersion() const noexcept { return m_blockRouting ? m_blockRouting->getVersion() : 0; };
 
     //==============================================================================
-    void buttonClicked(Button* button) override;
+    void resized() override;
 
     //==============================================================================
-    void audioDeviceIOCallback(const float** inputChannelData,
-        int numInputChannels,
-        float** outputChannelData,
-        int numOutputChannels,
-        int numSamples) override;
-    void audioDeviceAboutToStart(AudioIODevice* device) override;
-    void audioDeviceStopped() override;
-    void audioDeviceError(const juce::String &errorMessage) override;
+    void buttonClicked(Button* button) override;
 
 
 protected:
@@ -69,8 +81,20 @@ private:
     int                     m_inputChannelCount{ 0 };
     int                     m_outputChannelCount{ 0 };
     std::multimap<int, int> m_routingMap{};
-    CriticalSection         m_routingLock{};
-    AudioSampleBuffer       m_routingOutputBuffer{};
+
+    uint32                  m_routingVersion{ 0 };
+
+    RealtimeSnapshotPublisher<RoutingMatrix>    m_routingPublisher;
+    RoutingMatrixMixer                          m_routingMixer;
+    const RoutingMatrix*                        m_blockRouting{ nullptr };
+    int                                         m_blockOutputChannelCount{ 0 };
+    HeapBlock<const float*>                     m_routedChannels;
+    int                                         m_maxOutputChannelCount{ 0 };
+    int                                         m_maxBlockSize{ 0 };
+    HeapBlock<float>                            m_silentChannel;
+    ScratchArena*                               m_blockScratch{ nullptr };
+    size_t                                      m_blockScratchMark{ 0 };
+    float**                                     m_blockMixChannels{ nullptr };
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RoutingComponent)
@@ -0,0 +1,397 @@
+/*
+  ==============================================================================
+
+    RoutingMatrixMixer.cpp
+    Created: 17 Oct 2026 11:03:27am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#include "RoutingMatrixMixer.h"
+
+//==============================================================================
+RoutingMatrix::RoutingMatrix(int numInputs, int numOutputs, uint32 version)
+    : m_numInputs(jmax(0, numInputs)), m_numOutputs(jmax(0, numOutputs)), m_version(version)
+{
+    m_gains.resize(static_cast<size_t>(m_numInputs * m_numOutputs), 0.0f);
+    m_activeOffsets.resize(static_cast<size_t>(m_numOutputs + 1), 0);
+}
+
+void RoutingMatrix::setGain(int input, int output, float gain)
+{
+    if (isPositiveAndBelow(input, m_numInputs) && isPositiveAndBelow(output, m_numOutputs))
+        m_gains[static_cast<size_t>(output * m_numInputs + input)] = gain;
+    else
+        jassertfalse;
+}
+
+float RoutingMatrix::getGain(int input, int output) const noexcept
+{
+    if (isPositiveAndBelow(input, m_numInputs) && isPositiveAndBelow(output, m_numOutputs))
+        return m_gains[static_cast<size_t>(output * m_numInputs + input)];
+
+    return 0.0f;
+}
+
+void RoutingMatrix::updateActiveCrosspoints()
+{
+    m_activeInputs.clear();
+    m_activeGains.clear();
+
+    for (int out = 0; out < m_numOutputs; ++out)
+    {
+        m_activeOffsets[out] = static_cast<int>(m_activeInputs.size());
+
+        auto row = getGainsForOutput(out);
+        for (int in = 0; in < m_numInputs; ++in)
+        {
+            if (row[in] != 0.0f)
+            {
+                m_activeInputs.push_back(in);
+                m_activeGains.push_back(row[in]);
+            }
+        }
+    }
+    m_activeOffsets[m_numOutputs] = static_cast<int>(m_activeInputs.size());
+
+    auto crosspointCount = m_numInputs * m_numOutputs;
+    m_density = crosspointCount > 0 ? static_cast<float>(m_activeInputs.size()) / static_cast<float>(crosspointCount) : 0.0f;
+}
+
+void RoutingMatrix::reserveActiveCrosspoints()
+{
+    m_activeInputs.reserve(static_cast<size_t>(m_numInputs * m_numOutputs));
+    m_activeGains.reserve(static_cast<size_t>(m_numInputs * m_numOutputs));
+}
+
+void RoutingMatrix::clearActiveCrosspoints() noexcept
+{
+    std::fill(m_gains.begin(), m_gains.end(), 0.0f);
+    m_activeInputs.clear();
+    m_activeGains.clear();
+    m_activeOffsets[0] = 0;
+    m_lastActiveOutput = 0;
+}
+
+void RoutingMatrix::addActiveCrosspoint(int input, int output) noexcept
+{
+    if (!isPositiveAndBelow(input, m_numInputs) || !isPositiveAndBelow(output, m_numOutputs) || output < m_lastActiveOutput
+        || m_activeInputs.size() >= m_activeInputs.capacity())
+    {
+        jassertfalse;
+        return;
+    }
+
+    while (m_lastActiveOutput < output)
+        m_activeOffsets[++m_lastActiveOutput] = static_cast<int>(m_activeInputs.size());
+
+    m_activeInputs.push_back(input);
+    m_activeGains.push_back(0.0f);
+}
+
+void RoutingMatrix::finishActiveCrosspoints() noexcept
+{
+    while (m_lastActiveOutput < m_numOutputs)
+        m_activeOffsets[++m_lastActiveOutput] = static_cast<int>(m_activeInputs.size());
+
+    auto crosspointCount = m_numInputs * m_numOutputs;
+    m_density = crosspointCount > 0 ? static_cast<float>(m_activeInputs.size()) / static_cast<float>(crosspointCount) : 0.0f;
+}
+
+void RoutingMatrix::setActiveGain(int index, int output, float gain) noexcept
+{
+    jassert(isPositiveAndBelow(index, static_cast<int>(m_activeInputs.size())) && isPositiveAndBelow(output, m_numOutputs));
+
+    m_activeGains[static_cast<size_t>(index)] = gain;
+    m_gains[static_cast<size_t>(output * m_numInputs + m_activeInputs[static_cast<size_t>(index)])] = gain;
+}
+
+void RoutingMatrix::setVersion(uint32 version, bool activeCrosspointsUnchanged) noexcept
+{
+    m_previousVersion = m_version;
+    m_version = version;
+    m_activeCrosspointsUnchanged = activeCrosspointsUnchanged;
+}
+
+
+//==============================================================================
+RoutingMatrixMixer::RoutingMatrixMixer()
+{
+}
+
+RoutingMatrixMixer::~RoutingMatrixMixer()
+{
+}
+
+void RoutingMatrixMixer::prepare(int maxInputs, int maxOutputs, int maxBlockSize)
+{
+    m_maxInputs = jmax(0, maxInputs);
+    m_maxOutputs = jmax(0, maxOutputs);
+    m_maxBlockSize = jmax(1, maxBlockSize);
+
+    m_currentGains.calloc(static_cast<size_t>(jmax(1, m_maxInputs * m_maxOutputs)));
+    m_ramp.calloc(static_cast<size_t>(m_maxBlockSize));
+    m_rampedInput.calloc(static_cast<size_t>(m_maxBlockSize));
+    m_passthroughInputs.calloc(static_cast<size_t>(jmax(1, m_maxOutputs)));
+    m_rampLength = 0;
+
+    // the first matrix after (re)preparing is faded in from silence
+    m_hasCurrentGains = false;
+    m_blockMatrix = nullptr;
+}
+
+void RoutingMatrixMixer::beginBlock(const RoutingMatrix& matrix, int numInputs, int numOutputs, int numSamples) noexcept
+{
+    jassert(numSamples <= m_maxBlockSize);
+    jassert(numOutputs <= m_maxOutputs);
+
+    m_blockMatrix = &matrix;
+    m_blockMixedInputs = jmin(numInputs, matrix.getNumInputs(), m_maxInputs);
+    m_blockOutputs = jmin(numOutputs, m_maxOutputs);
+    m_blockMixedOutputs = jmin(m_blockOutputs, matrix.getNumOutputs());
+    m_blockSamples = jmin(numSamples, m_maxBlockSize);
+    m_blockIsRamped = !m_hasCurrentGains || matrix.getVersion() != m_currentVersion;
+    // everything outside the active crosspoints is silent in both the gains reached so far and the new ones
+    m_blockRampsActiveOnly = m_blockIsRamped && m_hasCurrentGains && matrix.areActiveCrosspointsUnchanged()
+        && matrix.getPreviousVersion() == m_currentVersion && matrix.getNumInputs() <= m_maxInputs && matrix.getNumOutputs() <= m_maxOutputs;
+
+    if (m_blockIsRamped && m_rampLength != m_blockSamples)
+    {
+        for (int i = 0; i < m_blockSamples; ++i)
+            m_ramp[i] = static_cast<float>(i + 1) / static_cast<float>(m_blockSamples);
+        m_rampLength = m_blockSamples;
+    }
+
+    // outputs fed by a single input at unity gain do not need to be touched at all (identity or permutation)
+    for (int out = 0; out < m_blockOutputs; ++out)
+    {
+        m_passthroughInputs[out] = -1;
+
+        if (!m_blockIsRamped && out < m_blockMixedOutputs && matrix.getNumActiveInputs(out) == 1)
+        {
+            auto in = matrix.getActiveInputs(out)[0];
+            if (in < m_blockMixedInputs && matrix.getActiveGains(out)[0] == 1.0f)
+                m_passthroughInputs[out] = in;
+        }
+    }
+}
+
+int RoutingMatrixMixer::getPassthroughInput(int output) const noexcept
+{
+    if (m_blockMatrix != nullptr && isPositiveAndBelow(output, m_blockOutputs))
+        return m_passthroughInputs[output];
+
+    return -1;
+}
+
+void RoutingMatrixMixer::processRange(const float* const* inputs, float* const* outputs, int startSample, int numSamples) noexcept
+{
+    if (m_blockMatrix == nullptr)
+    {
+        jassertfalse;
+        return;
+    }
+
+    jassert(startSample + numSamples <= m_blockSamples);
+    numSamples = jmin(numSamples, m_blockSamples - startSample);
+    if (numSamples <= 0)
+        return;
+
+    if (m_blockRampsActiveOnly)
+        processRampedSparse(inputs, outputs, startSample, numSamples);
+    else if (m_blockIsRamped)
+        processRamped(inputs, outputs, startSample, numSamples);
+    else if (m_blockMatrix->getDensity() >= denseMatrixThreshold)
+        processDense(inputs, outputs, startSample, numSamples);
+    else
+        processSparse(inputs, outputs, startSample, numSamples);
+
+    // outputs the matrix does not cover stay silent
+    for (int out = m_blockMixedOutputs; out < m_blockOutputs; ++out)
+        FloatVectorOperations::clear(outputs[out] + startSample, numSamples);
+}
+
+void RoutingMatrixMixer::endBlock() noexcept
+{
+    if (m_blockMatrix == nullptr)
+        return;
+
+    if (m_blockRampsActiveOnly)
+    {
+        // only the active crosspoints can have moved
+        for (int out = 0; out < m_blockMatrix->getNumOutputs(); ++out)
+        {
+            auto currentGains = m_currentGains.get() + (out * m_maxInputs);
+            auto activeInputs = m_blockMatrix->getActiveInputs(out);
+            auto activeGains = m_blockMatrix->getActiveGains(out);
+            for (int i = 0; i < m_blockMatrix->getNumActiveInputs(out); ++i)
+                currentGains[activeInputs[i]] = activeGains[i];
+        }
+
+        m_currentVersion = m_blockMatrix->getVersion();
+    }
+    else if (m_blockIsRamped)
+    {
+        // remember the gains reached at the end of this block for the whole matrix, not only the channels mixed here
+        auto numMatrixInputs = jmin(m_blockMatrix->getNumInputs(), m_maxInputs);
+        auto numMatrixOutputs = jmin(m_blockMatrix->getNumOutputs(), m_maxOutputs);
+        FloatVectorOperations::clear(m_currentGains.get(), m_maxInputs * m_maxOutputs);
+        for (int out = 0; out < numMatrixOutputs; ++out)
+            FloatVectorOperations::copy(m_currentGains.get() + (out * m_maxInputs), m_blockMatrix->getGainsForOutput(out), numMatrixInputs);
+
+        m_currentVersion = m_blockMatrix->getVersion();
+        m_hasCurrentGains = true;
+    }
+
+    m_blockMatrix = nullptr;
+}
+
+void RoutingMatrixMixer::process(const RoutingMatrix& matrix, const float* const* inputs, int numInputs, float* const* outputs, int numOutputs, int numSamples) noexcept
+{
+    beginBlock(matrix, numInputs, numOutputs, numSamples);
+    processRange(inputs, outputs, 0, numSamples);
+
+    for (int out = 0; out < m_blockOutputs; ++out)
+    {
+        auto in = m_passthroughInputs[out];
+        if (in >= 0 && outputs[out] != inputs[in])
+            FloatVectorOperations::copy(outputs[out], inputs[in], m_blockSamples);
+    }
+
+    endBlock();
+}
+
+void RoutingMatrixMixer::processSparse(const float* const* inputs, float* const* outputs, int startSample, int numSamples) noexcept
+{
+    for (int out = 0; out < m_blockMixedOutputs; ++out)
+    {
+        if (m_passthroughInputs[out] >= 0)
+            continue;
+
+        auto dest = outputs[out] + startSample;
+        auto activeInputs = m_blockMatrix->getActiveInputs(out);
+        auto activeGains = m_blockMatrix->getActiveGains(out);
+        auto written = false;
+
+        for (int i = 0; i < m_blockMatrix->getNumActiveInputs(out); ++i)
+        {
+            auto in = activeInputs[i];
+            if (in >= m_blockMixedInputs)
+                continue;
+
+            if (written)
+                FloatVectorOperations::addWithMultiply(dest, inputs[in] + startSample, activeGains[i], numSamples);
+            else
+                FloatVectorOperations::copyWithMultiply(dest, inputs[in] + startSample, activeGains[i], numSamples);
+
+            written = true;
+        }
+
+        if (!written)
+            FloatVectorOperations::clear(dest, numSamples);
+    }
+}
+
+void RoutingMatrixMixer::processDense(const float* const* inputs, float* const* outputs, int startSample, int numSamples) noexcept
+{
+    for (int out = 0; out < m_blockMixedOutputs; ++out)
+    {
+        if (m_passthroughInputs[out] >= 0)
+            continue;
+
+        auto dest = outputs[out] + startSample;
+        auto gains = m_blockMatrix->getGainsForOutput(out);
+        auto written = false;
+
+        for (int in = 0; in < m_blockMixedInputs; ++in)
+        {
+            if (gains[in] == 0.0f)
+                continue;
+
+            if (written)
+                FloatVectorOperations::addWithMultiply(dest, inputs[in] + startSample, gains[in], numSamples);
+            else
+                FloatVectorOperations::copyWithMultiply(dest, inputs[in] + startSample, gains[in], numSamples);
+
+            written = true;
+        }
+
+        if (!written)
+            FloatVectorOperations::clear(dest, numSamples);
+    }
+}
+
+void RoutingMatrixMixer::processRamped(const float* const* inputs, float* const* outputs, int startSample, int numSamples) noexcept
+{
+    auto ramp = m_ramp.get() + startSample;
+
+    for (int out = 0; out < m_blockMixedOutputs; ++out)
+    {
+        auto dest = outputs[out] + startSample;
+        auto targetGains = m_blockMatrix->getGainsForOutput(out);
+        auto currentGains = m_currentGains.get() + (out * m_maxInputs);
+
+        FloatVectorOperations::clear(dest, numSamples);
+
+        for (int in = 0; in < m_blockMixedInputs; ++in)
+        {
+            auto src = inputs[in] + startSample;
+            auto startGain = m_hasCurrentGains ? currentGains[in] : 0.0f;
+            auto endGain = targetGains[in];
+
+            if (startGain == endGain)
+            {
+                if (endGain != 0.0f)
+                    FloatVectorOperations::addWithMultiply(dest, src, endGain, numSamples);
+            }
+            else
+            {
+                // dest += src * (startGain + (endGain - startGain) * ramp)
+                FloatVectorOperations::multiply(m_rampedInput.get(), src, ramp, numSamples);
+                if (startGain != 0.0f)
+                    FloatVectorOperations::addWithMultiply(dest, src, startGain, numSamples);
+                FloatVectorOperations::addWithMultiply(dest, m_rampedInput.get(), endGain - startGain, numSamples);
+            }
+        }
+    }
+}
+
+void RoutingMatrixMixer::processRampedSparse(const float* const* inputs, float* const* outputs, int startSample, int numSamples) noexcept
+{
+    auto ramp = m_ramp.get() + startSample;
+
+    for (int out = 0; out < m_blockMixedOutputs; ++out)
+    {
+        auto dest = outputs[out] + startSample;
+        auto activeInputs = m_blockMatrix->getActiveInputs(out);
+        auto activeGains = m_blockMatrix->getActiveGains(out);
+        auto currentGains = m_currentGains.get() + (out * m_maxInputs);
+
+        FloatVectorOperations::clear(dest, numSamples);
+
+        for (int i = 0; i < m_blockMatrix->getNumActiveInputs(out); ++i)
+        {
+            auto in = activeInputs[i];
+            if (in >= m_blockMixedInputs)
+                continue;
+
+            auto src = inputs[in] + startSample;
+            auto startGain = currentGains[in];
+            auto endGain = activeGains[i];
+
+            if (startGain == endGain)
+            {
+                if (endGain != 0.0f)
+                    FloatVectorOperations::addWithMultiply(dest, src, endGain, numSamples);
+            }
+            else
+            {
+                FloatVectorOperations::multiply(m_rampedInput.get(), src, ramp, numSamples);
+                if (startGain != 0.0f)
+                    FloatVectorOperations::addWithMultiply(dest, src, startGain, numSamples);
+                FloatVectorOperations::addWithMultiply(dest, m_rampedInput.get(), endGain - startGain, numSamples);
+            }
+        }
+    }
+}
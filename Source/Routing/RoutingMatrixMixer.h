@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    RoutingMatrixMixer.h
+    Created: 17 Oct 2026 11:03:27am
+    Author:  Christian Ahrens
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    Immutable crosspoint gain matrix as it is handed to the audio thread.
+    Gains are stored densely per output row, additionally a sparse list of the
+    active inputs per output is built once in updateActiveCrosspoints().
+*/
+class RoutingMatrix
+{
+public:
+    RoutingMatrix(int numInputs, int numOutputs, uint32 version);
+
+    void setGain(int input, int output, float gain);
+    float getGain(int input, int output) const noexcept;
+    void updateActiveCrosspoints();
+
+    //==============================================================================
+    int getNumInputs() const noexcept { return m_numInputs; };
+    int getNumOutputs() const noexcept { return m_numOutputs; };
+    uint32 getVersion() const noexcept { return m_version; };
+    float getDensity() const noexcept { return m_density; };
+
+    const float* getGainsForOutput(int output) const noexcept { return m_gains.data() + (output * m_numInputs); };
+
+    /** For matrices rewritten in place by their owner on the audio thread (as the morph does). The owner
+        replaces the active crosspoints with clearActiveCrosspoints / addActiveCrosspoint (in output order) /
+        finishActiveCrosspoints, which never allocates after reserveActiveCrosspoints(), moves their gains with
+        setActiveGain and bumps the version with each rewrite, so the mixer ramps to them. As long as the active
+        crosspoints stay the same from one version to the next, the mixer only ramps those. */
+    void reserveActiveCrosspoints();
+    void clearActiveCrosspoints() noexcept;
+    void addActiveCrosspoint(int input, int output) noexcept;
+    void finishActiveCrosspoints() noexcept;
+    void setActiveGain(int index, int output, float gain) noexcept;
+    void setVersion(uint32 version, bool activeCrosspointsUnchanged) noexcept;
+    uint32 getPreviousVersion() const noexcept { return m_previousVersion; };
+    bool areActiveCrosspointsUnchanged() const noexcept { return m_activeCrosspointsUnchanged; };
+
+    int getNumActiveInputs(int output) const noexcept { return m_activeOffsets[output + 1] - m_activeOffsets[output]; };
+    const int* getActiveInputs(int output) const noexcept { return m_activeInputs.data() + m_activeOffsets[output]; };
+    const float* getActiveGains(int output) const noexcept { return m_activeGains.data() + m_activeOffsets[output]; };
+
+private:
+    int                 m_numInputs{ 0 };
+    int                 m_numOutputs{ 0 };
+    uint32              m_version{ 0 };
+    uint32              m_previousVersion{ 0 };
+    bool                m_activeCrosspointsUnchanged{ false };
+    int                 m_lastActiveOutput{ 0 };
+    float               m_density{ 0.0f };
+
+    std::vector<float>  m_gains;            // [output * numInputs + input]
+    std::vector<int>    m_activeOffsets;    // numOutputs + 1 offsets into the active lists
+    std::vector<int>    m_activeInputs;
+    std::vector<float>  m_activeGains;
+
+    JUCE_LEAK_DETECTOR(RoutingMatrix)
+};
+
+//==============================================================================
+/*
+    Audio thread side of the routing. Mixes inputs to outputs according to a
+    RoutingMatrix and ramps every crosspoint whose gain changed linearly over the
+    block in which the new matrix is seen first, so toggling a node does not click.
+    Matrices rewritten in place keeping their active crosspoints (the morph) only
+    have those ramped, everything else stays on the sparse path.
+
+    A block is processed as beginBlock / processRange... / endBlock, where the ranges
+    may split the block arbitrarily (e.g. startSample offsets or tiles) and still
+    give the same result as processing it in one go. Outputs that are fed by exactly
+    one input at unity gain are reported as passthrough and not written at all,
+    the caller is expected to read them directly from the input instead.
+*/
+class RoutingMatrixMixer
+{
+public:
+    RoutingMatrixMixer();
+    ~RoutingMatrixMixer();
+
+    void prepare(int maxInputs, int maxOutputs, int maxBlockSize);
+
+    //==============================================================================
+    void beginBlock(const RoutingMatrix& matrix, int numInputs, int numOutputs, int numSamples) noexcept;
+    int getPassthroughInput(int output) const noexcept;
+    void processRange(const float* const* inputs, float* const* outputs, int startSample, int numSamples) noexcept;
+    void endBlock() noexcept;
+
+    void process(const RoutingMatrix& matrix, const float* const* inputs, int numInputs, float* const* outputs, int numOutputs, int numSamples) noexcept;
+
+    static constexpr float denseMatrixThreshold = 0.5f;
+
+private:
+    void processSparse(const float* const* inputs, float* const* outputs, int startSample, int numSamples) noexcept;
+    void processDense(const float* const* inputs, float* const* outputs, int startSample, int numSamples) noexcept;
+    void processRamped(const float* const* inputs, float* const* outputs, int startSample, int numSamples) noexcept;
+    void processRampedSparse(const float* const* inputs, float* const* outputs, int startSample, int numSamples) noexcept;
+
+    //==============================================================================
+    int                 m_maxInputs{ 0 };
+    int                 m_maxOutputs{ 0 };
+    int                 m_maxBlockSize{ 0 };
+
+    HeapBlock<float>    m_currentGains;     // [output * m_maxInputs + input], gains reached at the end of the last block
+    HeapBlock<float>    m_ramp;
+    HeapBlock<float>    m_rampedInput;
+    HeapBlock<int>      m_passthroughInputs;
+    int                 m_rampLength{ 0 };
+
+    uint32              m_currentVersion{ 0 };
+    bool                m_hasCurrentGains{ false };
+
+    //==============================================================================
+    const RoutingMatrix*    m_blockMatrix{ nullptr };
+    int                     m_blockMixedInputs{ 0 };
+    int                     m_blockOutputs{ 0 };
+    int                     m_blockMixedOutputs{ 0 };
+    int                     m_blockSamples{ 0 };
+    bool                    m_blockIsRamped{ false };
+    bool                    m_blockRampsActiveOnly{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RoutingMatrixMixer)
+};